@@ -0,0 +1,73 @@
+#!/bin/bash
+#
+# Link benchmark with synthetic project exporting lot of symbols.
+#
+# Usage: bench/link_symbols.sh <build_dir> [symbol_count] [import_count]
+#
+# Generates symbol_count exported labels spread over several modules and one
+# module importing import_count of them, assembles everything with i8080
+# tools from build_dir and measures time of the link step only.
+
+set -e
+
+BUILD_DIR=$(cd "${1:?Missing build directory!}" && pwd)
+SYMBOLS=${2:-50000}
+IMPORTS=${3:-4000}
+MODULES=40
+
+ASSEMBLER="$BUILD_DIR/i8080-assembler"
+LINKER="$BUILD_DIR/i8080-linker"
+
+WORK_DIR=$(mktemp -d)
+trap 'rm -rf "$WORK_DIR"' EXIT
+
+cd "$WORK_DIR"
+
+PER_MODULE=$((SYMBOLS / MODULES))
+
+echo "Generating $MODULES modules with $PER_MODULE exported symbols each..."
+
+for ((m = 0; m < MODULES; m++)); do
+    {
+        echo ".SECTION text"
+        for ((s = 0; s < PER_MODULE; s++)); do
+            echo ".EXPORT sym_${m}_${s}"
+        done
+        for ((s = 0; s < PER_MODULE; s++)); do
+            echo "sym_${m}_${s}:"
+            echo "    NOP"
+        done
+    } > "module_$m.asm"
+done
+
+STEP=$(((MODULES * PER_MODULE) / IMPORTS))
+
+{
+    echo ".SECTION text"
+    echo ".EXPORT _start"
+    for ((i = 0; i < IMPORTS; i++)); do
+        n=$((i * STEP))
+        echo ".IMPORT sym_$((n / PER_MODULE))_$((n % PER_MODULE))"
+    done
+    echo "_start:"
+    for ((i = 0; i < IMPORTS; i++)); do
+        n=$((i * STEP))
+        echo "    CALL sym_$((n / PER_MODULE))_$((n % PER_MODULE))"
+    done
+} > main.asm
+
+{
+    echo "MEM ROM 0xFFFF 0x0000"
+    echo "PUT text ROM"
+    echo "ENT _start"
+} > link.lds
+
+echo "Assembling..."
+
+for f in *.asm; do
+    "$ASSEMBLER" -o "${f%.asm}.obj" "$f"
+done
+
+echo "Linking $((MODULES * PER_MODULE)) exported symbols with $IMPORTS imports..."
+
+time "$LINKER" -T link.lds -o out.ldm main.obj module_*.obj
@@ -0,0 +1,50 @@
+#!/bin/bash
+#
+# Preprocessor benchmark with large register definition header.
+#
+# Usage: bench/preprocessor_defines.sh <build_dir> [define_count] [line_count]
+#
+# Generates header with define_count constants and module including it with
+# line_count instructions and measures time of assembling the module with i8080
+# assembler from build_dir. Every token emitted by preprocessor is looked up in
+# table of defines, so this is what dominates with large headers.
+
+set -e
+
+BUILD_DIR=$(cd "${1:?Missing build directory!}" && pwd)
+DEFINES=${2:-5000}
+LINES=${3:-20000}
+
+ASSEMBLER="$BUILD_DIR/i8080-assembler"
+
+WORK_DIR=$(mktemp -d)
+trap 'rm -rf "$WORK_DIR"' EXIT
+
+cd "$WORK_DIR"
+
+echo "Generating header with $DEFINES defines..."
+
+{
+    echo "#ifndef REGS_INC"
+    for ((d = 0; d < DEFINES; d++)); do
+        echo "#define REG_$d $((d % 256))"
+    done
+    echo "#define REGS_INC"
+    echo "#endif"
+} > regs.inc
+
+echo "Generating module with $LINES instructions..."
+
+{
+    echo "#include regs.inc"
+    echo ".SECTION text"
+    for ((l = 0; l < LINES; l++)); do
+        echo "#ifdef REG_$(((l * 7919) % DEFINES))"
+        echo "    MVI A $((l % 256))"
+        echo "#endif"
+    done
+} > main.asm
+
+echo "Assembling..."
+
+time "$ASSEMBLER" -o main.obj main.asm
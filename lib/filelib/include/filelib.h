@@ -4,6 +4,7 @@
 #include "../src/ldm.h"
 #include "../src/obj.h"
 #include "../src/sl.h"
+#include "../src/view.h"
 #include "../src/common.h"
 
 #endif
@@ -4,12 +4,17 @@
 #include "obj.h"
 #include "ldm.h"
 #include "sl.h"
+#include "view.h"
 
 #include "_obj.h"
+#include "_sl.h"
 
 #include "struct_check.h"
+#include "writer.h"
 #include "writing_loop.h"
+#include "record_reader.h"
 #include "loading_loop.h"
+#include "binary_loop.h"
 
 #include <stdbool.h>
 #include <stdio.h>
@@ -20,23 +25,75 @@
 #include <utillib/utils.h>
 
 #include <platformlib.h>
+#include <_platformlib.h>
 #include <cwalk.h>
 
-#define FILELIB_ERROR_WRITE(x, ...) error_buffer_write(filelib_error_buffer, (x), ##__VA_ARGS__)
+#if defined(_MSC_VER)
+#define FILELIB_THREAD_LOCAL __declspec(thread)
+#else
+#define FILELIB_THREAD_LOCAL __thread
+#endif
+
+#define FILELIB_ERROR_WRITE(x, ...) error_buffer_write(_filelib_current_error_buffer(), (x), ##__VA_ARGS__)
 
 extern error_t *filelib_error_buffer;
 
-// simplify parsing of output queue
-bool is_token(token_t *token, char *x);
-token_t *_token_load(queue_t *queue);
+//error buffer of context active in calling thread, global one when there is none
+error_t *_filelib_current_error_buffer(void);
+
+//scratch buffers kept by context between calls
+typedef enum{
+    FILELIB_SCRATCH_READER = 0,
+    FILELIB_SCRATCH_WRITER,
+    FILELIB_SCRATCH_IMAGE,
+    FILELIB_SCRATCH_COUNT
+} filelib_scratch_t;
+
+struct filelib_ctx_s{
+    error_t *errors;
+    error_t *platform_errors;
+    struct{
+        void *buffer;
+        size_t capacity;
+    } scratch[FILELIB_SCRATCH_COUNT];
+};
+
+//state replaced by _filelib_ctx_enter, NULL context leaves current one active
+typedef struct{
+    bool entered;
+    filelib_ctx_t *ctx;
+    error_t *platform_errors;
+} filelib_scope_t;
+
+filelib_scope_t _filelib_ctx_enter(filelib_ctx_t *ctx);
+void _filelib_ctx_leave(filelib_scope_t scope);
+
+//buffer of at least size bytes, scratch buffer of active context is taken out
+//of it until it is given back, so nested users just get new one; capacity
+//holds real size of returned buffer
+void *_filelib_scratch_take(filelib_scratch_t kind, size_t size, size_t *capacity);
+//buffer is kept by active context, or freed when there is none
+void _filelib_scratch_give(filelib_scratch_t kind, void *buffer, size_t capacity);
 
 //simplify loading files
 bool _load_string(string_t *input, char *filename, void **output, check_structure_t *check_structure, loading_loop_t *loading_loop);
-bool _load_file(char *filename, void **output, check_structure_t *check_structure, loading_loop_t *loading_loop);
+bool _load_file(char *filename, void **output, check_structure_t *check_structure, loading_loop_t *loading_loop, binary_loading_loop_t *binary_loading_loop);
+//same for stream opened by _open_file, stream is closed
+bool _load_stream(FILE *fp, char *filename, bool binary, void **output, check_structure_t *check_structure, loading_loop_t *loading_loop, binary_loading_loop_t *binary_loading_loop);
+
+//read whole file into memory
+bool _read_file(char *filename, uint8_t **data, size_t *size);
+//open file for reading and tell whether it starts by binary magic, stream is
+//rewound to the beginning, so it can be passed to readers right away
+bool _open_file(char *filename, FILE **fp, bool *binary);
+//read whole opened stream into memory, stream is left open
+bool _read_stream(FILE *fp, char *filename, uint8_t **data, size_t *size);
 
 //simplify writing files
+bool _write_stream(FILE *fp, char *filename, void *data, check_structure_t *check_structure, writing_loop_t *writing_loop);
 bool _write_file(char *filename, void *data, check_structure_t *check_structure,  writing_loop_t *writing_loop);
 bool _write_string(string_t **output, void *data, check_structure_t *check_structure,  writing_loop_t *writing_loop);
+bool _write_binary_file(char *filename, void *data, check_structure_t *check_structure, binary_writing_loop_t *binary_writing_loop);
 
 //some common error msgs
 void _multiple_record_error(char *token, char *filename, long line_number);
@@ -53,4 +110,9 @@ void _unrecognized_record_error(char *filename, long line_number);
 //arch name for structures
 void _set_arch_name(char **);
 
+//building of library index, names are copied
+void _sl_index_new(sl_index_t **index, char *filename);
+void _sl_index_append_member(sl_index_t *index, char *name, unsigned long offset, unsigned long size);
+void _sl_index_append_symbol(sl_index_t *index, char *name, unsigned member);
+
 #endif
@@ -0,0 +1,51 @@
+#ifndef FILELIB_PRIVATE_SL_H_included
+#define FILELIB_PRIVATE_SL_H_included
+
+#include "sl.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+/**
+ * @brief Member of library being written.
+ *
+ * Member is either parsed object, or payload copied as it is from library
+ * which is being updated (object == NULL). Payload of text library starts
+ * with its `.file` record, payload of binary one is object image. Exported
+ * symbols are listed in both cases, so index can be written without parsing
+ * copied members.
+ */
+typedef struct{
+    char *name;
+    obj_file_t *object;
+    uint8_t *payload;
+    size_t payload_size;
+    sl_index_symbol_t *symbols;
+    unsigned symbol_count;
+} sl_member_t;
+
+typedef struct{
+    char *target_arch_name;
+    unsigned count;
+    unsigned capacity;
+    sl_member_t *members;
+} sl_members_t;
+
+void _sl_members_init(sl_members_t *members);
+void _sl_members_release(sl_members_t *members);
+
+// member refers to object and its symbols, it doesn't take ownership of them
+void _sl_members_append_object(sl_members_t *members, char *name, obj_file_t *object);
+// member refers to payload and symbols of index member, nothing is copied
+void _sl_members_append_payload(sl_members_t *members, sl_index_t *index, unsigned member, uint8_t *payload, size_t size);
+
+// all holders of library as members
+void _sl_members_from_file(sl_members_t *members, sl_file_t *f);
+
+// index of library opened by _open_file, stream is closed; missing is set
+// instead of error for text library written without symbol index
+bool _sl_load_index_stream(FILE *fp, char *filename, bool binary, sl_index_t **index, bool *missing);
+
+#endif
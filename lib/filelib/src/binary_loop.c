@@ -0,0 +1,889 @@
+#include "_filelib.h"
+
+static void put_le(uint8_t *p, uintmax_t value, size_t width){
+    for(size_t i = 0; i < width; i++){
+        p[i] = (uint8_t)(value & 0xFF);
+        value >>= 8;
+    }
+}
+
+//-----------------------------------
+// Output buffer
+
+void binary_buffer_init(binary_buffer_t **buffer){
+    CHECK_NULL_ARGUMENT(buffer);
+    CHECK_NOT_NULL_ARGUMENT(*buffer);
+
+    *buffer = (binary_buffer_t *)dynmem_malloc(sizeof(binary_buffer_t));
+
+    (*buffer)->data = NULL;
+    (*buffer)->size = 0;
+    (*buffer)->capacity = 0;
+}
+
+void binary_buffer_destroy(binary_buffer_t *buffer){
+    if(buffer == NULL)
+        return;
+
+    if(buffer->data != NULL){
+        dynmem_free(buffer->data);
+    }
+
+    dynmem_free(buffer);
+}
+
+// reserve zeroed space at the end of buffer and return its offset
+static size_t buffer_reserve(binary_buffer_t *buffer, size_t size){
+    size_t offset = buffer->size;
+
+    if(buffer->size + size > buffer->capacity){
+        size_t capacity = (buffer->capacity == 0) ? 4096 : buffer->capacity;
+
+        while(capacity < buffer->size + size){
+            capacity *= 2;
+        }
+
+        uint8_t *data = (uint8_t *)dynmem_malloc(capacity);
+
+        if(buffer->data != NULL){
+            memcpy(data, buffer->data, buffer->size);
+            dynmem_free(buffer->data);
+        }
+
+        buffer->data = data;
+        buffer->capacity = capacity;
+    }
+
+    memset(buffer->data + offset, 0, size);
+    buffer->size += size;
+
+    return offset;
+}
+
+static void buffer_align(binary_buffer_t *buffer, size_t alignment){
+    size_t padding = (alignment - (buffer->size % alignment)) % alignment;
+
+    if(padding > 0){
+        buffer_reserve(buffer, padding);
+    }
+}
+
+static uint32_t string_table_append(binary_buffer_t *strings, char *s){
+    size_t length = strlen(s) + 1;
+    size_t offset = buffer_reserve(strings, length);
+
+    memcpy(strings->data + offset, s, length);
+
+    return (uint32_t)offset;
+}
+
+static size_t string_table_flush(binary_buffer_t *output, binary_buffer_t *strings){
+    size_t offset = buffer_reserve(output, strings->size);
+
+    if(strings->size > 0){
+        memcpy(output->data + offset, strings->data, strings->size);
+    }
+
+    return offset;
+}
+
+static void write_header(binary_buffer_t *output, size_t base, binary_kind_t kind, uint32_t arch_name){
+    uint8_t *header = output->data + base;
+
+    memcpy(header, BINARY_MAGIC, BINARY_MAGIC_SIZE);
+    put_le(header + HEADER_VERSION, (kind == BINARY_KIND_SL) ? BINARY_SL_VERSION : BINARY_VERSION, 2);
+    header[HEADER_KIND] = (uint8_t)kind;
+    header[HEADER_ADDRESS_WIDTH] = (uint8_t)ADDRESS_WIDTH;
+    header[HEADER_WORD_WIDTH] = (uint8_t)WORD_WIDTH;
+    header[HEADER_ELEMENT_WIDTH] = (uint8_t)ELEMENT_WIDTH;
+    put_le(header + HEADER_ARCH_NAME, arch_name, 4);
+}
+
+//-----------------------------------
+// Writing
+
+static void write_symbol(uint8_t *record, binary_buffer_t *strings, obj_symbol_t *symbol){
+    put_le(record + SYMBOL_RECORD_NAME, string_table_append(strings, symbol->name), 4);
+    put_le(record + SYMBOL_RECORD_VALUE, symbol->value, ADDRESS_WIDTH);
+}
+
+static void write_data(uint8_t *record, obj_data_t *data){
+    uint8_t flags = 0;
+    uintmax_t payload = 0;
+
+    if(data->blob == true){
+        flags |= DATA_FLAG_BLOB;
+        payload = data->payload.blob_value;
+    }
+    else{
+        flags |= data->relocation ? DATA_FLAG_RELOCATION : 0;
+        flags |= data->special ? DATA_FLAG_SPECIAL : 0;
+        payload = data->payload.data_value;
+    }
+
+    record[DATA_RECORD_FLAGS] = flags;
+    put_le(record + DATA_RECORD_ADDRESS, data->address, ADDRESS_WIDTH);
+    put_le(record + DATA_RECORD_PAYLOAD, payload, WORD_WIDTH);
+    put_le(record + DATA_RECORD_SPECIAL_VALUE, data->special_value, ADDRESS_WIDTH);
+}
+
+static void write_obj_image(obj_file_t *obj, binary_buffer_t *output){
+    binary_buffer_t *strings = NULL;
+    uint32_t section_count = list_count(obj->section_list);
+    uint32_t symbol_count = 0;
+    uint32_t data_count = 0;
+
+    for(unsigned i = 0; i < section_count; i++){
+        obj_section_t *section = NULL;
+        list_at(obj->section_list, i, (void *)&section);
+
+        symbol_count += list_count(section->exported_symbol_list);
+        symbol_count += list_count(section->imported_symbol_list);
+        data_count += list_count(section->data_symbol_list);
+    }
+
+    size_t base = buffer_reserve(output, OBJ_HEADER_SIZE);
+    size_t section_table = buffer_reserve(output, section_count * SECTION_RECORD_SIZE);
+    size_t symbol_table = buffer_reserve(output, symbol_count * SYMBOL_RECORD_SIZE);
+    size_t data_table = buffer_reserve(output, data_count * DATA_RECORD_SIZE);
+
+    binary_buffer_init(&strings);
+
+    uint32_t arch_name = string_table_append(strings, obj->target_arch_name);
+    uint32_t symbol_index = 0;
+    uint32_t data_index = 0;
+
+    for(unsigned i = 0; i < section_count; i++){
+        obj_section_t *section = NULL;
+        list_at(obj->section_list, i, (void *)&section);
+
+        uint8_t *record = output->data + section_table + i * SECTION_RECORD_SIZE;
+
+        put_le(record + SECTION_RECORD_NAME, string_table_append(strings, section->section_name), 4);
+
+        put_le(record + SECTION_RECORD_EXPORT_FIRST, symbol_index, 4);
+        put_le(record + SECTION_RECORD_EXPORT_COUNT, list_count(section->exported_symbol_list), 4);
+
+        for(unsigned j = 0; j < list_count(section->exported_symbol_list); j++){
+            obj_symbol_t *symbol = NULL;
+            list_at(section->exported_symbol_list, j, (void *)&symbol);
+            write_symbol(output->data + symbol_table + (symbol_index++) * SYMBOL_RECORD_SIZE, strings, symbol);
+        }
+
+        put_le(record + SECTION_RECORD_IMPORT_FIRST, symbol_index, 4);
+        put_le(record + SECTION_RECORD_IMPORT_COUNT, list_count(section->imported_symbol_list), 4);
+
+        for(unsigned j = 0; j < list_count(section->imported_symbol_list); j++){
+            obj_symbol_t *symbol = NULL;
+            list_at(section->imported_symbol_list, j, (void *)&symbol);
+            write_symbol(output->data + symbol_table + (symbol_index++) * SYMBOL_RECORD_SIZE, strings, symbol);
+        }
+
+        put_le(record + SECTION_RECORD_DATA_FIRST, data_index, 4);
+        put_le(record + SECTION_RECORD_DATA_COUNT, list_count(section->data_symbol_list), 4);
+
+        for(unsigned j = 0; j < list_count(section->data_symbol_list); j++){
+            obj_data_t *data = NULL;
+            list_at(section->data_symbol_list, j, (void *)&data);
+            write_data(output->data + data_table + (data_index++) * DATA_RECORD_SIZE, data);
+        }
+    }
+
+    size_t string_table = string_table_flush(output, strings);
+
+    write_header(output, base, BINARY_KIND_OBJ, arch_name);
+
+    uint8_t *header = output->data + base;
+
+    put_le(header + OBJ_SECTION_COUNT, section_count, 4);
+    put_le(header + OBJ_SECTION_TABLE, section_table - base, 4);
+    put_le(header + OBJ_SYMBOL_COUNT, symbol_count, 4);
+    put_le(header + OBJ_SYMBOL_TABLE, symbol_table - base, 4);
+    put_le(header + OBJ_DATA_COUNT, data_count, 4);
+    put_le(header + OBJ_DATA_TABLE, data_table - base, 4);
+    put_le(header + OBJ_STRING_TABLE_SIZE, strings->size, 4);
+    put_le(header + OBJ_STRING_TABLE, string_table - base, 4);
+
+    binary_buffer_destroy(strings);
+}
+
+bool binary_writing_loop_obj(void *input, binary_buffer_t *output){
+    CHECK_NULL_ARGUMENT(input);
+    CHECK_NULL_ARGUMENT(output);
+
+    write_obj_image((obj_file_t *)input, output);
+
+    return true;
+}
+
+bool binary_writing_loop_sl_members(void *input, binary_buffer_t *output){
+    CHECK_NULL_ARGUMENT(input);
+    CHECK_NULL_ARGUMENT(output);
+
+    sl_members_t *_data = (sl_members_t *)input;
+    binary_buffer_t *strings = NULL;
+    uint32_t member_count = _data->count;
+    uint32_t symbol_count = 0;
+
+    for(unsigned i = 0; i < member_count; i++){
+        symbol_count += _data->members[i].symbol_count;
+    }
+
+    size_t base = buffer_reserve(output, SL_HEADER_SIZE);
+    size_t member_table = buffer_reserve(output, member_count * MEMBER_RECORD_SIZE);
+    size_t symbol_table = buffer_reserve(output, symbol_count * SL_SYMBOL_RECORD_SIZE);
+    uint32_t symbol_index = 0;
+
+    binary_buffer_init(&strings);
+
+    uint32_t arch_name = string_table_append(strings, _data->target_arch_name);
+
+    for(unsigned i = 0; i < member_count; i++){
+        sl_member_t *member = &(_data->members[i]);
+
+        uint8_t *record = output->data + member_table + i * MEMBER_RECORD_SIZE;
+        put_le(record + MEMBER_RECORD_NAME, string_table_append(strings, member->name), 4);
+
+        //symbol index, exports are stored in member order
+        for(unsigned j = 0; j < member->symbol_count; j++){
+            uint8_t *symbol_record = output->data + symbol_table + symbol_index++ * SL_SYMBOL_RECORD_SIZE;
+            put_le(symbol_record + SL_SYMBOL_RECORD_NAME, string_table_append(strings, member->symbols[j].name), 4);
+            put_le(symbol_record + SL_SYMBOL_RECORD_MEMBER, i, 4);
+        }
+    }
+
+    size_t string_table = string_table_flush(output, strings);
+
+    for(unsigned i = 0; i < member_count; i++){
+        sl_member_t *member = &(_data->members[i]);
+
+        buffer_align(output, MEMBER_ALIGNMENT);
+
+        size_t image = output->size;
+
+        //images are position independent, so copied member is kept as it is
+        if(member->object == NULL){
+            buffer_reserve(output, member->payload_size);
+            memcpy(output->data + image, member->payload, member->payload_size);
+        }
+        else{
+            write_obj_image(member->object, output);
+        }
+
+        uint8_t *record = output->data + member_table + i * MEMBER_RECORD_SIZE;
+        put_le(record + MEMBER_RECORD_OFFSET, image - base, 4);
+        put_le(record + MEMBER_RECORD_IMAGE_SIZE, output->size - image, 4);
+    }
+
+    write_header(output, base, BINARY_KIND_SL, arch_name);
+
+    uint8_t *header = output->data + base;
+
+    put_le(header + SL_MEMBER_COUNT, member_count, 4);
+    put_le(header + SL_MEMBER_TABLE, member_table - base, 4);
+    put_le(header + SL_STRING_TABLE_SIZE, strings->size, 4);
+    put_le(header + SL_STRING_TABLE, string_table - base, 4);
+    put_le(header + SL_SYMBOL_COUNT, symbol_count, 4);
+    put_le(header + SL_SYMBOL_TABLE, symbol_table - base, 4);
+
+    binary_buffer_destroy(strings);
+
+    return true;
+}
+
+bool binary_writing_loop_sl(void *input, binary_buffer_t *output){
+    CHECK_NULL_ARGUMENT(input);
+    CHECK_NULL_ARGUMENT(output);
+
+    sl_members_t members;
+
+    _sl_members_from_file(&members, (sl_file_t *)input);
+
+    bool retVal = binary_writing_loop_sl_members((void *)&members, output);
+
+    _sl_members_release(&members);
+
+    return retVal;
+}
+
+// elements with consecutive addresses are stored as single run
+typedef struct{
+    binary_buffer_t *output;
+    size_t run_table;
+    size_t element_table;
+    uint8_t *run;
+    uint32_t run_index;
+    uint32_t element_index;
+    isa_address_t previous;
+    bool first;
+} ldm_runs_t;
+
+static void count_run_element(isa_address_t address, isa_memory_element_t word, void *context){
+    (void)word;
+
+    ldm_runs_t *runs = (ldm_runs_t *)context;
+
+    if(runs->first || address != (isa_address_t)(runs->previous + 1)){
+        runs->run_index++;
+    }
+
+    runs->element_index++;
+    runs->previous = address;
+    runs->first = false;
+}
+
+static void put_run_element(isa_address_t address, isa_memory_element_t word, void *context){
+    ldm_runs_t *runs = (ldm_runs_t *)context;
+    uint8_t *data = runs->output->data;
+
+    if(runs->first || address != (isa_address_t)(runs->previous + 1)){
+        runs->run = data + runs->run_table + (runs->run_index++) * RUN_RECORD_SIZE;
+        put_le(runs->run + RUN_RECORD_ADDRESS, address, ADDRESS_WIDTH);
+        put_le(runs->run + RUN_RECORD_ELEMENT_FIRST, runs->element_index, 4);
+    }
+
+    put_le(runs->run + RUN_RECORD_COUNT, binary_get_u32(runs->run + RUN_RECORD_COUNT) + 1, 4);
+    put_le(data + runs->element_table + (runs->element_index++) * ELEMENT_WIDTH, word, ELEMENT_WIDTH);
+
+    runs->previous = address;
+    runs->first = false;
+}
+
+bool binary_writing_loop_ldm(void *input, binary_buffer_t *output){
+    CHECK_NULL_ARGUMENT(input);
+    CHECK_NULL_ARGUMENT(output);
+
+    ldm_file_t *_data = (ldm_file_t *)input;
+    binary_buffer_t *strings = NULL;
+    uint32_t memory_count = list_count(_data->memories);
+    ldm_runs_t runs;
+
+    runs.output = output;
+    runs.run = NULL;
+    runs.run_index = 0;
+    runs.element_index = 0;
+
+    for(unsigned i = 0; i < memory_count; i++){
+        ldm_memory_t *mem = NULL;
+        list_at(_data->memories, i, (void *)&mem);
+
+        runs.first = true;
+        ldm_mem_foreach(mem, &count_run_element, (void *)&runs);
+    }
+
+    uint32_t run_count = runs.run_index;
+    uint32_t element_count = runs.element_index;
+
+    size_t base = buffer_reserve(output, LDM_HEADER_SIZE);
+    size_t memory_table = buffer_reserve(output, memory_count * MEMORY_RECORD_SIZE);
+    size_t run_table = buffer_reserve(output, run_count * RUN_RECORD_SIZE);
+    size_t element_table = buffer_reserve(output, element_count * ELEMENT_WIDTH);
+
+    binary_buffer_init(&strings);
+
+    uint32_t arch_name = string_table_append(strings, _data->target_arch_name);
+
+    runs.run_table = run_table;
+    runs.element_table = element_table;
+    runs.run_index = 0;
+    runs.element_index = 0;
+
+    for(unsigned i = 0; i < memory_count; i++){
+        ldm_memory_t *mem = NULL;
+        uint32_t run_first = runs.run_index;
+
+        list_at(_data->memories, i, (void *)&mem);
+
+        uint8_t *record = output->data + memory_table + i * MEMORY_RECORD_SIZE;
+
+        put_le(record + MEMORY_RECORD_NAME, string_table_append(strings, mem->memory_name), 4);
+        put_le(record + MEMORY_RECORD_BEGIN, mem->begin_addr, ADDRESS_WIDTH);
+        put_le(record + MEMORY_RECORD_MEMORY_SIZE, mem->size, ADDRESS_WIDTH);
+
+        runs.first = true;
+        ldm_mem_foreach(mem, &put_run_element, (void *)&runs);
+
+        put_le(record + MEMORY_RECORD_RUN_FIRST, run_first, 4);
+        put_le(record + MEMORY_RECORD_RUN_COUNT, runs.run_index - run_first, 4);
+    }
+
+    size_t string_table = string_table_flush(output, strings);
+
+    write_header(output, base, BINARY_KIND_LDM, arch_name);
+
+    uint8_t *header = output->data + base;
+
+    put_le(header + LDM_MEMORY_COUNT, memory_count, 4);
+    put_le(header + LDM_MEMORY_TABLE, memory_table - base, 4);
+    put_le(header + LDM_RUN_COUNT, run_count, 4);
+    put_le(header + LDM_RUN_TABLE, run_table - base, 4);
+    put_le(header + LDM_ELEMENT_COUNT, element_count, 4);
+    put_le(header + LDM_ELEMENT_TABLE, element_table - base, 4);
+    put_le(header + LDM_STRING_TABLE_SIZE, strings->size, 4);
+    put_le(header + LDM_STRING_TABLE, string_table - base, 4);
+    put_le(header + LDM_ENTRY_POINT, _data->entry_point, ADDRESS_WIDTH);
+
+    binary_buffer_destroy(strings);
+
+    return true;
+}
+
+//-----------------------------------
+// Loading
+
+bool binary_is_magic(uint8_t *input, size_t size){
+    if(input == NULL || size < BINARY_MAGIC_SIZE){
+        return false;
+    }
+
+    return memcmp(input, BINARY_MAGIC, BINARY_MAGIC_SIZE) == 0 ? true : false;
+}
+
+static void corrupted_file_error(char *filename){
+    FILELIB_ERROR_WRITE("Binary file %s is corrupted!", filename);
+}
+
+static bool check_table(size_t size, uint32_t offset, uint32_t count, size_t record_size){
+    return ((uintmax_t)offset + (uintmax_t)count * record_size) <= size ? true : false;
+}
+
+static bool check_range(uint32_t first, uint32_t count, uint32_t total){
+    return ((uintmax_t)first + count) <= total ? true : false;
+}
+
+static bool check_header(uint8_t *input, size_t size, binary_kind_t kind, size_t header_size, char *filename){
+    if(!binary_is_magic(input, size) || size < header_size){
+        corrupted_file_error(filename);
+        return false;
+    }
+
+    unsigned version = (unsigned)binary_get_le(input + HEADER_VERSION, 2);
+    unsigned max_version = (kind == BINARY_KIND_SL) ? BINARY_SL_VERSION : BINARY_VERSION;
+
+    if(version < 1 || version > max_version){
+        FILELIB_ERROR_WRITE("Unsupported version %u of binary file %s!", version, filename);
+        return false;
+    }
+
+    if(input[HEADER_KIND] != kind){
+        FILELIB_ERROR_WRITE("Binary file %s doesn't contain expected type of data!", filename);
+        return false;
+    }
+
+    if(input[HEADER_ADDRESS_WIDTH] != ADDRESS_WIDTH || input[HEADER_WORD_WIDTH] != WORD_WIDTH || input[HEADER_ELEMENT_WIDTH] != ELEMENT_WIDTH){
+        FILELIB_ERROR_WRITE("Binary file %s was written with different ISA types width!", filename);
+        return false;
+    }
+
+    return true;
+}
+
+// string table have to end with terminator, then every reference inside of it is valid string
+static bool check_string_table(uint8_t *input, size_t size, uint32_t offset, uint32_t string_table_size, char *filename){
+    if(string_table_size == 0 || !check_table(size, offset, string_table_size, 1) || input[offset + string_table_size - 1] != '\0'){
+        corrupted_file_error(filename);
+        return false;
+    }
+
+    uint32_t arch_name = binary_get_u32(input + HEADER_ARCH_NAME);
+
+    if(arch_name >= string_table_size){
+        corrupted_file_error(filename);
+        return false;
+    }
+
+    if(strcmp((char *)(input + offset + arch_name), TARGET_ARCH_NAME) != 0){
+        _wrong_architecture_error(filename, (char *)(input + offset + arch_name));
+        return false;
+    }
+
+    return true;
+}
+
+bool binary_obj_view_init(obj_view_t *view, uint8_t *input, size_t size, char *filename){
+    CHECK_NULL_ARGUMENT(view);
+    CHECK_NULL_ARGUMENT(filename);
+
+    if(!check_header(input, size, BINARY_KIND_OBJ, OBJ_HEADER_SIZE, filename)){
+        return false;
+    }
+
+    uint32_t section_count = binary_get_u32(input + OBJ_SECTION_COUNT);
+    uint32_t section_table = binary_get_u32(input + OBJ_SECTION_TABLE);
+    uint32_t symbol_count = binary_get_u32(input + OBJ_SYMBOL_COUNT);
+    uint32_t symbol_table = binary_get_u32(input + OBJ_SYMBOL_TABLE);
+    uint32_t data_count = binary_get_u32(input + OBJ_DATA_COUNT);
+    uint32_t data_table = binary_get_u32(input + OBJ_DATA_TABLE);
+    uint32_t string_table_size = binary_get_u32(input + OBJ_STRING_TABLE_SIZE);
+    uint32_t string_table = binary_get_u32(input + OBJ_STRING_TABLE);
+
+    if(!check_table(size, section_table, section_count, SECTION_RECORD_SIZE) ||
+       !check_table(size, symbol_table, symbol_count, SYMBOL_RECORD_SIZE) ||
+       !check_table(size, data_table, data_count, DATA_RECORD_SIZE)){
+        corrupted_file_error(filename);
+        return false;
+    }
+
+    if(!check_string_table(input, size, string_table, string_table_size, filename)){
+        return false;
+    }
+
+    //validate everything here, so accessors of view don't need to
+    for(uint32_t i = 0; i < section_count; i++){
+        uint8_t *record = input + section_table + i * SECTION_RECORD_SIZE;
+
+        if(binary_get_u32(record + SECTION_RECORD_NAME) >= string_table_size ||
+           !check_range(binary_get_u32(record + SECTION_RECORD_EXPORT_FIRST), binary_get_u32(record + SECTION_RECORD_EXPORT_COUNT), symbol_count) ||
+           !check_range(binary_get_u32(record + SECTION_RECORD_IMPORT_FIRST), binary_get_u32(record + SECTION_RECORD_IMPORT_COUNT), symbol_count) ||
+           !check_range(binary_get_u32(record + SECTION_RECORD_DATA_FIRST), binary_get_u32(record + SECTION_RECORD_DATA_COUNT), data_count)){
+            corrupted_file_error(filename);
+            return false;
+        }
+    }
+
+    for(uint32_t i = 0; i < symbol_count; i++){
+        if(binary_get_u32(input + symbol_table + i * SYMBOL_RECORD_SIZE + SYMBOL_RECORD_NAME) >= string_table_size){
+            corrupted_file_error(filename);
+            return false;
+        }
+    }
+
+    view->image = input;
+    view->image_size = size;
+    view->string_table = (char *)(input + string_table);
+    view->target_arch_name = view->string_table + binary_get_u32(input + HEADER_ARCH_NAME);
+    view->section_count = section_count;
+    view->section_table = input + section_table;
+    view->symbol_table = input + symbol_table;
+    view->data_table = input + data_table;
+
+    return true;
+}
+
+static bool is_sl_indexed(uint8_t *input){
+    return binary_get_le(input + HEADER_VERSION, 2) >= 2 ? true : false;
+}
+
+// members are checked against size of whole file, tables against size of input
+static bool check_sl_tables(uint8_t *input, size_t size, size_t file_size, char *filename){
+    uint32_t member_count = binary_get_u32(input + SL_MEMBER_COUNT);
+    uint32_t member_table = binary_get_u32(input + SL_MEMBER_TABLE);
+    uint32_t string_table_size = binary_get_u32(input + SL_STRING_TABLE_SIZE);
+    uint32_t string_table = binary_get_u32(input + SL_STRING_TABLE);
+
+    if(!check_table(size, member_table, member_count, MEMBER_RECORD_SIZE)){
+        corrupted_file_error(filename);
+        return false;
+    }
+
+    if(!check_string_table(input, size, string_table, string_table_size, filename)){
+        return false;
+    }
+
+    //members itself are validated when they are opened
+    for(uint32_t i = 0; i < member_count; i++){
+        uint8_t *record = input + member_table + i * MEMBER_RECORD_SIZE;
+
+        if(binary_get_u32(record + MEMBER_RECORD_NAME) >= string_table_size ||
+           !check_table(file_size, binary_get_u32(record + MEMBER_RECORD_OFFSET), binary_get_u32(record + MEMBER_RECORD_IMAGE_SIZE), 1)){
+            corrupted_file_error(filename);
+            return false;
+        }
+    }
+
+    if(is_sl_indexed(input)){
+        uint32_t symbol_count = binary_get_u32(input + SL_SYMBOL_COUNT);
+        uint32_t symbol_table = binary_get_u32(input + SL_SYMBOL_TABLE);
+
+        if(!check_table(size, symbol_table, symbol_count, SL_SYMBOL_RECORD_SIZE)){
+            corrupted_file_error(filename);
+            return false;
+        }
+
+        //symbols are ordered by members, so members can refer to continuous range
+        uint32_t previous = 0;
+
+        for(uint32_t i = 0; i < symbol_count; i++){
+            uint8_t *record = input + symbol_table + i * SL_SYMBOL_RECORD_SIZE;
+            uint32_t member = binary_get_u32(record + SL_SYMBOL_RECORD_MEMBER);
+
+            if(binary_get_u32(record + SL_SYMBOL_RECORD_NAME) >= string_table_size || member >= member_count || member < previous){
+                corrupted_file_error(filename);
+                return false;
+            }
+
+            previous = member;
+        }
+    }
+
+    return true;
+}
+
+bool binary_sl_view_init(sl_view_t *view, uint8_t *input, size_t size, char *filename){
+    CHECK_NULL_ARGUMENT(view);
+    CHECK_NULL_ARGUMENT(filename);
+
+    if(!check_header(input, size, BINARY_KIND_SL, SL_HEADER_SIZE_V1, filename)){
+        return false;
+    }
+
+    if(is_sl_indexed(input) && size < SL_HEADER_SIZE){
+        corrupted_file_error(filename);
+        return false;
+    }
+
+    if(!check_sl_tables(input, size, size, filename)){
+        return false;
+    }
+
+    view->image = input;
+    view->image_size = size;
+    view->string_table = (char *)(input + binary_get_u32(input + SL_STRING_TABLE));
+    view->target_arch_name = view->string_table + binary_get_u32(input + HEADER_ARCH_NAME);
+    view->member_count = binary_get_u32(input + SL_MEMBER_COUNT);
+    view->member_table = input + binary_get_u32(input + SL_MEMBER_TABLE);
+    view->indexed = is_sl_indexed(input);
+    view->symbol_count = 0;
+    view->symbol_table = NULL;
+    view->index = NULL;
+
+    if(view->indexed == true){
+        view->symbol_count = binary_get_u32(input + SL_SYMBOL_COUNT);
+        view->symbol_table = input + binary_get_u32(input + SL_SYMBOL_TABLE);
+    }
+
+    return true;
+}
+
+size_t binary_sl_index_size(uint8_t *input, size_t size, char *filename){
+    CHECK_NULL_ARGUMENT(input);
+    CHECK_NULL_ARGUMENT(filename);
+
+    if(!check_header(input, size, BINARY_KIND_SL, SL_HEADER_SIZE_V1, filename)){
+        return 0;
+    }
+
+    if(!is_sl_indexed(input)){
+        FILELIB_ERROR_WRITE("Library %s doesn't contain symbol index!", filename);
+        return 0;
+    }
+
+    if(size < SL_HEADER_SIZE){
+        corrupted_file_error(filename);
+        return 0;
+    }
+
+    //tables are stored in front of members, string table is the last one
+    uintmax_t end = SL_HEADER_SIZE;
+    uintmax_t tables[3][2] = {
+        {binary_get_u32(input + SL_MEMBER_TABLE), (uintmax_t)binary_get_u32(input + SL_MEMBER_COUNT) * MEMBER_RECORD_SIZE},
+        {binary_get_u32(input + SL_SYMBOL_TABLE), (uintmax_t)binary_get_u32(input + SL_SYMBOL_COUNT) * SL_SYMBOL_RECORD_SIZE},
+        {binary_get_u32(input + SL_STRING_TABLE), binary_get_u32(input + SL_STRING_TABLE_SIZE)}
+    };
+
+    for(unsigned i = 0; i < 3; i++){
+        if(tables[i][0] + tables[i][1] > end){
+            end = tables[i][0] + tables[i][1];
+        }
+    }
+
+    return (size_t)end;
+}
+
+bool binary_sl_index_init(sl_index_t *index, uint8_t *input, size_t size, size_t file_size, char *filename){
+    CHECK_NULL_ARGUMENT(index);
+    CHECK_NULL_ARGUMENT(input);
+    CHECK_NULL_ARGUMENT(filename);
+
+    if(size < SL_HEADER_SIZE || !check_sl_tables(input, size, file_size, filename)){
+        return false;
+    }
+
+    char *strings = (char *)(input + binary_get_u32(input + SL_STRING_TABLE));
+    uint32_t member_count = binary_get_u32(input + SL_MEMBER_COUNT);
+    uint32_t symbol_count = binary_get_u32(input + SL_SYMBOL_COUNT);
+    uint8_t *member_table = input + binary_get_u32(input + SL_MEMBER_TABLE);
+    uint8_t *symbol_table = input + binary_get_u32(input + SL_SYMBOL_TABLE);
+
+    for(uint32_t i = 0; i < member_count; i++){
+        uint8_t *record = member_table + i * MEMBER_RECORD_SIZE;
+
+        _sl_index_append_member(index, strings + binary_get_u32(record + MEMBER_RECORD_NAME),
+            binary_get_u32(record + MEMBER_RECORD_OFFSET), binary_get_u32(record + MEMBER_RECORD_IMAGE_SIZE));
+    }
+
+    for(uint32_t i = 0; i < symbol_count; i++){
+        uint8_t *record = symbol_table + i * SL_SYMBOL_RECORD_SIZE;
+
+        _sl_index_append_symbol(index, strings + binary_get_u32(record + SL_SYMBOL_RECORD_NAME), binary_get_u32(record + SL_SYMBOL_RECORD_MEMBER));
+    }
+
+    return true;
+}
+
+bool binary_sl_view_member_init(sl_view_t *view, unsigned index, obj_view_t *member){
+    CHECK_NULL_ARGUMENT(view);
+    CHECK_NULL_ARGUMENT(member);
+
+    if(index >= view->member_count){
+        error("Requesting member %u of library %s with only %u members!", index, view->filename, view->member_count);
+    }
+
+    uint8_t *record = view->member_table + index * MEMBER_RECORD_SIZE;
+    uint8_t *image = view->image + binary_get_u32(record + MEMBER_RECORD_OFFSET);
+    size_t image_size = binary_get_u32(record + MEMBER_RECORD_IMAGE_SIZE);
+
+    if(!binary_obj_view_init(member, image, image_size, view->filename)){
+        FILELIB_ERROR_WRITE("Error parsing file %s!", view->filename);
+        return false;
+    }
+
+    return true;
+}
+
+bool binary_loading_loop_obj(uint8_t *input, size_t size, void **output, char *filename){
+    CHECK_NULL_ARGUMENT(input);
+    CHECK_NULL_ARGUMENT(output);
+    CHECK_NOT_NULL_ARGUMENT(*output);
+    CHECK_NULL_ARGUMENT(filename);
+
+    obj_view_t view;
+
+    if(!binary_obj_view_init(&view, input, size, filename)){
+        return false;
+    }
+
+    obj_view_to_file(&view, (obj_file_t **)output);
+
+    return true;
+}
+
+bool binary_loading_loop_sl(uint8_t *input, size_t size, void **output, char *filename){
+    CHECK_NULL_ARGUMENT(input);
+    CHECK_NULL_ARGUMENT(output);
+    CHECK_NOT_NULL_ARGUMENT(*output);
+    CHECK_NULL_ARGUMENT(filename);
+
+    sl_view_t view;
+    sl_file_t *sl_file = NULL;
+
+    view.filename = filename;
+
+    if(!binary_sl_view_init(&view, input, size, filename)){
+        return false;
+    }
+
+    sl_file_new(&sl_file);
+
+    for(unsigned i = 0; i < view.member_count; i++){
+        obj_view_t member;
+        obj_file_t *obj_file = NULL;
+        sl_holder_t *holder = NULL;
+
+        if(!binary_sl_view_member_init(&view, i, &member)){
+            sl_file_destroy(sl_file);
+            return false;
+        }
+
+        obj_view_to_file(&member, &obj_file);
+        sl_holder_new(&holder, sl_view_member_name(&view, i), obj_file);
+        sl_holder_into_file(sl_file, holder);
+    }
+
+    *output = (void *)sl_file;
+
+    return true;
+}
+
+bool binary_loading_loop_ldm(uint8_t *input, size_t size, void **output, char *filename){
+    CHECK_NULL_ARGUMENT(input);
+    CHECK_NULL_ARGUMENT(output);
+    CHECK_NOT_NULL_ARGUMENT(*output);
+    CHECK_NULL_ARGUMENT(filename);
+
+    if(!check_header(input, size, BINARY_KIND_LDM, LDM_HEADER_SIZE, filename)){
+        return false;
+    }
+
+    uint32_t memory_count = binary_get_u32(input + LDM_MEMORY_COUNT);
+    uint32_t memory_table = binary_get_u32(input + LDM_MEMORY_TABLE);
+    uint32_t run_count = binary_get_u32(input + LDM_RUN_COUNT);
+    uint32_t run_table = binary_get_u32(input + LDM_RUN_TABLE);
+    uint32_t element_count = binary_get_u32(input + LDM_ELEMENT_COUNT);
+    uint32_t element_table = binary_get_u32(input + LDM_ELEMENT_TABLE);
+
+    if(!check_table(size, memory_table, memory_count, MEMORY_RECORD_SIZE) ||
+       !check_table(size, run_table, run_count, RUN_RECORD_SIZE) ||
+       !check_table(size, element_table, element_count, ELEMENT_WIDTH)){
+        corrupted_file_error(filename);
+        return false;
+    }
+
+    uint32_t string_table_size = binary_get_u32(input + LDM_STRING_TABLE_SIZE);
+    uint32_t string_table = binary_get_u32(input + LDM_STRING_TABLE);
+
+    if(!check_string_table(input, size, string_table, string_table_size, filename)){
+        return false;
+    }
+
+    bool retVal = true;
+    ldm_file_t *ldm_file = NULL;
+
+    ldm_file_new(&ldm_file);
+    ldm_file_set_entry(ldm_file, (isa_address_t)binary_get_le(input + LDM_ENTRY_POINT, ADDRESS_WIDTH));
+
+    for(uint32_t i = 0; i < memory_count && retVal == true; i++){
+        uint8_t *record = input + memory_table + i * MEMORY_RECORD_SIZE;
+        uint32_t name = binary_get_u32(record + MEMORY_RECORD_NAME);
+        uint32_t run_first = binary_get_u32(record + MEMORY_RECORD_RUN_FIRST);
+        uint32_t memory_run_count = binary_get_u32(record + MEMORY_RECORD_RUN_COUNT);
+        ldm_memory_t *mem = NULL;
+
+        if(name >= string_table_size || !check_range(run_first, memory_run_count, run_count)){
+            retVal = false;
+            break;
+        }
+
+        ldm_mem_new_image(
+            (char *)(input + string_table + name),
+            &mem,
+            (isa_address_t)binary_get_le(record + MEMORY_RECORD_MEMORY_SIZE, ADDRESS_WIDTH),
+            (isa_address_t)binary_get_le(record + MEMORY_RECORD_BEGIN, ADDRESS_WIDTH)
+        );
+
+        for(uint32_t j = run_first; j < run_first + memory_run_count; j++){
+            uint8_t *run = input + run_table + j * RUN_RECORD_SIZE;
+            isa_address_t address = (isa_address_t)binary_get_le(run + RUN_RECORD_ADDRESS, ADDRESS_WIDTH);
+            uint32_t count = binary_get_u32(run + RUN_RECORD_COUNT);
+            uint32_t element_first = binary_get_u32(run + RUN_RECORD_ELEMENT_FIRST);
+
+            if(!check_range(element_first, count, element_count)){
+                retVal = false;
+                break;
+            }
+
+            for(uint32_t k = 0; k < count; k++){
+                isa_memory_element_t word = (isa_memory_element_t)binary_get_le(input + element_table + (element_first + k) * ELEMENT_WIDTH, ELEMENT_WIDTH);
+
+                ldm_mem_set(mem, (isa_address_t)(address + k), word);
+            }
+        }
+
+        if(retVal == false){
+            ldm_mem_destroy(mem);
+            break;
+        }
+
+        ldm_mem_into_file(ldm_file, mem);
+    }
+
+    if(retVal == true){
+        *output = (void *)ldm_file;
+    }
+    else{
+        corrupted_file_error(filename);
+        ldm_file_destroy(ldm_file);
+    }
+
+    return retVal;
+}
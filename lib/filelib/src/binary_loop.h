@@ -0,0 +1,172 @@
+#ifndef FILELIB_BINARY_LOOP_H_included
+#define FILELIB_BINARY_LOOP_H_included
+
+#include "view.h"
+#include "sl.h"
+
+#include <utillib/core.h>
+#include <platformlib.h>
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define BINARY_MAGIC "M2BF"
+#define BINARY_MAGIC_SIZE 4
+#define BINARY_VERSION 1
+// version 2 of library adds table of exported symbols
+#define BINARY_SL_VERSION 2
+
+//-----------------------------------
+// Binary layout
+//
+// All numbers are little endian, ISA types are stored with width of the
+// toolchain types and the widths are recorded in header so file can't be
+// mixed between incompatible builds. Names are kept in string table and
+// records refer to them by offset into the table. All table offsets are
+// relative to the beginning of the image, so object image can be embedded
+// into static library as it is.
+
+#define ADDRESS_WIDTH sizeof(isa_address_t)
+#define WORD_WIDTH sizeof(isa_instruction_word_t)
+#define ELEMENT_WIDTH sizeof(isa_memory_element_t)
+
+#define HEADER_VERSION 4
+#define HEADER_KIND 6
+#define HEADER_ADDRESS_WIDTH 7
+#define HEADER_WORD_WIDTH 8
+#define HEADER_ELEMENT_WIDTH 9
+#define HEADER_ARCH_NAME 12
+
+#define OBJ_SECTION_COUNT 16
+#define OBJ_SECTION_TABLE 20
+#define OBJ_SYMBOL_COUNT 24
+#define OBJ_SYMBOL_TABLE 28
+#define OBJ_DATA_COUNT 32
+#define OBJ_DATA_TABLE 36
+#define OBJ_STRING_TABLE_SIZE 40
+#define OBJ_STRING_TABLE 44
+#define OBJ_HEADER_SIZE 48
+
+#define SECTION_RECORD_NAME 0
+#define SECTION_RECORD_EXPORT_FIRST 4
+#define SECTION_RECORD_EXPORT_COUNT 8
+#define SECTION_RECORD_IMPORT_FIRST 12
+#define SECTION_RECORD_IMPORT_COUNT 16
+#define SECTION_RECORD_DATA_FIRST 20
+#define SECTION_RECORD_DATA_COUNT 24
+#define SECTION_RECORD_SIZE 28
+
+#define SYMBOL_RECORD_NAME 0
+#define SYMBOL_RECORD_VALUE 4
+#define SYMBOL_RECORD_SIZE (4 + ADDRESS_WIDTH)
+
+#define DATA_FLAG_BLOB 0x01
+#define DATA_FLAG_RELOCATION 0x02
+#define DATA_FLAG_SPECIAL 0x04
+
+#define DATA_RECORD_FLAGS 0
+#define DATA_RECORD_ADDRESS 1
+#define DATA_RECORD_PAYLOAD (1 + ADDRESS_WIDTH)
+#define DATA_RECORD_SPECIAL_VALUE (1 + ADDRESS_WIDTH + WORD_WIDTH)
+#define DATA_RECORD_SIZE (1 + 2 * ADDRESS_WIDTH + WORD_WIDTH)
+
+#define SL_MEMBER_COUNT 16
+#define SL_MEMBER_TABLE 20
+#define SL_STRING_TABLE_SIZE 24
+#define SL_STRING_TABLE 28
+#define SL_HEADER_SIZE_V1 32
+#define SL_SYMBOL_COUNT 32
+#define SL_SYMBOL_TABLE 36
+#define SL_HEADER_SIZE 40
+
+#define MEMBER_RECORD_NAME 0
+#define MEMBER_RECORD_OFFSET 4
+#define MEMBER_RECORD_IMAGE_SIZE 8
+#define MEMBER_RECORD_SIZE 12
+#define MEMBER_ALIGNMENT 8
+
+#define SL_SYMBOL_RECORD_NAME 0
+#define SL_SYMBOL_RECORD_MEMBER 4
+#define SL_SYMBOL_RECORD_SIZE 8
+
+#define LDM_MEMORY_COUNT 16
+#define LDM_MEMORY_TABLE 20
+#define LDM_RUN_COUNT 24
+#define LDM_RUN_TABLE 28
+#define LDM_ELEMENT_COUNT 32
+#define LDM_ELEMENT_TABLE 36
+#define LDM_STRING_TABLE_SIZE 40
+#define LDM_STRING_TABLE 44
+#define LDM_ENTRY_POINT 48
+#define LDM_HEADER_SIZE 56
+
+#define MEMORY_RECORD_NAME 0
+#define MEMORY_RECORD_BEGIN 4
+#define MEMORY_RECORD_MEMORY_SIZE (4 + ADDRESS_WIDTH)
+#define MEMORY_RECORD_RUN_FIRST (4 + 2 * ADDRESS_WIDTH)
+#define MEMORY_RECORD_RUN_COUNT (8 + 2 * ADDRESS_WIDTH)
+#define MEMORY_RECORD_SIZE (12 + 2 * ADDRESS_WIDTH)
+
+#define RUN_RECORD_ADDRESS 0
+#define RUN_RECORD_COUNT ADDRESS_WIDTH
+#define RUN_RECORD_ELEMENT_FIRST (4 + ADDRESS_WIDTH)
+#define RUN_RECORD_SIZE (8 + ADDRESS_WIDTH)
+
+
+typedef enum{
+    BINARY_KIND_OBJ = 1,
+    BINARY_KIND_SL = 2,
+    BINARY_KIND_LDM = 3
+} binary_kind_t;
+
+typedef struct{
+    uint8_t *data;
+    size_t size;
+    size_t capacity;
+} binary_buffer_t;
+
+typedef bool (binary_loading_loop_t)(uint8_t *input, size_t size, void **output, char *filename);
+typedef bool (binary_writing_loop_t)(void *input, binary_buffer_t *output);
+
+binary_loading_loop_t binary_loading_loop_ldm;
+binary_loading_loop_t binary_loading_loop_obj;
+binary_loading_loop_t binary_loading_loop_sl;
+
+binary_writing_loop_t binary_writing_loop_ldm;
+binary_writing_loop_t binary_writing_loop_obj;
+binary_writing_loop_t binary_writing_loop_sl;
+// input is sl_members_t, used when library is updated
+binary_writing_loop_t binary_writing_loop_sl_members;
+
+void binary_buffer_init(binary_buffer_t **buffer);
+void binary_buffer_destroy(binary_buffer_t *buffer);
+
+bool binary_is_magic(uint8_t *input, size_t size);
+
+// validate image and fill view, view doesn't take ownership of input
+bool binary_obj_view_init(obj_view_t *view, uint8_t *input, size_t size, char *filename);
+bool binary_sl_view_init(sl_view_t *view, uint8_t *input, size_t size, char *filename);
+bool binary_sl_view_member_init(sl_view_t *view, unsigned index, obj_view_t *member);
+
+// size of library prefix holding header and all tables (not members), input
+// have to hold at least SL_HEADER_SIZE_V1 bytes, returns 0 on broken header
+size_t binary_sl_index_size(uint8_t *input, size_t size, char *filename);
+// fill index from library prefix, file_size is size of whole library
+bool binary_sl_index_init(sl_index_t *index, uint8_t *input, size_t size, size_t file_size, char *filename);
+
+static inline uintmax_t binary_get_le(uint8_t *p, size_t width){
+    uintmax_t value = 0;
+
+    for(size_t i = width; i > 0; i--){
+        value = (value << 8) | p[i - 1];
+    }
+
+    return value;
+}
+
+static inline uint32_t binary_get_u32(uint8_t *p){
+    return (uint32_t)binary_get_le(p, 4);
+}
+
+#endif
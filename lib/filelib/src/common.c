@@ -1,6 +1,7 @@
 #include "_filelib.h"
 
 error_t *filelib_error_buffer = NULL;
+static FILELIB_THREAD_LOCAL filelib_ctx_t *filelib_thread_ctx = NULL;
 
 void filelib_init(void){
     error_buffer_init(&filelib_error_buffer);
@@ -14,31 +15,155 @@ void filelib_deinit(void){
 }
 
 char *filelib_error(void){
-    return error_buffer_get(filelib_error_buffer);
+    return error_buffer_get(_filelib_current_error_buffer());
 }
 
-bool is_token(token_t *token, char *x){
-    CHECK_NULL_ARGUMENT(token);
-    CHECK_NULL_ARGUMENT(x);
+error_t *_filelib_current_error_buffer(void){
+    if(filelib_thread_ctx != NULL){
+        return filelib_thread_ctx->errors;
+    }
 
-    if(strcmp(token->token, x) == 0)
-        return true;
-    else
-        return false;
+    return filelib_error_buffer;
+}
+
+//-----------------------------------
+// Context
+
+void filelib_ctx_new(filelib_ctx_t **ctx){
+    CHECK_NULL_ARGUMENT(ctx);
+    CHECK_NOT_NULL_ARGUMENT(*ctx);
+
+    *ctx = (filelib_ctx_t *)dynmem_calloc(1, sizeof(filelib_ctx_t));
+
+    error_buffer_init(&((*ctx)->errors));
+    error_buffer_init(&((*ctx)->platform_errors));
+}
+
+void filelib_ctx_destroy(filelib_ctx_t *ctx){
+    if(ctx == NULL)
+        return;
+
+    if(filelib_thread_ctx == ctx){
+        error("Destroying filelib context which is still in use!");
+    }
+
+    for(unsigned i = 0; i < FILELIB_SCRATCH_COUNT; i++){
+        if(ctx->scratch[i].buffer != NULL){
+            dynmem_free(ctx->scratch[i].buffer);
+        }
+    }
+
+    error_buffer_destroy(ctx->errors);
+    error_buffer_destroy(ctx->platform_errors);
+    dynmem_free(ctx);
+}
+
+char *filelib_ctx_error(filelib_ctx_t *ctx){
+    CHECK_NULL_ARGUMENT(ctx);
+
+    return error_buffer_get(ctx->errors);
 }
 
-token_t *_token_load(queue_t *queue){
-    CHECK_NULL_ARGUMENT(queue);
+char *filelib_ctx_platform_error(filelib_ctx_t *ctx){
+    CHECK_NULL_ARGUMENT(ctx);
 
-    if(queue_count(queue) == 0)
-        error("Requesting widraw from empty queue!");
+    return error_buffer_get(ctx->platform_errors);
+}
+
+void filelib_ctx_enter(filelib_ctx_t *ctx){
+    CHECK_NULL_ARGUMENT(ctx);
+
+    if(filelib_thread_ctx != NULL){
+        error("Filelib context is already entered by this thread!");
+    }
 
-    token_t *tmp = NULL;
-    queue_windraw(queue, (void *)&tmp);
+    filelib_thread_ctx = ctx;
+    _platformlib_set_thread_error_buffer(ctx->platform_errors);
+}
 
-    return tmp;
+void filelib_ctx_leave(void){
+    filelib_thread_ctx = NULL;
+    _platformlib_set_thread_error_buffer(NULL);
 }
 
+filelib_scope_t _filelib_ctx_enter(filelib_ctx_t *ctx){
+    filelib_scope_t scope;
+
+    scope.entered = false;
+    scope.ctx = filelib_thread_ctx;
+    scope.platform_errors = NULL;
+
+    if(ctx != NULL){
+        scope.entered = true;
+        filelib_thread_ctx = ctx;
+        scope.platform_errors = _platformlib_set_thread_error_buffer(ctx->platform_errors);
+    }
+
+    return scope;
+}
+
+void _filelib_ctx_leave(filelib_scope_t scope){
+    if(scope.entered == false)
+        return;
+
+    filelib_thread_ctx = scope.ctx;
+    _platformlib_set_thread_error_buffer(scope.platform_errors);
+}
+
+void *_filelib_scratch_take(filelib_scratch_t kind, size_t size, size_t *capacity){
+    CHECK_NULL_ARGUMENT(capacity);
+
+    filelib_ctx_t *ctx = filelib_thread_ctx;
+
+    if(ctx != NULL && ctx->scratch[kind].buffer != NULL){
+        void *buffer = ctx->scratch[kind].buffer;
+
+        ctx->scratch[kind].buffer = NULL;
+
+        if(ctx->scratch[kind].capacity >= size){
+            *capacity = ctx->scratch[kind].capacity;
+            return buffer;
+        }
+
+        dynmem_free(buffer);
+    }
+
+    *capacity = size;
+
+    return dynmem_malloc(size);
+}
+
+void _filelib_scratch_give(filelib_scratch_t kind, void *buffer, size_t capacity){
+    CHECK_NULL_ARGUMENT(buffer);
+
+    filelib_ctx_t *ctx = filelib_thread_ctx;
+
+    if(ctx != NULL && ctx->scratch[kind].buffer == NULL){
+        ctx->scratch[kind].buffer = buffer;
+        ctx->scratch[kind].capacity = capacity;
+        return;
+    }
+
+    dynmem_free(buffer);
+}
+
+//-----------------------------------
+// Hashing
+
+uint64_t filelib_hash(uint64_t hash, const void *data, size_t size){
+    const unsigned char *bytes = (const unsigned char *)data;
+
+    for(size_t i = 0; i < size; i++){
+        hash ^= bytes[i];
+        hash *= 1099511628211ULL;
+    }
+
+    return hash;
+}
+
+//-----------------------------------
+// Loading and writing
+
 bool _load_string(string_t *input, char *filename, void **output, check_structure_t *check_structure, loading_loop_t *loading_loop){
     CHECK_NULL_ARGUMENT(filename);
     CHECK_NULL_ARGUMENT(output);
@@ -47,51 +172,228 @@ bool _load_string(string_t *input, char *filename, void **output, check_structur
     CHECK_NULL_ARGUMENT(loading_loop);
     CHECK_NULL_ARGUMENT(input);
 
-    queue_t *tokenized_string = NULL;
-    tokenizer_t *tokenizer = NULL;
+    char *data = string_get(input);
+    record_reader_t *reader = NULL;
 
-    tokenizer_init(&tokenizer);
-    tokenizer_tokenize_string(tokenizer, input);
-    tokenizer_end(tokenizer, &tokenized_string);
+    record_reader_open_memory(&reader, data, strlen(data), filename);
 
-    if(!(*loading_loop)(tokenized_string, output, filename)){
-        tokenizer_clean_output_queue(tokenized_string);
+    if(!(*loading_loop)(reader, output, filename)){
+        record_reader_close(reader);
         return false;
     }
 
-    tokenizer_clean_output_queue(tokenized_string);
+    record_reader_close(reader);
     (*check_structure)((void *)*output);
 
     return true;
 }
 
-bool _load_file(char *filename, void **output, check_structure_t *check_structure, loading_loop_t *loading_loop){
+// with capacity set, data are read into scratch buffer which has to be given back
+static bool read_stream(FILE *fp, char *filename, uint8_t **data, size_t *size, size_t *capacity){
+    long length = 0;
+
+    if(fseek(fp, 0, SEEK_END) != 0 || (length = ftell(fp)) < 0 || fseek(fp, 0, SEEK_SET) != 0){
+        FILELIB_ERROR_WRITE("Failed to read file '%s'!", filename);
+        return false;
+    }
+
+    if(capacity != NULL){
+        *data = (uint8_t *)_filelib_scratch_take(FILELIB_SCRATCH_IMAGE, (size_t)length + 1, capacity);
+    }
+    else{
+        *data = (uint8_t *)dynmem_malloc((size_t)length + 1);
+    }
+
+    if(fread(*data, 1, (size_t)length, fp) != (size_t)length){
+        FILELIB_ERROR_WRITE("Failed to read file '%s'!", filename);
+
+        if(capacity != NULL){
+            _filelib_scratch_give(FILELIB_SCRATCH_IMAGE, *data, *capacity);
+        }
+        else{
+            dynmem_free(*data);
+        }
+
+        *data = NULL;
+        return false;
+    }
+
+    *size = (size_t)length;
+
+    return true;
+}
+
+bool _read_file(char *filename, uint8_t **data, size_t *size){
+    CHECK_NULL_ARGUMENT(filename);
+    CHECK_NULL_ARGUMENT(data);
+    CHECK_NOT_NULL_ARGUMENT(*data);
+    CHECK_NULL_ARGUMENT(size);
+
+    FILE *fp = fopen(filename, "rb");
+
+    if(fp == NULL){
+        FILELIB_ERROR_WRITE("Failed to read file '%s'!", filename);
+        return false;
+    }
+
+    bool retVal = read_stream(fp, filename, data, size, NULL);
+
+    fclose(fp);
+
+    return retVal;
+}
+
+bool _read_stream(FILE *fp, char *filename, uint8_t **data, size_t *size){
+    CHECK_NULL_ARGUMENT(fp);
+    CHECK_NULL_ARGUMENT(filename);
+    CHECK_NULL_ARGUMENT(data);
+    CHECK_NOT_NULL_ARGUMENT(*data);
+    CHECK_NULL_ARGUMENT(size);
+
+    return read_stream(fp, filename, data, size, NULL);
+}
+
+bool _open_file(char *filename, FILE **fp, bool *binary){
+    CHECK_NULL_ARGUMENT(filename);
+    CHECK_NULL_ARGUMENT(fp);
+    CHECK_NOT_NULL_ARGUMENT(*fp);
+    CHECK_NULL_ARGUMENT(binary);
+
+    uint8_t magic[BINARY_MAGIC_SIZE];
+
+    *fp = fopen(filename, "rb");
+
+    if(*fp == NULL){
+        FILELIB_ERROR_WRITE("Failed to read file '%s'!", filename);
+        return false;
+    }
+
+    size_t size = fread(magic, 1, BINARY_MAGIC_SIZE, *fp);
+
+    if(fseek(*fp, 0, SEEK_SET) != 0){
+        FILELIB_ERROR_WRITE("Failed to read file '%s'!", filename);
+        fclose(*fp);
+        *fp = NULL;
+        return false;
+    }
+
+    *binary = binary_is_magic(magic, size);
+
+    return true;
+}
+
+static bool load_binary_stream(FILE *fp, char *filename, void **output, check_structure_t *check_structure, binary_loading_loop_t *binary_loading_loop){
+    uint8_t *data = NULL;
+    size_t size = 0;
+    size_t capacity = 0;
+
+    //loaded structure doesn't point into image, so image buffer can be reused
+    if(!read_stream(fp, filename, &data, &size, &capacity)){
+        return false;
+    }
+
+    bool retVal = (*binary_loading_loop)(data, size, output, filename);
+
+    _filelib_scratch_give(FILELIB_SCRATCH_IMAGE, data, capacity);
+
+    if(retVal == true){
+        (*check_structure)(*output);
+    }
+
+    return retVal;
+}
+
+bool _load_stream(FILE *fp, char *filename, bool binary, void **output, check_structure_t *check_structure, loading_loop_t *loading_loop, binary_loading_loop_t *binary_loading_loop){
+    CHECK_NULL_ARGUMENT(fp);
     CHECK_NULL_ARGUMENT(filename);
     CHECK_NULL_ARGUMENT(output);
     CHECK_NOT_NULL_ARGUMENT(*output);
     CHECK_NULL_ARGUMENT(check_structure);
     CHECK_NULL_ARGUMENT(loading_loop);
+    CHECK_NULL_ARGUMENT(binary_loading_loop);
+
+    if(binary == true){
+        bool retVal = load_binary_stream(fp, filename, output, check_structure, binary_loading_loop);
+        fclose(fp);
+        return retVal;
+    }
 
-    queue_t *tokenized_file = NULL;
-    tokenizer_t *tokenizer = NULL;
+    record_reader_t *reader = NULL;
 
-    tokenizer_init(&tokenizer);
+    record_reader_open_stream(&reader, fp, filename);
 
-    if(!tokenizer_tokenize_file(tokenizer, filename)){
-        FILELIB_ERROR_WRITE("Failed to read file '%s'!", filename);
+    if(!(*loading_loop)(reader, output, filename)){
+        //truncated read shows up as missing records, so tell the real reason
+        if(reader->error){
+            FILELIB_ERROR_WRITE("Failed to read file '%s'!", filename);
+        }
+
+        record_reader_close(reader);
         return false;
     }
 
-    tokenizer_end(tokenizer, &tokenized_file);
+    record_reader_close(reader);
+    (*check_structure)(*output);
+
+    return true;
+}
+
+bool _load_file(char *filename, void **output, check_structure_t *check_structure, loading_loop_t *loading_loop, binary_loading_loop_t *binary_loading_loop){
+    CHECK_NULL_ARGUMENT(filename);
 
-    if(!(*loading_loop)(tokenized_file, output, filename)){
-        tokenizer_clean_output_queue(tokenized_file);
+    FILE *fp = NULL;
+    bool binary = false;
+
+    //file is opened once, magic is read from the same stream which is then loaded
+    if(!_open_file(filename, &fp, &binary)){
         return false;
     }
 
-    tokenizer_clean_output_queue(tokenized_file);
-    (*check_structure)(*output);
+    return _load_stream(fp, filename, binary, output, check_structure, loading_loop, binary_loading_loop);
+}
+
+// "-" stands for standard output, so files can be written into pipe
+static FILE *open_output(char *filename){
+    if(strcmp(filename, "-") == 0){
+        return stdout;
+    }
+
+    return fopen(filename, "wb");
+}
+
+static bool close_output(FILE *fp){
+    if(fp == stdout){
+        return true;
+    }
 
+    return (fclose(fp) == 0) ? true : false;
+}
+
+bool _write_stream(FILE *fp, char *filename, void *data, check_structure_t *check_structure, writing_loop_t *writing_loop){
+    CHECK_NULL_ARGUMENT(fp);
+    CHECK_NULL_ARGUMENT(filename);
+    CHECK_NULL_ARGUMENT(data);
+    CHECK_NULL_ARGUMENT(check_structure);
+    CHECK_NULL_ARGUMENT(writing_loop);
+
+    writer_t *writer = NULL;
+
+    (*check_structure)(data);
+
+    writer_new_stream(&writer, fp);
+
+    if(!(*writing_loop)(data, writer)){
+        writer_destroy(writer);
+        return false;
+    }
+
+    if(!writer_flush(writer)){
+        FILELIB_ERROR_WRITE("Failed to write %s!", filename);
+        writer_destroy(writer);
+        return false;
+    }
+
+    writer_destroy(writer);
     return true;
 }
 
@@ -101,29 +403,56 @@ bool _write_file(char *filename, void *data, check_structure_t *check_structure,
     CHECK_NULL_ARGUMENT(check_structure);
     CHECK_NULL_ARGUMENT(writing_loop);
 
-    string_t *tmp = NULL;
+    FILE *fp = open_output(filename);
+
+    if(fp == NULL){
+        FILELIB_ERROR_WRITE("Failed to write %s!", filename);
+        return false;
+    }
+
+    bool retVal = _write_stream(fp, filename, data, check_structure, writing_loop);
+
+    if(!close_output(fp) && retVal){
+        FILELIB_ERROR_WRITE("Failed to write %s!", filename);
+        retVal = false;
+    }
+
+    return retVal;
+}
+
+bool _write_binary_file(char *filename, void *data, check_structure_t *check_structure, binary_writing_loop_t *binary_writing_loop){
+    CHECK_NULL_ARGUMENT(data);
+    CHECK_NULL_ARGUMENT(filename);
+    CHECK_NULL_ARGUMENT(check_structure);
+    CHECK_NULL_ARGUMENT(binary_writing_loop);
+
+    binary_buffer_t *tmp = NULL;
     FILE *fp = NULL;
 
-    if(!_write_string(&tmp, data, check_structure, writing_loop)){
+    binary_buffer_init(&tmp);
+
+    (*check_structure)(data);
+    if(!(*binary_writing_loop)(data, tmp)){
+        binary_buffer_destroy(tmp);
         return false;
     }
 
-    fp = fopen(filename, "wb");
+    fp = open_output(filename);
 
     if(fp == NULL){
         FILELIB_ERROR_WRITE("Failed to write %s!", filename);
-        string_destroy(tmp);
+        binary_buffer_destroy(tmp);
         return false;
     }
 
-    for(unsigned i = 0; string_at(tmp, i) != '\0'; i++){
-        fprintf(fp, "%c", string_at(tmp, i));
-    }
+    bool written = (fwrite(tmp->data, 1, tmp->size, fp) == tmp->size && fflush(fp) == 0) ? true : false;
 
-    string_destroy(tmp);
+    binary_buffer_destroy(tmp);
 
-    fflush(fp);
-    fclose(fp);
+    if(!close_output(fp) || !written){
+        FILELIB_ERROR_WRITE("Failed to write %s!", filename);
+        return false;
+    }
 
     return true;
 }
@@ -135,14 +464,24 @@ bool _write_string(string_t **output, void *data, check_structure_t *check_struc
     CHECK_NULL_ARGUMENT(check_structure);
     CHECK_NULL_ARGUMENT(writing_loop);
 
+    writer_t *writer = NULL;
+
     string_init(output);
 
     (*check_structure)(data);
-    if(!(*writing_loop)(data, *output)){
+
+    writer_new_string(&writer, *output);
+
+    if(!(*writing_loop)(data, writer)){
+        writer_destroy(writer);
         string_destroy(*output);
         *output = NULL;
         return false;
     }
+
+    writer_flush(writer);
+    writer_destroy(writer);
+
     return true;
 }
 
@@ -167,15 +506,15 @@ void _unexpected_record_error(char *token, char *filename, long line_number){
 }
 
 void _cant_decode_isa_address_error(char *filename, long line_number){
-    FILELIB_ERROR_WRITE("Can't read ISA address at %d:%ld!", filename, line_number);
+    FILELIB_ERROR_WRITE("Can't read ISA address at %s+%ld!", filename, line_number);
 }
 
 void _cant_decode_isa_word_error(char *filename, long line_number){
-    FILELIB_ERROR_WRITE("Can't read ISA word at %d:%ld!", filename, line_number);
+    FILELIB_ERROR_WRITE("Can't read ISA word at %s+%ld!", filename, line_number);
 }
 
 void _cant_decode_isa_memory_element(char *filename, long line_number){
-    FILELIB_ERROR_WRITE("Can't read ISA memory element at %d:%ld!", filename, line_number);
+    FILELIB_ERROR_WRITE("Can't read ISA memory element at %s+%ld!", filename, line_number);
 }
 
 void _wrong_architecture_error(char *filename, char *file_arch){
@@ -1,8 +1,43 @@
 #ifndef FILELIB_COMMON_H_included
 #define FILELIB_COMMON_H_included
 
+#include <utillib/core.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
 void filelib_init(void);
 void filelib_deinit(void);
 char *filelib_error(void);
 
+// Handle carrying its own error buffers and scratch buffers reused by reading
+// and writing of files. Calls made through different contexts don't share any
+// state, so every thread can load and write files through its own context at
+// the same time, but single context mustn't be used by two threads at once.
+// filelib_init has to be called before, as it sets up platformlib tables.
+//
+// Every function taking context accepts NULL too, then it works with the same
+// state as function without context (context entered by the thread or global
+// error buffer), those are only thin wrappers passing NULL.
+typedef struct filelib_ctx_s filelib_ctx_t;
+
+void filelib_ctx_new(filelib_ctx_t **ctx);
+void filelib_ctx_destroy(filelib_ctx_t *ctx);
+// errors of all calls made through context
+char *filelib_ctx_error(filelib_ctx_t *ctx);
+// errors of platformlib called through context, empty if there are none
+char *filelib_ctx_platform_error(filelib_ctx_t *ctx);
+
+// context is used by the calling thread until filelib_ctx_leave, by calls
+// without context as well as for errors of platformlib called by the thread
+void filelib_ctx_enter(filelib_ctx_t *ctx);
+void filelib_ctx_leave(void);
+
+// 64-bit FNV-1a of size bytes continuing from given hash, so data can be hashed
+// in parts or seeded; start from FILELIB_HASH_INIT. Hash tables of all tools
+// use this one, their capacity is power of two so low bits are taken directly.
+#define FILELIB_HASH_INIT 14695981039346656037ULL
+
+uint64_t filelib_hash(uint64_t hash, const void *data, size_t size);
+
 #endif
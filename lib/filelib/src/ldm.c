@@ -1,11 +1,55 @@
 #include "_filelib.h"
 
+bool ldm_load_ctx(filelib_ctx_t *ctx, char *filename, ldm_file_t **f){
+    filelib_scope_t scope = _filelib_ctx_enter(ctx);
+    bool retVal = _load_file(filename, (void **)f, &check_structure_ldm, &loading_loop_ldm, &binary_loading_loop_ldm);
+
+    _filelib_ctx_leave(scope);
+
+    return retVal;
+}
+
 bool ldm_load(char *filename, ldm_file_t **f){
-    return _load_file(filename, (void **)f, &check_structure_ldm, &loading_loop_ldm);
+    return ldm_load_ctx(NULL, filename, f);
+}
+
+bool ldm_write_ctx(filelib_ctx_t *ctx, ldm_file_t *f, char *filename){
+    filelib_scope_t scope = _filelib_ctx_enter(ctx);
+    bool retVal = _write_file(filename, (void *)f, &check_structure_ldm, &writing_loop_ldm);
+
+    _filelib_ctx_leave(scope);
+
+    return retVal;
 }
 
 bool ldm_write(ldm_file_t *f, char *filename){
-    return _write_file(filename, (void *)f, &check_structure_ldm, &writing_loop_ldm);
+    return ldm_write_ctx(NULL, f, filename);
+}
+
+bool ldm_write_stream_ctx(filelib_ctx_t *ctx, ldm_file_t *f, FILE *fp){
+    filelib_scope_t scope = _filelib_ctx_enter(ctx);
+    bool retVal = _write_stream(fp, "stream", (void *)f, &check_structure_ldm, &writing_loop_ldm);
+
+    _filelib_ctx_leave(scope);
+
+    return retVal;
+}
+
+bool ldm_write_stream(ldm_file_t *f, FILE *fp){
+    return ldm_write_stream_ctx(NULL, f, fp);
+}
+
+bool ldm_write_binary_ctx(filelib_ctx_t *ctx, ldm_file_t *f, char *filename){
+    filelib_scope_t scope = _filelib_ctx_enter(ctx);
+    bool retVal = _write_binary_file(filename, (void *)f, &check_structure_ldm, &binary_writing_loop_ldm);
+
+    _filelib_ctx_leave(scope);
+
+    return retVal;
+}
+
+bool ldm_write_binary(ldm_file_t *f, char *filename){
+    return ldm_write_binary_ctx(NULL, f, filename);
 }
 
 void ldm_file_new(ldm_file_t **f){
@@ -59,6 +103,9 @@ void ldm_mem_new(char *memory_name, ldm_memory_t **mem, isa_address_t size, isa_
     (*mem)->begin_addr = begin_addr;
     (*mem)->items = NULL;
     (*mem)->size = size;
+    (*mem)->image = NULL;
+    (*mem)->coverage = NULL;
+    (*mem)->image_count = 0;
 
     list_init(&((*mem)->items), sizeof(ldm_item_t *));
 
@@ -89,9 +136,176 @@ void ldm_mem_destroy(ldm_memory_t *mem){
         list_destroy(mem->items);
     }
 
+    if(mem->image != NULL){
+        dynmem_free(mem->image);
+        dynmem_free(mem->coverage);
+    }
+
     dynmem_free(mem);
 }
 
+static bool is_image_size(isa_address_t size){
+    //size 0 wraps around and fails the check too
+    return ((unsigned long)size - 1) < LDM_IMAGE_MAX_SIZE;
+}
+
+static bool image_offset(ldm_memory_t *mem, isa_address_t address, isa_address_t *offset){
+    if(address < mem->begin_addr){
+        return false;
+    }
+
+    if((isa_address_t)(address - mem->begin_addr) >= mem->size){
+        return false;
+    }
+
+    *offset = address - mem->begin_addr;
+    return true;
+}
+
+static void image_alloc(ldm_memory_t *mem){
+    mem->image = (isa_memory_element_t *)dynmem_calloc(mem->size, sizeof(isa_memory_element_t));
+    mem->coverage = (uint8_t *)dynmem_calloc(((unsigned long)mem->size + 7) / 8, sizeof(uint8_t));
+    mem->image_count = 0;
+}
+
+static bool image_set(ldm_memory_t *mem, isa_address_t offset, isa_memory_element_t word){
+    bool retVal = !ldm_mem_is_covered(mem, offset);
+
+    if(retVal == true){
+        mem->coverage[offset / 8] |= (uint8_t)(1u << (offset % 8));
+        mem->image_count++;
+    }
+
+    mem->image[offset] = word;
+
+    return retVal;
+}
+
+// move content of image into items, used when image can't hold written element
+static void image_to_items(ldm_memory_t *mem){
+    for(unsigned long i = 0; i < (unsigned long)mem->size; i++){
+        if(ldm_mem_is_covered(mem, (isa_address_t)i)){
+            ldm_item_t *item = NULL;
+            ldm_item_new((isa_address_t)(mem->begin_addr + i), mem->image[i], &item);
+            list_append(mem->items, (void *)&item);
+        }
+    }
+
+    dynmem_free(mem->image);
+    dynmem_free(mem->coverage);
+    mem->image = NULL;
+    mem->coverage = NULL;
+    mem->image_count = 0;
+}
+
+void ldm_mem_new_image(char *memory_name, ldm_memory_t **mem, isa_address_t size, isa_address_t begin_addr){
+    ldm_mem_new(memory_name, mem, size, begin_addr);
+
+    if(is_image_size(size)){
+        image_alloc(*mem);
+    }
+}
+
+bool ldm_mem_set(ldm_memory_t *mem, isa_address_t address, isa_memory_element_t word){
+    CHECK_NULL_ARGUMENT(mem);
+
+    isa_address_t offset = 0;
+
+    if(mem->image != NULL){
+        if(image_offset(mem, address, &offset)){
+            return image_set(mem, offset, word);
+        }
+
+        image_to_items(mem);
+    }
+
+    ldm_item_t *item = NULL;
+    ldm_item_new(address, word, &item);
+    list_append(mem->items, (void *)&item);
+
+    return true;
+}
+
+bool ldm_mem_convert_to_image(ldm_memory_t *mem){
+    CHECK_NULL_ARGUMENT(mem);
+
+    if(mem->image != NULL){
+        return true;
+    }
+
+    if(!is_image_size(mem->size)){
+        return list_count(mem->items) == 0;
+    }
+
+    isa_address_t offset = 0;
+
+    for(unsigned i = 0; i < list_count(mem->items); i++){
+        ldm_item_t *item = NULL;
+        list_at(mem->items, i, (void *)&item);
+
+        if(!image_offset(mem, item->address, &offset)){
+            return false;
+        }
+    }
+
+    image_alloc(mem);
+
+    //later items overwrite earlier ones with the same address, same as when they are read in order
+    for(unsigned i = 0; i < list_count(mem->items); i++){
+        ldm_item_t *item = NULL;
+        list_at(mem->items, i, (void *)&item);
+
+        image_offset(mem, item->address, &offset);
+        image_set(mem, offset, item->word);
+    }
+
+    while(list_count(mem->items) > 0){
+        ldm_item_t *item = NULL;
+        list_windraw(mem->items, (void *)&item);
+        ldm_item_destroy(item);
+    }
+
+    return true;
+}
+
+unsigned ldm_mem_count(ldm_memory_t *mem){
+    CHECK_NULL_ARGUMENT(mem);
+
+    if(mem->image != NULL){
+        return mem->image_count;
+    }
+
+    return list_count(mem->items);
+}
+
+void ldm_mem_foreach(ldm_memory_t *mem, ldm_element_callback_t *callback, void *context){
+    CHECK_NULL_ARGUMENT(mem);
+    CHECK_NULL_ARGUMENT(callback);
+
+    if(mem->image != NULL){
+        for(unsigned long i = 0; i < (unsigned long)mem->size; i += 8){
+            //skip whole bytes of bitmap with nothing written
+            if(mem->coverage[i / 8] == 0){
+                continue;
+            }
+
+            for(unsigned long j = i; (j < i + 8) && (j < (unsigned long)mem->size); j++){
+                if(ldm_mem_is_covered(mem, (isa_address_t)j)){
+                    callback((isa_address_t)(mem->begin_addr + j), mem->image[j], context);
+                }
+            }
+        }
+    }
+    else{
+        for(unsigned i = 0; i < list_count(mem->items); i++){
+            ldm_item_t *item = NULL;
+            list_at(mem->items, i, (void *)&item);
+
+            callback(item->address, item->word, context);
+        }
+    }
+}
+
 void ldm_item_new(isa_address_t address, isa_memory_element_t word, ldm_item_t **item){
     CHECK_NULL_ARGUMENT(item);
     CHECK_NOT_NULL_ARGUMENT(*item);
@@ -108,6 +322,13 @@ void ldm_item_into_mem(ldm_memory_t *mem, ldm_item_t *item){
     CHECK_NULL_ARGUMENT(mem);
     CHECK_NULL_ARGUMENT(item);
 
+    //memory takes ownership of item, in image mode only its value is kept
+    if(mem->image != NULL){
+        ldm_mem_set(mem, item->address, item->word);
+        ldm_item_destroy(item);
+        return;
+    }
+
     list_append(mem->items, (void *)&item);
 }
 
@@ -1,7 +1,11 @@
 #ifndef FILELIB_LDM_H_included
 #define FILELIB_LDM_H_included
 
+#include "common.h"
+
 #include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
 
 #include <platformlib.h>
 #include <utillib/core.h>
@@ -11,13 +15,26 @@ typedef struct{
     isa_memory_element_t word;
 } ldm_item_t;
 
+// Memories up to this number of elements are kept as dense image.
+#define LDM_IMAGE_MAX_SIZE (16UL * 1024UL * 1024UL)
+
+// Memory holds its content either as list of items or as dense image of size
+// elements with coverage bitmap (bit per element, set when element is
+// written). Image is used when image != NULL, items list is empty then.
+// Memory in image mode falls back to items when element outside of memory
+// range is written.
 typedef struct{
     char *memory_name;
     isa_address_t begin_addr;
     isa_address_t size;
     list_t *items;
+    isa_memory_element_t *image;
+    uint8_t *coverage;
+    unsigned image_count;
 } ldm_memory_t;
 
+typedef void (ldm_element_callback_t)(isa_address_t address, isa_memory_element_t word, void *context);
+
 typedef struct{
     char *target_arch_name;
     isa_address_t entry_point;
@@ -26,6 +43,13 @@ typedef struct{
 
 bool ldm_load(char *filename, ldm_file_t **f);
 bool ldm_write(ldm_file_t *f, char *filename);
+bool ldm_write_stream(ldm_file_t *f, FILE *fp);
+bool ldm_write_binary(ldm_file_t *f, char *filename);
+
+bool ldm_load_ctx(filelib_ctx_t *ctx, char *filename, ldm_file_t **f);
+bool ldm_write_ctx(filelib_ctx_t *ctx, ldm_file_t *f, char *filename);
+bool ldm_write_stream_ctx(filelib_ctx_t *ctx, ldm_file_t *f, FILE *fp);
+bool ldm_write_binary_ctx(filelib_ctx_t *ctx, ldm_file_t *f, char *filename);
 
 void ldm_file_new(ldm_file_t **f);
 void ldm_file_destroy(ldm_file_t *f);
@@ -35,6 +59,21 @@ void ldm_mem_new(char *memory_name, ldm_memory_t **mem, isa_address_t size, isa_
 void ldm_mem_into_file(ldm_file_t *f, ldm_memory_t *mem);
 void ldm_mem_destroy(ldm_memory_t *mem);
 
+// same as ldm_mem_new, but memory starts in image mode when size allows it
+void ldm_mem_new_image(char *memory_name, ldm_memory_t **mem, isa_address_t size, isa_address_t begin_addr);
+// false when element at address was already written, it is overwritten anyway;
+// only memory in image mode can tell it, items are always appended
+bool ldm_mem_set(ldm_memory_t *mem, isa_address_t address, isa_memory_element_t word);
+// fails when some item lies outside of memory range or memory is too large
+bool ldm_mem_convert_to_image(ldm_memory_t *mem);
+unsigned ldm_mem_count(ldm_memory_t *mem);
+// items are visited in insertion order, image elements in order of addresses
+void ldm_mem_foreach(ldm_memory_t *mem, ldm_element_callback_t *callback, void *context);
+
+static inline bool ldm_mem_is_covered(ldm_memory_t *mem, isa_address_t offset){
+    return (mem->coverage[offset / 8] & (1u << (offset % 8))) != 0;
+}
+
 void ldm_item_new(isa_address_t address, isa_memory_element_t word, ldm_item_t **item);
 void ldm_item_into_mem(ldm_memory_t *mem, ldm_item_t *item);
 void ldm_item_destroy(ldm_item_t *item);
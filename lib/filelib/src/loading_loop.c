@@ -1,6 +1,25 @@
 #include "_filelib.h"
 
-bool loading_loop_ldm(queue_t *input, void **output, char *filename){
+static bool parse_count(const char *s, unsigned length, unsigned *count){
+    unsigned long value = 0;
+
+    if(length == 0 || length > 9){
+        return false;
+    }
+
+    for(unsigned i = 0; i < length; i++){
+        if(s[i] < '0' || s[i] > '9'){
+            return false;
+        }
+
+        value = value * 10 + (unsigned long)(s[i] - '0');
+    }
+
+    *count = (unsigned)value;
+    return true;
+}
+
+bool loading_loop_ldm(record_reader_t *input, void **output, char *filename){
     CHECK_NULL_ARGUMENT(filename);
     CHECK_NULL_ARGUMENT(output);
     CHECK_NULL_ARGUMENT(input);
@@ -14,85 +33,76 @@ bool loading_loop_ldm(queue_t *input, void **output, char *filename){
     bool check_entry = false;
     bool check_arch = false;
     bool check_end = false;
-    token_t *head = NULL;
+    record_t *head = &input->record;
+    char *_filename = input->filename;
 
-    while(queue_count(input) > 0){
-        head = _token_load(input);
-
-        if(is_token(head, ".ldm")){
+    while(record_reader_next(input)){
+        if(is_record(head, ".ldm")){
             if(check_ldm == true){
-                _multiple_record_error(".ldm", head->filename, head->line_number);
+                _multiple_record_error(".ldm", _filename, head->line_number);
                 break;
             }
 
             ldm_file_new(&ldm_file);
             check_ldm = true;
         }
-        else if(is_token(head, ".arch")){
+        else if(is_record(head, ".arch")){
             if(check_arch == true){
-                _multiple_record_error(".arch", head->filename, head->line_number);
+                _multiple_record_error(".arch", _filename, head->line_number);
                 break;
             }
 
-            if(queue_count(input) < 1){
-                _not_enough_tokens_error(".arch", head->filename, head->line_number);
+            if(head->count < 2){
+                _not_enough_tokens_error(".arch", _filename, head->line_number);
                 break;
             }
 
             if(check_ldm == false){
-                _wrong_records_order_error(".arch", ".ldm", head->filename, head->line_number);
+                _wrong_records_order_error(".arch", ".ldm", _filename, head->line_number);
                 break;
             }
 
-            token_t *arg = _token_load(input);
-
-            if(strcmp(arg->token, ldm_file->target_arch_name) != 0){
-                _wrong_architecture_error(arg->filename, arg->token);
-                tokenizer_token_destroy(arg);
+            if(strcmp(head->fields[1], ldm_file->target_arch_name) != 0){
+                _wrong_architecture_error(_filename, head->fields[1]);
                 break;
             }
 
-            tokenizer_token_destroy(arg);
             check_arch = true;
         }
-        else if(is_token(head, ".entry")){
+        else if(is_record(head, ".entry")){
             if(check_entry == true){
-                _multiple_record_error(".entry", head->filename, head->line_number);
+                _multiple_record_error(".entry", _filename, head->line_number);
                 break;
             }
 
-            if(queue_count(input) < 1){
-                _not_enough_tokens_error(".entry", head->filename, head->line_number);
+            if(head->count < 2){
+                _not_enough_tokens_error(".entry", _filename, head->line_number);
                 break;
             }
 
             if(check_arch == false){
-                _wrong_records_order_error(".entry", ".arch", head->filename, head->line_number);
+                _wrong_records_order_error(".entry", ".arch", _filename, head->line_number);
                 break;
             }
 
-            token_t *arg = _token_load(input);
             isa_address_t entry_point = 0;
 
-            if(!platformlib_read_isa_address(arg->token, &entry_point)){
-                FILELIB_ERROR_WRITE("Can't decode entry point at %s+%ld!", head->filename, head->line_number);
-                tokenizer_token_destroy(arg);
+            if(!platformlib_parse_isa_address(head->fields[1], head->lengths[1], &entry_point)){
+                FILELIB_ERROR_WRITE("Can't decode entry point at %s+%ld!", _filename, head->line_number);
                 break;
             }
 
             ldm_file_set_entry(ldm_file, entry_point);
-            tokenizer_token_destroy(arg);
-
             check_entry = true;
         }
-        else if(is_token(head, ".mem")){
-            if(queue_count(input) < 3){
-                _not_enough_tokens_error(".mem", head->filename, head->line_number);
+        else if(is_record(head, ".mem")){
+            if(head->count < 4){
+                _not_enough_tokens_error(".mem", _filename, head->line_number);
                 break;
             }
 
             if(check_entry == false){
-                _wrong_records_order_error(".mem", ".entry", head->filename, head->line_number);
+                _wrong_records_order_error(".mem", ".entry", _filename, head->line_number);
                 break;
             }
 
@@ -101,74 +111,90 @@ bool loading_loop_ldm(queue_t *input, void **output, char *filename){
                 open_mem = NULL;
             }
 
-            token_t *arg_1 = _token_load(input);
-            token_t *arg_2 = _token_load(input);
-            token_t *arg_3 = _token_load(input);
-
             isa_address_t memory_origin;
             isa_address_t memory_size;
 
-            if(!platformlib_read_isa_address(arg_2->token, &memory_origin)){
-                _cant_decode_isa_address_error(head->filename, arg_2->line_number);
-                tokenizer_token_destroy(arg_1);
-                tokenizer_token_destroy(arg_2);
-                tokenizer_token_destroy(arg_3);
+            if(!platformlib_parse_isa_address(head->fields[2], head->lengths[2], &memory_origin)){
+                _cant_decode_isa_address_error(_filename, head->line_number);
                 break;
             }
 
-            if(!platformlib_read_isa_address(arg_3->token, &memory_size)){
-                _cant_decode_isa_address_error(head->filename, arg_3->line_number);
-                tokenizer_token_destroy(arg_1);
-                tokenizer_token_destroy(arg_2);
-                tokenizer_token_destroy(arg_3);
+            if(!platformlib_parse_isa_address(head->fields[3], head->lengths[3], &memory_size)){
+                _cant_decode_isa_address_error(_filename, head->line_number);
                 break;
             }
 
-            ldm_mem_new(arg_1->token, &open_mem, memory_size, memory_origin);
-
-            tokenizer_token_destroy(arg_1);
-            tokenizer_token_destroy(arg_2);
-            tokenizer_token_destroy(arg_3);
+            ldm_mem_new_image(head->fields[1], &open_mem, memory_size, memory_origin);
         }
-        else if(is_token(head, ".item")){
-            if(queue_count(input) < 2){
-                _not_enough_tokens_error(".item", head->filename, head->line_number);
+        else if(is_record(head, ".item")){
+            if(head->count < 3){
+                _not_enough_tokens_error(".item", _filename, head->line_number);
                 break;
             }
 
             if(open_mem == NULL){
-                FILELIB_ERROR_WRITE("Found .item record but no memory open at %s+%ld!", head->filename, head->line_number);
+                FILELIB_ERROR_WRITE("Found .item record but no memory open at %s+%ld!", _filename, head->line_number);
                 break;
             }
 
-            token_t *arg_1 = _token_load(input);
-            token_t *arg_2 = _token_load(input);
-
             isa_address_t address = 0;
             isa_memory_element_t word = 0;
-            ldm_item_t *tmp_item = NULL;
 
-            if(!platformlib_read_isa_address(arg_1->token, &address)){
-                _cant_decode_isa_address_error(head->filename, arg_1->line_number);
-                tokenizer_token_destroy(arg_1);
-                tokenizer_token_destroy(arg_2);
+            if(!platformlib_parse_isa_address(head->fields[1], head->lengths[1], &address)){
+                _cant_decode_isa_address_error(_filename, head->line_number);
                 break;
             }
 
-            if(!platformlib_read_isa_memory_element(arg_2->token, &word)){
-                _cant_decode_isa_word_error(head->filename, arg_2->line_number);
-                tokenizer_token_destroy(arg_1);
-                tokenizer_token_destroy(arg_2);
+            if(!platformlib_parse_isa_memory_element(head->fields[2], head->lengths[2], &word)){
+                _cant_decode_isa_word_error(_filename, head->line_number);
                 break;
             }
 
-            ldm_item_new(address, word, &tmp_item);
-            ldm_item_into_mem(open_mem, tmp_item);
+            ldm_mem_set(open_mem, address, word);
+        }
+        else if(is_record(head, ".run")){
+            if(head->count < 4){
+                _not_enough_tokens_error(".run", _filename, head->line_number);
+                break;
+            }
+
+            if(open_mem == NULL){
+                FILELIB_ERROR_WRITE("Found .run record but no memory open at %s+%ld!", _filename, head->line_number);
+                break;
+            }
 
-            tokenizer_token_destroy(arg_1);
-            tokenizer_token_destroy(arg_2);
+            isa_address_t address = 0;
+            unsigned count = 0;
+
+            if(!platformlib_parse_isa_address(head->fields[1], head->lengths[1], &address)){
+                _cant_decode_isa_address_error(_filename, head->line_number);
+                break;
+            }
+
+            if(!parse_count(head->fields[2], head->lengths[2], &count) || count != head->count - 3){
+                FILELIB_ERROR_WRITE("Wrong count of elements in .run record at %s+%ld!", _filename, head->line_number);
+                break;
+            }
+
+            bool decoded = true;
+
+            for(unsigned i = 0; i < count; i++){
+                isa_memory_element_t word = 0;
+
+                if(!platformlib_parse_isa_memory_element(head->fields[3 + i], head->lengths[3 + i], &word)){
+                    _cant_decode_isa_memory_element(_filename, head->line_number);
+                    decoded = false;
+                    break;
+                }
+
+                ldm_mem_set(open_mem, (isa_address_t)(address + i), word);
+            }
+
+            if(decoded == false){
+                break;
+            }
         }
-        else if(is_token(head, ".end")){
+        else if(is_record(head, ".end")){
             if(open_mem != NULL){
                 ldm_mem_into_file(ldm_file, open_mem);
                 open_mem = NULL;
@@ -179,12 +205,9 @@ bool loading_loop_ldm(queue_t *input, void **output, char *filename){
             break;
         }
         else{
-            _unrecognized_record_error(head->filename, head->line_number);
+            _unrecognized_record_error(_filename, head->line_number);
             break;
         }
-
-        tokenizer_token_destroy(head);
-        head = NULL;
     }
 
     if(open_mem != NULL){
@@ -193,10 +216,6 @@ bool loading_loop_ldm(queue_t *input, void **output, char *filename){
         retVal = false;
     }
 
-    if(head != NULL){
-        tokenizer_token_destroy(head);
-    }
-
     if(!check_ldm){
         _missing_record_error(".ldm", filename);
         retVal = false;
@@ -219,13 +238,13 @@ bool loading_loop_ldm(queue_t *input, void **output, char *filename){
     }
     else{
         *output = NULL;
-        ldm_file_destroy(ldm_file);
+        if(ldm_file != NULL) ldm_file_destroy(ldm_file);
     }
 
     return retVal;
 }
 
-bool loading_loop_obj(queue_t *input, void **output, char *filename){
+bool loading_loop_obj(record_reader_t *input, void **output, char *filename){
     CHECK_NULL_ARGUMENT(filename);
     CHECK_NULL_ARGUMENT(output);
     CHECK_NULL_ARGUMENT(input);
@@ -238,58 +257,52 @@ bool loading_loop_obj(queue_t *input, void **output, char *filename){
     bool check_object = false;
     bool check_arch = false;
     bool check_end = false;
-    token_t *head = NULL;
+    record_t *head = &input->record;
 
-    while(queue_count(input) > 0){
-        head = _token_load(input);
+    //object files loaded from static libraries are reported with line in library
+    char *_filename = input->filename;
 
-        //object files can be loaded from static libraries and don't have filename set
-        char *_filename = (strcmp(head->filename, "") == 0) ? filename : head->filename;
-
-        if(is_token(head, ".object")){
+    while(record_reader_next(input)){
+        if(is_record(head, ".object")){
             if(check_object == true){
-                _multiple_record_error(head->token, _filename, head->line_number);
+                _multiple_record_error(head->fields[0], _filename, head->line_number);
                 break;
             }
 
             obj_file_new(&obj_file);
             check_object = true;
         }
-        else if(is_token(head, ".arch")){
+        else if(is_record(head, ".arch")){
             if(check_arch == true){
-                _multiple_record_error(head->token, _filename, head->line_number);
+                _multiple_record_error(head->fields[0], _filename, head->line_number);
                 break;
             }
 
-            if(queue_count(input) < 1){
-                _not_enough_tokens_error(head->token, _filename, head->line_number);
+            if(head->count < 2){
+                _not_enough_tokens_error(head->fields[0], _filename, head->line_number);
                 break;
             }
 
             if(check_object == false){
-                _wrong_records_order_error(head->token, ".object", _filename, head->line_number);
+                _wrong_records_order_error(head->fields[0], ".object", _filename, head->line_number);
                 break;
             }
 
-            token_t *arg = _token_load(input);
-
-            if(strcmp(arg->token, obj_file->target_arch_name) != 0){
-                _wrong_architecture_error(arg->filename, arg->token);
-                tokenizer_token_destroy(arg);
+            if(strcmp(head->fields[1], obj_file->target_arch_name) != 0){
+                _wrong_architecture_error(_filename, head->fields[1]);
                 break;
             }
 
-            tokenizer_token_destroy(arg);
             check_arch = true;
         }
-        else if(is_token(head, ".section")){
-            if(queue_count(input) < 1){
-                _not_enough_tokens_error(head->token, _filename, head->line_number);
+        else if(is_record(head, ".section")){
+            if(head->count < 2){
+                _not_enough_tokens_error(head->fields[0], _filename, head->line_number);
                 break;
             }
 
             if(check_arch == false){
-                _wrong_records_order_error(head->token, ".arch", _filename, head->line_number);
+                _wrong_records_order_error(head->fields[0], ".arch", _filename, head->line_number);
                 break;
             }
 
@@ -298,64 +311,47 @@ bool loading_loop_obj(queue_t *input, void **output, char *filename){
                 open_section = NULL;
             }
 
-            token_t *arg = _token_load(input);
-
-            obj_section_new(arg->token, &open_section);
-
-            tokenizer_token_destroy(arg);
+            obj_section_new(head->fields[1], &open_section);
         }
-        else if(is_token(head, ".export") || is_token(head, ".import")){
+        else if(is_record(head, ".export") || is_record(head, ".import")){
             if(open_section == NULL){
-                _wrong_records_order_error(head->token, ".section", _filename, head->line_number);
+                _wrong_records_order_error(head->fields[0], ".section", _filename, head->line_number);
                 break;
             }
 
-            if(queue_count(input) < 2){
-                _not_enough_tokens_error(head->token, _filename, head->line_number);
+            if(head->count < 3){
+                _not_enough_tokens_error(head->fields[0], _filename, head->line_number);
                 break;
             }
 
-            token_t *arg_1 = _token_load(input);
-            token_t *arg_2 = _token_load(input);
-
             isa_address_t value = 0;
             obj_symbol_t *new_symbol = NULL;
 
-            if(!platformlib_read_isa_address(arg_2->token, &value)){
-                _cant_decode_isa_address_error(head->filename, arg_2->line_number);
-                tokenizer_token_destroy(arg_1);
-                tokenizer_token_destroy(arg_2);
+            if(!platformlib_parse_isa_address(head->fields[2], head->lengths[2], &value)){
+                _cant_decode_isa_address_error(_filename, head->line_number);
+                break;
             }
 
-            obj_symbol_new(&new_symbol, arg_1->token, value);
+            obj_symbol_new(&new_symbol, head->fields[1], value);
 
-            if(is_token(head, ".export")){
+            if(is_record(head, ".export")){
                 obj_exported_symbol_into_section(open_section, new_symbol);
             }
             else{
                 obj_imported_symbol_into_section(open_section, new_symbol);
             }
-
-            tokenizer_token_destroy(arg_1);
-            tokenizer_token_destroy(arg_2);
         }
-        else if(is_token(head, ".data")){
+        else if(is_record(head, ".data")){
             if(open_section == NULL){
-                _wrong_records_order_error(head->token, ".section", _filename, head->line_number);
+                _wrong_records_order_error(head->fields[0], ".section", _filename, head->line_number);
                 break;
             }
 
-            if(queue_count(input) < 4){
-                _not_enough_tokens_error(head->token, _filename, head->line_number);
+            if(head->count < 6){
+                _not_enough_tokens_error(head->fields[0], _filename, head->line_number);
                 break;
             }
 
-            token_t *arg_1 = _token_load(input);
-            token_t *arg_2 = _token_load(input);
-            token_t *arg_3 = _token_load(input);
-            token_t *arg_4 = _token_load(input);
-            token_t *arg_5 = _token_load(input);
-
             isa_address_t address = 0;
             isa_instruction_word_t value = 0;
             obj_data_t *tmp = NULL;
@@ -364,82 +360,56 @@ bool loading_loop_obj(queue_t *input, void **output, char *filename){
             bool relocation = false;
             bool special = false;
 
-            if(!platformlib_read_isa_address(arg_1->token, &address)){
-                _cant_decode_isa_address_error(head->filename, arg_1->line_number);
-                tokenizer_token_destroy(arg_1);
-                tokenizer_token_destroy(arg_2);
-                tokenizer_token_destroy(arg_3);
-                tokenizer_token_destroy(arg_4);
-                tokenizer_token_destroy(arg_5);
+            if(!platformlib_parse_isa_address(head->fields[1], head->lengths[1], &address)){
+                _cant_decode_isa_address_error(_filename, head->line_number);
+                break;
             }
 
-            if(!platformlib_read_isa_instruction_word(arg_2->token, &value)){
-                _cant_decode_isa_word_error(head->filename, arg_2->line_number);
-                tokenizer_token_destroy(arg_1);
-                tokenizer_token_destroy(arg_2);
-                tokenizer_token_destroy(arg_3);
-                tokenizer_token_destroy(arg_4);
-                tokenizer_token_destroy(arg_5);
+            if(!platformlib_parse_isa_instruction_word(head->fields[2], head->lengths[2], &value)){
+                _cant_decode_isa_word_error(_filename, head->line_number);
+                break;
             }
 
-            if(!platformlib_read_isa_address(arg_3->token, &special_value)){
-                _cant_decode_isa_word_error(head->filename, arg_2->line_number);
-                tokenizer_token_destroy(arg_1);
-                tokenizer_token_destroy(arg_2);
-                tokenizer_token_destroy(arg_3);
-                tokenizer_token_destroy(arg_4);
-                tokenizer_token_destroy(arg_5);
+            if(!platformlib_parse_isa_address(head->fields[3], head->lengths[3], &special_value)){
+                _cant_decode_isa_address_error(_filename, head->line_number);
+                break;
             }
 
-            relocation = (strcmp(arg_4->token, "1") == 0) ? true : false;
-            special = (strcmp(arg_5->token, "1") == 0) ? true : false;
+            relocation = (strcmp(head->fields[4], "1") == 0) ? true : false;
+            special = (strcmp(head->fields[5], "1") == 0) ? true : false;
 
             obj_data_new(&tmp, address, value, relocation, special, special_value);
             obj_data_into_section(open_section, tmp);
-
-            tokenizer_token_destroy(arg_1);
-            tokenizer_token_destroy(arg_2);
-            tokenizer_token_destroy(arg_3);
-            tokenizer_token_destroy(arg_4);
-            tokenizer_token_destroy(arg_5);
         }
-        else if(is_token(head, ".blob")){
+        else if(is_record(head, ".blob")){
             if(open_section == NULL){
-                _wrong_records_order_error(head->token, ".section", _filename, head->line_number);
+                _wrong_records_order_error(head->fields[0], ".section", _filename, head->line_number);
                 break;
             }
 
-            if(queue_count(input) < 2){
-                _not_enough_tokens_error(head->token, _filename, head->line_number);
+            if(head->count < 3){
+                _not_enough_tokens_error(head->fields[0], _filename, head->line_number);
                 break;
             }
 
-            token_t *arg_1 = _token_load(input);
-            token_t *arg_2 = _token_load(input);
-
             isa_address_t address = 0;
             isa_memory_element_t value = 0;
             obj_data_t *tmp = NULL;
 
-            if(!platformlib_read_isa_address(arg_1->token, &address)){
-                _cant_decode_isa_address_error(head->filename, arg_1->line_number);
-                tokenizer_token_destroy(arg_1);
-                tokenizer_token_destroy(arg_2);
+            if(!platformlib_parse_isa_address(head->fields[1], head->lengths[1], &address)){
+                _cant_decode_isa_address_error(_filename, head->line_number);
+                break;
             }
 
-            if(!platformlib_read_isa_memory_element(arg_2->token, &value)){
-                _cant_decode_isa_memory_element(head->filename, arg_2->line_number);
-                tokenizer_token_destroy(arg_1);
-                tokenizer_token_destroy(arg_2);
+            if(!platformlib_parse_isa_memory_element(head->fields[2], head->lengths[2], &value)){
+                _cant_decode_isa_memory_element(_filename, head->line_number);
+                break;
             }
 
             obj_blob_new(&tmp, address, value);
             obj_data_into_section(open_section, tmp);
-
-            tokenizer_token_destroy(arg_1);
-            tokenizer_token_destroy(arg_2);
         }
-        else if(is_token(head, ".end")){
+        else if(is_record(head, ".end")){
             if(open_section != NULL){
                 obj_section_into_file(obj_file, open_section);
                 open_section = NULL;
@@ -453,9 +423,6 @@ bool loading_loop_obj(queue_t *input, void **output, char *filename){
             _unrecognized_record_error(_filename, head->line_number);
             break;
         }
-
-        tokenizer_token_destroy(head);
-        head = NULL;
     }
 
     if(open_section != NULL){
@@ -464,12 +431,8 @@ bool loading_loop_obj(queue_t *input, void **output, char *filename){
         retVal = false;
     }
 
-    if(head != NULL){
-        tokenizer_token_destroy(head);
-    }
-
     if(!check_object){
-        _missing_record_error(".ldm", filename);
+        _missing_record_error(".object", filename);
         retVal = false;
     }
     if(!check_arch){
@@ -492,7 +455,7 @@ bool loading_loop_obj(queue_t *input, void **output, char *filename){
     return retVal;
 }
 
-bool loading_loop_sl(queue_t *input, void **output, char *filename){
+bool loading_loop_sl(record_reader_t *input, void **output, char *filename){
     CHECK_NULL_ARGUMENT(filename);
     CHECK_NULL_ARGUMENT(output);
     CHECK_NULL_ARGUMENT(input);
@@ -505,77 +468,85 @@ bool loading_loop_sl(queue_t *input, void **output, char *filename){
     bool check_arch = false;
     bool check_file = false;
     bool check_end = false;
-    token_t *head = NULL;
-
-    while(queue_count(input) > 0){
-        head = _token_load(input);
+    record_t *head = &input->record;
+    char *_filename = input->filename;
 
-        if(is_token(head, ".sl")){
+    while(record_reader_next(input)){
+        if(is_record(head, ".sl")){
             if(check_sl == true){
-                _multiple_record_error(head->token, head->filename, head->line_number);
+                _multiple_record_error(head->fields[0], _filename, head->line_number);
                 break;
             }
 
             sl_file_new(&sl_file);
             check_sl = true;
         }
-        else if(is_token(head, ".arch")){
+        else if(is_record(head, ".arch")){
             if(check_arch == true){
-                _multiple_record_error(head->filename, head->filename, head->line_number);
+                _multiple_record_error(head->fields[0], _filename, head->line_number);
                 break;
             }
 
-            if(queue_count(input) < 1){
-                _not_enough_tokens_error(head->filename, head->filename, head->line_number);
+            if(head->count < 2){
+                _not_enough_tokens_error(head->fields[0], _filename, head->line_number);
                 break;
             }
 
             if(check_sl == false){
-                _wrong_records_order_error(head->filename, ".sl", head->filename, head->line_number);
+                _wrong_records_order_error(head->fields[0], ".sl", _filename, head->line_number);
                 break;
             }
 
-            token_t *arg = _token_load(input);
-
-            if(strcmp(arg->token, sl_file->target_arch_name) != 0){
-                _wrong_architecture_error(arg->filename, arg->token);
-                tokenizer_token_destroy(arg);
+            if(strcmp(head->fields[1], sl_file->target_arch_name) != 0){
+                _wrong_architecture_error(_filename, head->fields[1]);
                 break;
             }
 
-            tokenizer_token_destroy(arg);
             check_arch = true;
         }
-        else if(is_token(head, ".file")){
-            if(queue_count(input) < 1){
-                _not_enough_tokens_error(head->filename, head->filename, head->line_number);
+        else if(is_record(head, ".file")){
+            if(head->count < 2){
+                _not_enough_tokens_error(head->fields[0], _filename, head->line_number);
                 break;
             }
 
             if(check_arch == false){
-                _wrong_records_order_error(head->filename, ".arch", head->filename, head->line_number);
+                _wrong_records_order_error(head->fields[0], ".arch", _filename, head->line_number);
+                break;
             }
 
-            token_t *arg = _token_load(input);
+            //object is read from the same reader, so name have to be copied out of its buffer
+            char *object_name = dynmem_strdup(head->fields[1]);
             obj_file_t *obj_file = NULL;
 
             if(!loading_loop_obj(input, (void **)&obj_file, filename)){
                 FILELIB_ERROR_WRITE("Error parsing file %s!", filename);
-                tokenizer_token_destroy(arg);
-                retVal = false;
+                dynmem_free(object_name);
                 break;
             }
 
             sl_holder_t *holder = NULL;
-            sl_holder_new(&holder, arg->token, obj_file);
+            sl_holder_new(&holder, object_name, obj_file);
             sl_holder_into_file(sl_file, holder);
 
-            tokenizer_token_destroy(arg);
+            dynmem_free(object_name);
             check_file = true;
         }
-        else if(is_token(head, ".end")){
+        else if(is_record(head, ".member") || is_record(head, ".symbol")){
+            //index is used only when library is loaded by sl_load_index
+            if(check_arch == false){
+                _wrong_records_order_error(head->fields[0], ".arch", _filename, head->line_number);
+                break;
+            }
+
+            if(check_file == true){
+                _unexpected_record_error(head->fields[0], _filename, head->line_number);
+                break;
+            }
+        }
+        else if(is_record(head, ".end")){
             if(check_file == false){
-                _wrong_records_order_error(head->filename, ".file", head->filename, head->line_number);
+                _wrong_records_order_error(head->fields[0], ".file", _filename, head->line_number);
             }
 
             retVal = true;
@@ -583,15 +554,9 @@ bool loading_loop_sl(queue_t *input, void **output, char *filename){
             break;
         }
         else{
-            _unrecognized_record_error(head->filename, head->line_number);
+            _unrecognized_record_error(_filename, head->line_number);
             break;
         }
-
-        tokenizer_token_destroy(head);
-    }
-
-    if(head != NULL){
-        tokenizer_token_destroy(head);
     }
 
     if(!check_sl){
@@ -616,8 +581,159 @@ bool loading_loop_sl(queue_t *input, void **output, char *filename){
     }
     else{
         *output = NULL;
-        sl_file_destroy(sl_file);
+        if(sl_file != NULL) sl_file_destroy(sl_file);
+    }
+
+    return retVal;
+}
+
+bool loading_loop_sl_index(record_reader_t *input, void **output, char *filename, bool *missing){
+    CHECK_NULL_ARGUMENT(filename);
+    CHECK_NULL_ARGUMENT(output);
+    CHECK_NULL_ARGUMENT(input);
+    CHECK_NOT_NULL_ARGUMENT(*output);
+
+    sl_index_t *index = NULL;
+
+    bool retVal = false;
+    bool check_sl = false;
+    bool check_arch = false;
+    record_t *head = &input->record;
+    char *_filename = input->filename;
+
+    //only the index in front of members is read
+    while(record_reader_next(input)){
+        if(is_record(head, ".sl")){
+            if(check_sl == true){
+                _multiple_record_error(head->fields[0], _filename, head->line_number);
+                break;
+            }
+
+            _sl_index_new(&index, filename);
+            check_sl = true;
+        }
+        else if(is_record(head, ".arch")){
+            if(check_arch == true){
+                _multiple_record_error(head->fields[0], _filename, head->line_number);
+                break;
+            }
+
+            if(head->count < 2){
+                _not_enough_tokens_error(head->fields[0], _filename, head->line_number);
+                break;
+            }
+
+            if(check_sl == false){
+                _wrong_records_order_error(head->fields[0], ".sl", _filename, head->line_number);
+                break;
+            }
+
+            if(strcmp(head->fields[1], index->target_arch_name) != 0){
+                _wrong_architecture_error(_filename, head->fields[1]);
+                break;
+            }
+
+            check_arch = true;
+        }
+        else if(is_record(head, ".member")){
+            if(head->count < 3){
+                _not_enough_tokens_error(head->fields[0], _filename, head->line_number);
+                break;
+            }
+
+            if(check_arch == false){
+                _wrong_records_order_error(head->fields[0], ".arch", _filename, head->line_number);
+                break;
+            }
+
+            char *end = NULL;
+            unsigned long offset = strtoul(head->fields[2], &end, 16);
+
+            if(end == head->fields[2] || *end != '\0'){
+                FILELIB_ERROR_WRITE("Invalid offset of library member at %s+%ld!", _filename, head->line_number);
+                break;
+            }
+
+            _sl_index_append_member(index, head->fields[1], offset, 0);
+        }
+        else if(is_record(head, ".symbol")){
+            if(head->count < 2){
+                _not_enough_tokens_error(head->fields[0], _filename, head->line_number);
+                break;
+            }
+
+            if(index == NULL || index->member_count == 0){
+                _wrong_records_order_error(head->fields[0], ".member", _filename, head->line_number);
+                break;
+            }
+
+            _sl_index_append_symbol(index, head->fields[1], index->member_count - 1);
+        }
+        else if(is_record(head, ".file") || is_record(head, ".end")){
+            if(check_arch == false){
+                _wrong_records_order_error(head->fields[0], ".arch", _filename, head->line_number);
+                break;
+            }
+
+            //library without any member doesn't need the index
+            if(index->member_count == 0 && is_record(head, ".file")){
+                if(missing != NULL){
+                    *missing = true;
+                }
+                else{
+                    FILELIB_ERROR_WRITE("Library %s doesn't contain symbol index!", filename);
+                }
+
+                break;
+            }
+
+            retVal = true;
+            break;
+        }
+        else{
+            _unrecognized_record_error(_filename, head->line_number);
+            break;
+        }
+    }
+
+    if(!check_sl){
+        _missing_record_error(".sl", filename);
+        retVal = false;
+    }
+    else if(!check_arch){
+        _missing_record_error(".arch", filename);
+        retVal = false;
+    }
+
+    if(retVal == true){
+        *output = (void *)index;
+    }
+    else{
+        *output = NULL;
+        if(index != NULL) sl_index_destroy(index);
     }
 
     return retVal;
 }
+
+bool loading_loop_sl_member(record_reader_t *input, void **output, char *filename){
+    CHECK_NULL_ARGUMENT(filename);
+    CHECK_NULL_ARGUMENT(output);
+    CHECK_NULL_ARGUMENT(input);
+    CHECK_NOT_NULL_ARGUMENT(*output);
+
+    record_t *head = &input->record;
+
+    //reader is positioned at ".file" record of the member
+    if(!record_reader_next(input) || !is_record(head, ".file")){
+        FILELIB_ERROR_WRITE("Symbol index of library %s doesn't match its content!", filename);
+        return false;
+    }
+
+    if(!loading_loop_obj(input, output, filename)){
+        FILELIB_ERROR_WRITE("Error parsing file %s!", filename);
+        return false;
+    }
+
+    return true;
+}
@@ -1,12 +1,18 @@
 #ifndef FILELIB_LOADING_LOOP_H_included
 #define FILELIB_LOADING_LOOP_H_included
 
-#include <utillib/core.h>
+#include "record_reader.h"
 
-typedef bool (loading_loop_t)(queue_t *input, void **output, char *filename);
+#include <stdbool.h>
+
+typedef bool (loading_loop_t)(record_reader_t *input, void **output, char *filename);
 
 loading_loop_t loading_loop_ldm;
 loading_loop_t loading_loop_obj;
 loading_loop_t loading_loop_sl;
+loading_loop_t loading_loop_sl_member;
+
+// with missing set, library without symbol index isn't reported as error, missing is set instead
+bool loading_loop_sl_index(record_reader_t *input, void **output, char *filename, bool *missing);
 
 #endif
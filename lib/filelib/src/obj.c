@@ -1,15 +1,59 @@
 #include "_filelib.h"
 
+bool obj_load_ctx(filelib_ctx_t *ctx, char *filename, obj_file_t **f){
+    filelib_scope_t scope = _filelib_ctx_enter(ctx);
+    bool retVal = _load_file(filename, (void **)f, &check_structure_obj, &loading_loop_obj, &binary_loading_loop_obj);
+
+    _filelib_ctx_leave(scope);
+
+    return retVal;
+}
+
 bool obj_load(char *filename, obj_file_t **f){
-    return _load_file(filename, (void **)f, &check_structure_obj, &loading_loop_obj);
+    return obj_load_ctx(NULL, filename, f);
 }
 
 bool obj_load_string(string_t *input, obj_file_t **f, char *filename){
     return _load_string(input, filename, (void **)f, &check_structure_obj, &loading_loop_obj);
 }
 
+bool obj_write_ctx(filelib_ctx_t *ctx, obj_file_t *f, char *filename){
+    filelib_scope_t scope = _filelib_ctx_enter(ctx);
+    bool retVal = _write_file(filename, (void *)f, &check_structure_obj, &writing_loop_obj);
+
+    _filelib_ctx_leave(scope);
+
+    return retVal;
+}
+
 bool obj_write(obj_file_t *f, char *filename){
-    return _write_file(filename, (void *)f, &check_structure_obj, &writing_loop_obj);
+    return obj_write_ctx(NULL, f, filename);
+}
+
+bool obj_write_stream_ctx(filelib_ctx_t *ctx, obj_file_t *f, FILE *fp){
+    filelib_scope_t scope = _filelib_ctx_enter(ctx);
+    bool retVal = _write_stream(fp, "stream", (void *)f, &check_structure_obj, &writing_loop_obj);
+
+    _filelib_ctx_leave(scope);
+
+    return retVal;
+}
+
+bool obj_write_stream(obj_file_t *f, FILE *fp){
+    return obj_write_stream_ctx(NULL, f, fp);
+}
+
+bool obj_write_binary_ctx(filelib_ctx_t *ctx, obj_file_t *f, char *filename){
+    filelib_scope_t scope = _filelib_ctx_enter(ctx);
+    bool retVal = _write_binary_file(filename, (void *)f, &check_structure_obj, &binary_writing_loop_obj);
+
+    _filelib_ctx_leave(scope);
+
+    return retVal;
+}
+
+bool obj_write_binary(obj_file_t *f, char *filename){
+    return obj_write_binary_ctx(NULL, f, filename);
 }
 
 void obj_write_string(obj_file_t *f, string_t **output){
@@ -1,7 +1,10 @@
 #ifndef FILELIB_OBJ_H_included
 #define FILELIB_OBJ_H_included
 
+#include "common.h"
+
 #include <stdbool.h>
+#include <stdio.h>
 
 #include <platformlib.h>
 #include <utillib/core.h>
@@ -37,6 +40,13 @@ typedef struct{
 
 bool obj_load(char *filename, obj_file_t **f);
 bool obj_write(obj_file_t *f, char *filename);
+bool obj_write_stream(obj_file_t *f, FILE *fp);
+bool obj_write_binary(obj_file_t *f, char *filename);
+
+bool obj_load_ctx(filelib_ctx_t *ctx, char *filename, obj_file_t **f);
+bool obj_write_ctx(filelib_ctx_t *ctx, obj_file_t *f, char *filename);
+bool obj_write_stream_ctx(filelib_ctx_t *ctx, obj_file_t *f, FILE *fp);
+bool obj_write_binary_ctx(filelib_ctx_t *ctx, obj_file_t *f, char *filename);
 
 void obj_file_new(obj_file_t **f);
 void obj_file_destroy(obj_file_t *f);
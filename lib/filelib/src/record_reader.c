@@ -0,0 +1,223 @@
+#include "_filelib.h"
+
+static void record_reader_new(record_reader_t **reader, char *filename, size_t buffer_size){
+    size_t capacity = 0;
+
+    *reader = (record_reader_t *)dynmem_malloc(sizeof(record_reader_t));
+
+    (*reader)->fp = NULL;
+    (*reader)->filename = dynmem_strdup(filename);
+    (*reader)->buffer = (char *)_filelib_scratch_take(FILELIB_SCRATCH_READER, buffer_size + 1, &capacity);
+    (*reader)->buffer_size = capacity - 1;
+    (*reader)->begin = 0;
+    (*reader)->end = 0;
+    (*reader)->eof = false;
+    (*reader)->error = false;
+    (*reader)->line_number = 0;
+    (*reader)->field_capacity = 8;
+    (*reader)->record.fields = (char **)dynmem_malloc((*reader)->field_capacity * sizeof(char *));
+    (*reader)->record.lengths = (unsigned *)dynmem_malloc((*reader)->field_capacity * sizeof(unsigned));
+    (*reader)->record.count = 0;
+    (*reader)->record.line_number = 0;
+}
+
+bool record_reader_open_file(record_reader_t **reader, char *filename){
+    CHECK_NULL_ARGUMENT(reader);
+    CHECK_NOT_NULL_ARGUMENT(*reader);
+    CHECK_NULL_ARGUMENT(filename);
+
+    FILE *fp = fopen(filename, "rb");
+
+    if(fp == NULL){
+        return false;
+    }
+
+    record_reader_open_stream(reader, fp, filename);
+
+    return true;
+}
+
+bool record_reader_open_file_at(record_reader_t **reader, char *filename, long offset){
+    CHECK_NULL_ARGUMENT(reader);
+    CHECK_NOT_NULL_ARGUMENT(*reader);
+    CHECK_NULL_ARGUMENT(filename);
+
+    if(!record_reader_open_file(reader, filename)){
+        return false;
+    }
+
+    if(fseek((*reader)->fp, offset, SEEK_SET) != 0){
+        record_reader_close(*reader);
+        *reader = NULL;
+        return false;
+    }
+
+    return true;
+}
+
+void record_reader_open_stream(record_reader_t **reader, FILE *fp, char *filename){
+    CHECK_NULL_ARGUMENT(reader);
+    CHECK_NOT_NULL_ARGUMENT(*reader);
+    CHECK_NULL_ARGUMENT(fp);
+    CHECK_NULL_ARGUMENT(filename);
+
+    record_reader_new(reader, filename, RECORD_READER_BUFFER_SIZE);
+    (*reader)->fp = fp;
+}
+
+void record_reader_open_memory(record_reader_t **reader, char *data, size_t size, char *filename){
+    CHECK_NULL_ARGUMENT(reader);
+    CHECK_NOT_NULL_ARGUMENT(*reader);
+    CHECK_NULL_ARGUMENT(data);
+    CHECK_NULL_ARGUMENT(filename);
+
+    //fields are split in place, so reader have to own its copy
+    record_reader_new(reader, filename, size);
+    memcpy((*reader)->buffer, data, size);
+
+    (*reader)->end = size;
+    (*reader)->eof = true;
+}
+
+void record_reader_close(record_reader_t *reader){
+    if(reader == NULL)
+        return;
+
+    if(reader->fp != NULL){
+        fclose(reader->fp);
+    }
+
+    dynmem_free(reader->record.fields);
+    dynmem_free(reader->record.lengths);
+    _filelib_scratch_give(FILELIB_SCRATCH_READER, reader->buffer, reader->buffer_size + 1);
+    dynmem_free(reader->filename);
+    dynmem_free(reader);
+}
+
+// move unread data to the beginning of buffer and fill the rest from file
+static void fill_buffer(record_reader_t *reader){
+    if(reader->begin > 0){
+        memmove(reader->buffer, reader->buffer + reader->begin, reader->end - reader->begin);
+        reader->end -= reader->begin;
+        reader->begin = 0;
+    }
+
+    //line doesn't fit into buffer
+    if(reader->end == reader->buffer_size){
+        char *tmp = (char *)dynmem_malloc(reader->buffer_size * 2 + 1);
+
+        memcpy(tmp, reader->buffer, reader->end);
+        dynmem_free(reader->buffer);
+
+        reader->buffer = tmp;
+        reader->buffer_size *= 2;
+    }
+
+    size_t count = fread(reader->buffer + reader->end, 1, reader->buffer_size - reader->end, reader->fp);
+    reader->end += count;
+
+    if(count == 0){
+        reader->error = ferror(reader->fp) ? true : false;
+        reader->eof = true;
+    }
+}
+
+static char *next_line(record_reader_t *reader){
+    while(true){
+        char *line = reader->buffer + reader->begin;
+        char *newline = (char *)memchr(line, '\n', reader->end - reader->begin);
+
+        if(newline != NULL){
+            *newline = '\0';
+            reader->begin = (size_t)(newline - reader->buffer) + 1;
+            return line;
+        }
+
+        if(reader->eof == true){
+            if(reader->begin == reader->end){
+                return NULL;
+            }
+
+            reader->buffer[reader->end] = '\0';
+            reader->begin = reader->end;
+            return line;
+        }
+
+        fill_buffer(reader);
+    }
+}
+
+static bool is_separator(char c){
+    return (c == ' ' || c == '\t' || c == '\r') ? true : false;
+}
+
+static void split_line(record_reader_t *reader, char *line){
+    record_t *record = &reader->record;
+
+    record->count = 0;
+
+    while(*line != '\0'){
+        while(is_separator(*line)){
+            *line++ = '\0';
+        }
+
+        if(*line == '\0'){
+            break;
+        }
+
+        if(record->count == reader->field_capacity){
+            char **fields = (char **)dynmem_malloc(reader->field_capacity * 2 * sizeof(char *));
+            unsigned *lengths = (unsigned *)dynmem_malloc(reader->field_capacity * 2 * sizeof(unsigned));
+
+            memcpy(fields, record->fields, reader->field_capacity * sizeof(char *));
+            memcpy(lengths, record->lengths, reader->field_capacity * sizeof(unsigned));
+            dynmem_free(record->fields);
+            dynmem_free(record->lengths);
+
+            record->fields = fields;
+            record->lengths = lengths;
+            reader->field_capacity *= 2;
+        }
+
+        char *field = line;
+
+        while(*line != '\0' && !is_separator(*line)){
+            line++;
+        }
+
+        record->fields[record->count] = field;
+        record->lengths[record->count] = (unsigned)(line - field);
+        record->count++;
+    }
+}
+
+bool record_reader_next(record_reader_t *reader){
+    CHECK_NULL_ARGUMENT(reader);
+
+    char *line = NULL;
+
+    while((line = next_line(reader)) != NULL){
+        reader->line_number++;
+        split_line(reader, line);
+
+        //skip empty lines
+        if(reader->record.count > 0){
+            reader->record.line_number = reader->line_number;
+            return true;
+        }
+    }
+
+    reader->record.count = 0;
+
+    return false;
+}
+
+bool is_record(record_t *record, char *x){
+    CHECK_NULL_ARGUMENT(record);
+    CHECK_NULL_ARGUMENT(x);
+
+    if(record->count > 0 && strcmp(record->fields[0], x) == 0)
+        return true;
+    else
+        return false;
+}
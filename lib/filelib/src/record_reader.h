@@ -0,0 +1,44 @@
+#ifndef FILELIB_RECORD_READER_H_included
+#define FILELIB_RECORD_READER_H_included
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+
+#define RECORD_READER_BUFFER_SIZE (64 * 1024)
+
+typedef struct{
+    char **fields;
+    unsigned *lengths;
+    unsigned count;
+    long line_number;
+} record_t;
+
+// reads text files line by line through fixed buffer, fields of the current
+// record points into that buffer and are valid only until next record is read
+typedef struct{
+    FILE *fp;
+    char *filename;
+    char *buffer;
+    size_t buffer_size;
+    size_t begin;
+    size_t end;
+    bool eof;
+    bool error;
+    long line_number;
+    unsigned field_capacity;
+    record_t record;
+} record_reader_t;
+
+bool record_reader_open_file(record_reader_t **reader, char *filename);
+// reading starts at given byte offset, line numbers are counted from there
+bool record_reader_open_file_at(record_reader_t **reader, char *filename, long offset);
+// reader takes over already opened stream and closes it
+void record_reader_open_stream(record_reader_t **reader, FILE *fp, char *filename);
+void record_reader_open_memory(record_reader_t **reader, char *data, size_t size, char *filename);
+void record_reader_close(record_reader_t *reader);
+
+bool record_reader_next(record_reader_t *reader);
+bool is_record(record_t *record, char *x);
+
+#endif
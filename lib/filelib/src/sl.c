@@ -1,11 +1,820 @@
 #include "_filelib.h"
 
+#if defined(_WIN32)
+    #include <process.h>
+    #define sl_getpid() ((unsigned long)_getpid())
+#else
+    #include <unistd.h>
+    #define sl_getpid() ((unsigned long)getpid())
+#endif
+
+bool sl_load_ctx(filelib_ctx_t *ctx, char *filename, sl_file_t **f){
+    filelib_scope_t scope = _filelib_ctx_enter(ctx);
+    bool retVal = _load_file(filename, (void **)f, &check_structure_sl, &loading_loop_sl, &binary_loading_loop_sl);
+
+    _filelib_ctx_leave(scope);
+
+    return retVal;
+}
+
 bool sl_load(char *filename, sl_file_t **f){
-    return _load_file(filename, (void **)f, &check_structure_sl, &loading_loop_sl);
+    return sl_load_ctx(NULL, filename, f);
+}
+
+bool sl_write_ctx(filelib_ctx_t *ctx, sl_file_t *f, char *filename){
+    filelib_scope_t scope = _filelib_ctx_enter(ctx);
+    bool retVal = _write_file(filename, (void *)f, &check_structure_sl, &writing_loop_sl);
+
+    _filelib_ctx_leave(scope);
+
+    return retVal;
 }
 
 bool sl_write(sl_file_t *f, char *filename){
-    return _write_file(filename, (void *)f, &check_structure_sl, &writing_loop_sl);
+    return sl_write_ctx(NULL, f, filename);
+}
+
+bool sl_write_stream_ctx(filelib_ctx_t *ctx, sl_file_t *f, FILE *fp){
+    filelib_scope_t scope = _filelib_ctx_enter(ctx);
+    bool retVal = _write_stream(fp, "stream", (void *)f, &check_structure_sl, &writing_loop_sl);
+
+    _filelib_ctx_leave(scope);
+
+    return retVal;
+}
+
+bool sl_write_stream(sl_file_t *f, FILE *fp){
+    return sl_write_stream_ctx(NULL, f, fp);
+}
+
+bool sl_write_binary_ctx(filelib_ctx_t *ctx, sl_file_t *f, char *filename){
+    filelib_scope_t scope = _filelib_ctx_enter(ctx);
+    bool retVal = _write_binary_file(filename, (void *)f, &check_structure_sl, &binary_writing_loop_sl);
+
+    _filelib_ctx_leave(scope);
+
+    return retVal;
+}
+
+bool sl_write_binary(sl_file_t *f, char *filename){
+    return sl_write_binary_ctx(NULL, f, filename);
+}
+
+static bool load_binary_index(FILE *fp, char *filename, sl_index_t **index){
+    uint8_t header[SL_HEADER_SIZE];
+    size_t header_size = fread(header, 1, sizeof(header), fp);
+    size_t size = binary_sl_index_size(header, header_size, filename);
+    long file_size = 0;
+
+    if(size == 0){
+        return false;
+    }
+
+    if(fseek(fp, 0, SEEK_END) != 0 || (file_size = ftell(fp)) < 0 || fseek(fp, 0, SEEK_SET) != 0 || (size_t)file_size < size){
+        FILELIB_ERROR_WRITE("Failed to read file '%s'!", filename);
+        return false;
+    }
+
+    //index is stored in front of members, so only that part of file is read
+    uint8_t *data = (uint8_t *)dynmem_malloc(size);
+
+    if(fread(data, 1, size, fp) != size){
+        FILELIB_ERROR_WRITE("Failed to read file '%s'!", filename);
+        dynmem_free(data);
+        return false;
+    }
+
+    _sl_index_new(index, filename);
+    (*index)->binary = true;
+
+    if(!binary_sl_index_init(*index, data, size, (size_t)file_size, filename)){
+        sl_index_destroy(*index);
+        *index = NULL;
+        dynmem_free(data);
+        return false;
+    }
+
+    dynmem_free(data);
+
+    return true;
+}
+
+// stream is closed, text library without index sets missing instead of error when it is given
+static bool load_index_stream(FILE *fp, char *filename, bool binary, sl_index_t **index, bool *missing){
+    if(binary == true){
+        bool retVal = load_binary_index(fp, filename, index);
+        fclose(fp);
+        return retVal;
+    }
+
+    record_reader_t *reader = NULL;
+
+    record_reader_open_stream(&reader, fp, filename);
+
+    bool retVal = loading_loop_sl_index(reader, (void **)index, filename, missing);
+
+    record_reader_close(reader);
+
+    return retVal;
+}
+
+bool _sl_load_index_stream(FILE *fp, char *filename, bool binary, sl_index_t **index, bool *missing){
+    CHECK_NULL_ARGUMENT(fp);
+    CHECK_NULL_ARGUMENT(filename);
+    CHECK_NULL_ARGUMENT(index);
+    CHECK_NOT_NULL_ARGUMENT(*index);
+    CHECK_NULL_ARGUMENT(missing);
+
+    *missing = false;
+
+    return load_index_stream(fp, filename, binary, index, missing);
+}
+
+static bool load_index(char *filename, sl_index_t **index){
+    CHECK_NULL_ARGUMENT(filename);
+    CHECK_NULL_ARGUMENT(index);
+    CHECK_NOT_NULL_ARGUMENT(*index);
+
+    FILE *fp = NULL;
+    bool binary = false;
+
+    if(!_open_file(filename, &fp, &binary)){
+        return false;
+    }
+
+    return load_index_stream(fp, filename, binary, index, NULL);
+}
+
+// text index ends by the first .file or .end record, only that part of data is parsed
+static size_t text_index_size(uint8_t *data, size_t size){
+    size_t line = 0;
+
+    while(line < size){
+        uint8_t *newline = (uint8_t *)memchr(data + line, '\n', size - line);
+        size_t next = (newline == NULL) ? size : (size_t)(newline - data) + 1;
+        size_t c = line;
+
+        while(c < next && (data[c] == ' ' || data[c] == '\t')){
+            c++;
+        }
+
+        if((next - c >= 5 && memcmp(data + c, ".file", 5) == 0) || (next - c >= 4 && memcmp(data + c, ".end", 4) == 0)){
+            return next;
+        }
+
+        line = next;
+    }
+
+    return size;
+}
+
+// index of library which is already loaded in memory
+static bool load_index_data(char *filename, uint8_t *data, size_t size, sl_index_t **index, bool *missing){
+    if(binary_is_magic(data, size)){
+        size_t index_size = binary_sl_index_size(data, size, filename);
+
+        if(index_size == 0){
+            return false;
+        }
+
+        if(index_size > size){
+            FILELIB_ERROR_WRITE("Library %s is corrupted!", filename);
+            return false;
+        }
+
+        _sl_index_new(index, filename);
+        (*index)->binary = true;
+
+        if(!binary_sl_index_init(*index, data, index_size, size, filename)){
+            sl_index_destroy(*index);
+            *index = NULL;
+            return false;
+        }
+
+        return true;
+    }
+
+    record_reader_t *reader = NULL;
+
+    record_reader_open_memory(&reader, (char *)data, text_index_size(data, size), filename);
+
+    bool retVal = loading_loop_sl_index(reader, (void **)index, filename, missing);
+
+    record_reader_close(reader);
+
+    return retVal;
+}
+
+bool sl_load_index_ctx(filelib_ctx_t *ctx, char *filename, sl_index_t **index){
+    filelib_scope_t scope = _filelib_ctx_enter(ctx);
+    bool retVal = load_index(filename, index);
+
+    _filelib_ctx_leave(scope);
+
+    return retVal;
+}
+
+bool sl_load_index(char *filename, sl_index_t **index){
+    return sl_load_index_ctx(NULL, filename, index);
+}
+
+static bool load_member(sl_index_t *index, unsigned member, obj_file_t **f){
+    CHECK_NULL_ARGUMENT(index);
+    CHECK_NULL_ARGUMENT(f);
+    CHECK_NOT_NULL_ARGUMENT(*f);
+
+    if(member >= index->member_count){
+        error("Requesting member %u of library %s with only %u members!", member, index->filename, index->member_count);
+    }
+
+    sl_index_member_t *head = &(index->members[member]);
+
+    if(index->binary == true){
+        FILE *fp = fopen(index->filename, "rb");
+        uint8_t *data = (uint8_t *)dynmem_malloc(head->size + 1);
+        bool retVal = false;
+
+        if(fp != NULL && fseek(fp, (long)head->offset, SEEK_SET) == 0 && fread(data, 1, head->size, fp) == head->size){
+            retVal = binary_loading_loop_obj(data, head->size, (void **)f, index->filename);
+        }
+        else{
+            FILELIB_ERROR_WRITE("Failed to read file '%s'!", index->filename);
+        }
+
+        if(fp != NULL){
+            fclose(fp);
+        }
+
+        dynmem_free(data);
+
+        if(retVal == true){
+            check_structure_obj((void *)*f);
+        }
+
+        return retVal;
+    }
+
+    record_reader_t *reader = NULL;
+
+    if(!record_reader_open_file_at(&reader, index->filename, (long)head->offset)){
+        FILELIB_ERROR_WRITE("Failed to read file '%s'!", index->filename);
+        return false;
+    }
+
+    if(!loading_loop_sl_member(reader, (void **)f, index->filename)){
+        record_reader_close(reader);
+        return false;
+    }
+
+    record_reader_close(reader);
+    check_structure_obj((void *)*f);
+
+    return true;
+}
+
+bool sl_load_member_ctx(filelib_ctx_t *ctx, sl_index_t *index, unsigned member, obj_file_t **f){
+    filelib_scope_t scope = _filelib_ctx_enter(ctx);
+    bool retVal = load_member(index, member, f);
+
+    _filelib_ctx_leave(scope);
+
+    return retVal;
+}
+
+bool sl_load_member(sl_index_t *index, unsigned member, obj_file_t **f){
+    return sl_load_member_ctx(NULL, index, member, f);
+}
+
+//-----------------------------------
+// Update
+
+void _sl_members_init(sl_members_t *members){
+    CHECK_NULL_ARGUMENT(members);
+
+    members->target_arch_name = NULL;
+    members->count = 0;
+    members->capacity = 0;
+    members->members = NULL;
+
+    _set_arch_name(&members->target_arch_name);
+}
+
+void _sl_members_release(sl_members_t *members){
+    CHECK_NULL_ARGUMENT(members);
+
+    for(unsigned i = 0; i < members->count; i++){
+        //only symbols of objects are owned, payload symbols belong to index
+        if(members->members[i].object != NULL && members->members[i].symbols != NULL){
+            dynmem_free(members->members[i].symbols);
+        }
+    }
+
+    if(members->members != NULL){
+        dynmem_free(members->members);
+    }
+
+    dynmem_free(members->target_arch_name);
+}
+
+static sl_member_t *append_member(sl_members_t *members, char *name){
+    if(members->count == members->capacity){
+        unsigned capacity = (members->capacity == 0) ? 16 : members->capacity * 2;
+        sl_member_t *tmp = (sl_member_t *)dynmem_malloc(capacity * sizeof(sl_member_t));
+
+        if(members->members != NULL){
+            memcpy(tmp, members->members, members->count * sizeof(sl_member_t));
+            dynmem_free(members->members);
+        }
+
+        members->members = tmp;
+        members->capacity = capacity;
+    }
+
+    sl_member_t *member = &(members->members[members->count++]);
+
+    member->name = name;
+    member->object = NULL;
+    member->payload = NULL;
+    member->payload_size = 0;
+    member->symbols = NULL;
+    member->symbol_count = 0;
+
+    return member;
+}
+
+void _sl_members_append_object(sl_members_t *members, char *name, obj_file_t *object){
+    CHECK_NULL_ARGUMENT(members);
+    CHECK_NULL_ARGUMENT(name);
+    CHECK_NULL_ARGUMENT(object);
+
+    sl_member_t *member = append_member(members, name);
+    unsigned count = 0;
+
+    member->object = object;
+
+    for(unsigned i = 0; i < list_count(object->section_list); i++){
+        obj_section_t *section = NULL;
+        list_at(object->section_list, i, (void *)&section);
+        count += list_count(section->exported_symbol_list);
+    }
+
+    if(count == 0){
+        return;
+    }
+
+    member->symbols = (sl_index_symbol_t *)dynmem_malloc(count * sizeof(sl_index_symbol_t));
+
+    for(unsigned i = 0; i < list_count(object->section_list); i++){
+        obj_section_t *section = NULL;
+        list_at(object->section_list, i, (void *)&section);
+
+        for(unsigned j = 0; j < list_count(section->exported_symbol_list); j++){
+            obj_symbol_t *symbol = NULL;
+            list_at(section->exported_symbol_list, j, (void *)&symbol);
+
+            member->symbols[member->symbol_count].name = symbol->name;
+            member->symbols[member->symbol_count].member = members->count - 1;
+            member->symbol_count++;
+        }
+    }
+}
+
+void _sl_members_append_payload(sl_members_t *members, sl_index_t *index, unsigned member, uint8_t *payload, size_t size){
+    CHECK_NULL_ARGUMENT(members);
+    CHECK_NULL_ARGUMENT(index);
+    CHECK_NULL_ARGUMENT(payload);
+
+    sl_index_member_t *head = &(index->members[member]);
+    sl_member_t *tmp = append_member(members, head->name);
+
+    tmp->payload = payload;
+    tmp->payload_size = size;
+    tmp->symbols = (head->symbol_count > 0) ? &(index->symbols[head->first_symbol]) : NULL;
+    tmp->symbol_count = head->symbol_count;
+}
+
+void _sl_members_from_file(sl_members_t *members, sl_file_t *f){
+    CHECK_NULL_ARGUMENT(members);
+    CHECK_NULL_ARGUMENT(f);
+
+    _sl_members_init(members);
+
+    for(unsigned i = 0; i < list_count(f->objects); i++){
+        sl_holder_t *holder = NULL;
+        list_at(f->objects, i, (void *)&holder);
+
+        _sl_members_append_object(members, holder->object_name, holder->object);
+    }
+}
+
+// last member of text library ends where final .end record of library starts
+static bool text_library_end(uint8_t *data, size_t size, size_t *end){
+    while(size > 0 && (data[size - 1] == '\r' || data[size - 1] == '\n' || data[size - 1] == ' ' || data[size - 1] == '\t')){
+        size--;
+    }
+
+    if(size < 5 || memcmp(data + size - 4, ".end", 4) != 0 || data[size - 5] != '\n'){
+        return false;
+    }
+
+    *end = size - 4;
+
+    return true;
+}
+
+// find where payload of every member lies in loaded library
+static bool member_payloads(sl_index_t *index, uint8_t *data, size_t size, size_t *offsets, size_t *sizes){
+    size_t end = size;
+
+    if(index->binary == false && index->member_count > 0 && !text_library_end(data, size, &end)){
+        FILELIB_ERROR_WRITE("Library %s is corrupted!", index->filename);
+        return false;
+    }
+
+    for(unsigned i = 0; i < index->member_count; i++){
+        offsets[i] = index->members[i].offset;
+
+        if(index->binary == true){
+            sizes[i] = index->members[i].size;
+        }
+        else{
+            //text members follow each other in the order of index
+            size_t next = (i + 1 < index->member_count) ? index->members[i + 1].offset : end;
+            sizes[i] = (next >= offsets[i]) ? next - offsets[i] : size + 1;
+        }
+
+        if(offsets[i] > size || sizes[i] > size - offsets[i]){
+            FILELIB_ERROR_WRITE("Library %s is corrupted!", index->filename);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static char *holder_name(char *name){
+    const char *basename = NULL;
+    size_t length = 0;
+
+    cwk_path_get_basename(name, &basename, &length);
+
+    char *tmp = (char *)dynmem_calloc(length + 1, sizeof(char));
+    strncpy(tmp, basename, length);
+
+    return tmp;
+}
+
+static bool write_members(char *filename, bool binary, sl_members_t *members){
+    char *tmp_filename = (char *)dynmem_malloc(strlen(filename) + 32);
+    bool retVal = false;
+
+    //unique, so concurrent updates of the same library don't share it
+    sprintf(tmp_filename, "%s.%lu.tmp", filename, sl_getpid());
+
+    //library is replaced only when whole new content was written
+    if(binary == true){
+        retVal = _write_binary_file(tmp_filename, (void *)members, &check_structure_sl_members, &binary_writing_loop_sl_members);
+    }
+    else{
+        retVal = _write_file(tmp_filename, (void *)members, &check_structure_sl_members, &writing_loop_sl_members);
+    }
+
+    if(retVal == true){
+#if defined(_WIN32)
+        remove(filename);
+#endif
+        if(rename(tmp_filename, filename) != 0){
+            FILELIB_ERROR_WRITE("Failed to write %s!", filename);
+            retVal = false;
+        }
+    }
+
+    if(retVal == false){
+        remove(tmp_filename);
+    }
+
+    dynmem_free(tmp_filename);
+
+    return retVal;
+}
+
+// objects and names of members which are replaced or removed by update
+typedef struct{
+    sl_file_t *objects;
+    unsigned object_count;
+    bool *used;
+    char **remove_names;
+    unsigned remove_count;
+    bool *removed;
+}library_update_t;
+
+static void library_update_init(library_update_t *u, sl_file_t *update, char **remove_list, unsigned remove_count){
+    u->objects = update;
+    u->object_count = list_count(update->objects);
+    u->used = (bool *)dynmem_calloc(u->object_count + 1, sizeof(bool));
+    u->remove_names = (char **)dynmem_calloc(remove_count + 1, sizeof(char *));
+    u->remove_count = remove_count;
+    u->removed = (bool *)dynmem_calloc(remove_count + 1, sizeof(bool));
+
+    //members are named by basename of their object file, see sl_holder_new
+    for(unsigned i = 0; i < remove_count; i++){
+        u->remove_names[i] = holder_name(remove_list[i]);
+    }
+}
+
+static void library_update_release(library_update_t *u){
+    for(unsigned i = 0; i < u->remove_count; i++){
+        dynmem_free(u->remove_names[i]);
+    }
+
+    dynmem_free(u->remove_names);
+    dynmem_free(u->removed);
+    dynmem_free(u->used);
+}
+
+// member is removed or replaced by object of the same name, false when it is kept
+static bool library_update_member(library_update_t *u, sl_members_t *members, char *name){
+    bool done = false;
+
+    for(unsigned i = 0; i < u->remove_count; i++){
+        if(strcmp(u->remove_names[i], name) == 0){
+            u->removed[i] = true;
+            done = true;
+        }
+    }
+
+    for(unsigned i = 0; done == false && i < u->object_count; i++){
+        sl_holder_t *holder = NULL;
+        list_at(u->objects->objects, i, (void *)&holder);
+
+        if(u->used[i] == false && strcmp(holder->object_name, name) == 0){
+            _sl_members_append_object(members, holder->object_name, holder->object);
+            u->used[i] = true;
+            done = true;
+        }
+    }
+
+    return done;
+}
+
+// objects which didn't replace anything are appended
+static bool library_update_finish(library_update_t *u, sl_members_t *members, char *filename){
+    for(unsigned i = 0; i < u->remove_count; i++){
+        if(u->removed[i] == false){
+            FILELIB_ERROR_WRITE("Library %s doesn't contain member %s!", filename, u->remove_names[i]);
+            return false;
+        }
+    }
+
+    for(unsigned i = 0; i < u->object_count; i++){
+        if(u->used[i] == false){
+            sl_holder_t *holder = NULL;
+            list_at(u->objects->objects, i, (void *)&holder);
+
+            _sl_members_append_object(members, holder->object_name, holder->object);
+        }
+    }
+
+    return true;
+}
+
+// libraries written before symbol index was introduced are parsed whole and
+// written again, with the index
+static bool update_unindexed_library(char *filename, uint8_t *data, size_t size, library_update_t *u){
+    sl_file_t *library = NULL;
+    record_reader_t *reader = NULL;
+    sl_members_t members;
+
+    record_reader_open_memory(&reader, (char *)data, size, filename);
+
+    bool retVal = loading_loop_sl(reader, (void **)&library, filename);
+
+    record_reader_close(reader);
+
+    if(retVal == false){
+        return false;
+    }
+
+    check_structure_sl((void *)library);
+    _sl_members_init(&members);
+
+    for(unsigned i = 0; i < list_count(library->objects); i++){
+        sl_holder_t *holder = NULL;
+        list_at(library->objects, i, (void *)&holder);
+
+        if(!library_update_member(u, &members, holder->object_name)){
+            _sl_members_append_object(&members, holder->object_name, holder->object);
+        }
+    }
+
+    retVal = library_update_finish(u, &members, filename) && write_members(filename, false, &members);
+
+    _sl_members_release(&members);
+    sl_file_destroy(library);
+
+    return retVal;
+}
+
+static bool update_indexed_library(sl_index_t *index, uint8_t *data, size_t size, library_update_t *u){
+    bool retVal = true;
+    size_t *offsets = (size_t *)dynmem_calloc(index->member_count + 1, sizeof(size_t));
+    size_t *sizes = (size_t *)dynmem_calloc(index->member_count + 1, sizeof(size_t));
+    sl_members_t members;
+
+    _sl_members_init(&members);
+
+    if(!member_payloads(index, data, size, offsets, sizes)){
+        retVal = false;
+    }
+
+    for(unsigned i = 0; retVal == true && i < index->member_count; i++){
+        if(!library_update_member(u, &members, index->members[i].name)){
+            _sl_members_append_payload(&members, index, i, data + offsets[i], sizes[i]);
+        }
+    }
+
+    retVal = retVal && library_update_finish(u, &members, index->filename) && write_members(index->filename, index->binary, &members);
+
+    _sl_members_release(&members);
+    dynmem_free(sizes);
+    dynmem_free(offsets);
+
+    return retVal;
+}
+
+// two objects of the same name would end up as two members of that name
+static bool unique_update_names(char *filename, sl_file_t *update){
+    for(unsigned i = 0; i < list_count(update->objects); i++){
+        sl_holder_t *holder = NULL;
+        list_at(update->objects, i, (void *)&holder);
+
+        for(unsigned j = 0; j < i; j++){
+            sl_holder_t *previous = NULL;
+            list_at(update->objects, j, (void *)&previous);
+
+            if(strcmp(holder->object_name, previous->object_name) == 0){
+                FILELIB_ERROR_WRITE("Member %s is given more than once to update library %s!", holder->object_name, filename);
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+static bool update_library(char *filename, sl_file_t *update, char **remove_list, unsigned remove_count){
+    CHECK_NULL_ARGUMENT(filename);
+    CHECK_NULL_ARGUMENT(update);
+
+    if(remove_count > 0){
+        CHECK_NULL_ARGUMENT(remove_list);
+    }
+
+    check_structure_sl((void *)update);
+
+    if(!unique_update_names(filename, update)){
+        return false;
+    }
+
+    sl_index_t *index = NULL;
+    uint8_t *data = NULL;
+    size_t size = 0;
+    bool missing = false;
+    bool retVal = false;
+    library_update_t u;
+
+    //file is read only once, so index always matches the bytes being copied
+    if(!_read_file(filename, &data, &size)){
+        return false;
+    }
+
+    library_update_init(&u, update, remove_list, remove_count);
+
+    if(load_index_data(filename, data, size, &index, &missing)){
+        retVal = update_indexed_library(index, data, size, &u);
+        sl_index_destroy(index);
+    }
+    else if(missing == true){
+        retVal = update_unindexed_library(filename, data, size, &u);
+    }
+
+    library_update_release(&u);
+    dynmem_free(data);
+
+    return retVal;
+}
+
+bool sl_update_ctx(filelib_ctx_t *ctx, char *filename, sl_file_t *update, char **remove_list, unsigned remove_count){
+    filelib_scope_t scope = _filelib_ctx_enter(ctx);
+    bool retVal = update_library(filename, update, remove_list, remove_count);
+
+    _filelib_ctx_leave(scope);
+
+    return retVal;
+}
+
+bool sl_update(char *filename, sl_file_t *update, char **remove_list, unsigned remove_count){
+    return sl_update_ctx(NULL, filename, update, remove_list, remove_count);
+}
+
+//-----------------------------------
+// Index
+
+void _sl_index_new(sl_index_t **index, char *filename){
+    CHECK_NULL_ARGUMENT(index);
+    CHECK_NOT_NULL_ARGUMENT(*index);
+    CHECK_NULL_ARGUMENT(filename);
+
+    *index = (sl_index_t *)dynmem_calloc(1, sizeof(sl_index_t));
+
+    (*index)->filename = dynmem_strdup(filename);
+    _set_arch_name(&(*index)->target_arch_name);
+}
+
+void _sl_index_append_member(sl_index_t *index, char *name, unsigned long offset, unsigned long size){
+    CHECK_NULL_ARGUMENT(index);
+    CHECK_NULL_ARGUMENT(name);
+
+    if(index->member_count == index->member_capacity){
+        unsigned capacity = (index->member_capacity == 0) ? 16 : index->member_capacity * 2;
+        sl_index_member_t *members = (sl_index_member_t *)dynmem_malloc(capacity * sizeof(sl_index_member_t));
+
+        if(index->members != NULL){
+            memcpy(members, index->members, index->member_count * sizeof(sl_index_member_t));
+            dynmem_free(index->members);
+        }
+
+        index->members = members;
+        index->member_capacity = capacity;
+    }
+
+    sl_index_member_t *member = &(index->members[index->member_count++]);
+
+    member->name = dynmem_strdup(name);
+    member->offset = offset;
+    member->size = size;
+    member->first_symbol = index->symbol_count;
+    member->symbol_count = 0;
+}
+
+// symbols have to be appended in order of their members
+void _sl_index_append_symbol(sl_index_t *index, char *name, unsigned member){
+    CHECK_NULL_ARGUMENT(index);
+    CHECK_NULL_ARGUMENT(name);
+
+    if(member >= index->member_count){
+        error("Symbol %s refers to missing member %u of library %s!", name, member, index->filename);
+    }
+
+    if(index->symbol_count == index->symbol_capacity){
+        unsigned capacity = (index->symbol_capacity == 0) ? 64 : index->symbol_capacity * 2;
+        sl_index_symbol_t *symbols = (sl_index_symbol_t *)dynmem_malloc(capacity * sizeof(sl_index_symbol_t));
+
+        if(index->symbols != NULL){
+            memcpy(symbols, index->symbols, index->symbol_count * sizeof(sl_index_symbol_t));
+            dynmem_free(index->symbols);
+        }
+
+        index->symbols = symbols;
+        index->symbol_capacity = capacity;
+    }
+
+    sl_index_symbol_t *symbol = &(index->symbols[index->symbol_count]);
+
+    symbol->name = dynmem_strdup(name);
+    symbol->member = member;
+
+    if(index->members[member].symbol_count == 0){
+        index->members[member].first_symbol = index->symbol_count;
+    }
+
+    index->members[member].symbol_count++;
+    index->symbol_count++;
+}
+
+void sl_index_destroy(sl_index_t *index){
+    if(index == NULL)
+        return;
+
+    for(unsigned i = 0; i < index->member_count; i++){
+        dynmem_free(index->members[i].name);
+    }
+
+    for(unsigned i = 0; i < index->symbol_count; i++){
+        dynmem_free(index->symbols[i].name);
+    }
+
+    if(index->members != NULL){
+        dynmem_free(index->members);
+    }
+
+    if(index->symbols != NULL){
+        dynmem_free(index->symbols);
+    }
+
+    dynmem_free(index->target_arch_name);
+    dynmem_free(index->filename);
+    dynmem_free(index);
 }
 
 void sl_file_new(sl_file_t **f){
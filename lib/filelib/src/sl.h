@@ -15,8 +15,66 @@ typedef struct{
     list_t *objects;
 }sl_file_t;
 
+// Text library starts with index, every member has ".member name offset"
+// record followed by ".symbol name" record of each its exported symbol.
+// Offset is byte offset of ".file" record of the member, it has fixed width
+// so writer can count size of the index before it is written.
+#define SL_INDEX_OFFSET_FORMAT "0x%08lx"
+#define SL_INDEX_OFFSET_WIDTH 10
+#define SL_INDEX_OFFSET_MAX 0xffffffffUL
+
+typedef struct{
+    char *name;
+    unsigned long offset;
+    unsigned long size;     // size of binary image, 0 for text library
+    unsigned first_symbol;
+    unsigned symbol_count;
+}sl_index_member_t;
+
+typedef struct{
+    char *name;
+    unsigned member;
+}sl_index_symbol_t;
+
+// symbol index of library, loaded without parsing any of its members
+typedef struct{
+    char *filename;
+    char *target_arch_name;
+    bool binary;
+    unsigned member_count;
+    unsigned member_capacity;
+    sl_index_member_t *members;
+    unsigned symbol_count;
+    unsigned symbol_capacity;
+    sl_index_symbol_t *symbols;
+}sl_index_t;
+
 bool sl_load(char *filename, sl_file_t **f);
 bool sl_write(sl_file_t *f, char *filename);
+bool sl_write_stream(sl_file_t *f, FILE *fp);
+bool sl_write_binary(sl_file_t *f, char *filename);
+
+// read only index from the beginning of library, members are then loaded one
+// by one by sl_load_member which seeks directly to them
+bool sl_load_index(char *filename, sl_index_t **index);
+bool sl_load_member(sl_index_t *index, unsigned member, obj_file_t **f);
+void sl_index_destroy(sl_index_t *index);
+
+// rewrite library, objects of update replace members with the same name or are
+// appended behind the others and members named in remove_list are left out; payload
+// of any other member is copied byte by byte without being parsed. Library
+// keeps its format and it is replaced only after new content is written whole.
+// Text library written without symbol index is parsed whole and gets the index.
+// Objects of update have to have distinct names.
+bool sl_update(char *filename, sl_file_t *update, char **remove_list, unsigned remove_count);
+
+bool sl_load_ctx(filelib_ctx_t *ctx, char *filename, sl_file_t **f);
+bool sl_write_ctx(filelib_ctx_t *ctx, sl_file_t *f, char *filename);
+bool sl_write_stream_ctx(filelib_ctx_t *ctx, sl_file_t *f, FILE *fp);
+bool sl_write_binary_ctx(filelib_ctx_t *ctx, sl_file_t *f, char *filename);
+bool sl_load_index_ctx(filelib_ctx_t *ctx, char *filename, sl_index_t **index);
+bool sl_load_member_ctx(filelib_ctx_t *ctx, sl_index_t *index, unsigned member, obj_file_t **f);
+bool sl_update_ctx(filelib_ctx_t *ctx, char *filename, sl_file_t *update, char **remove_list, unsigned remove_count);
 
 void sl_file_new(sl_file_t **f);
 void sl_file_destroy(sl_file_t *f);
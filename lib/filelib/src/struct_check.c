@@ -108,3 +108,28 @@ void check_structure_sl(void *input){
         check_structure_obj((void *)tmp->object);
     }
 }
+
+void check_structure_sl_members(void *input){
+    CHECK_NULL_ARGUMENT(input);
+
+    sl_members_t *_input = (sl_members_t *)input;
+
+    if(_input->target_arch_name == NULL){
+        error("Broken library members! target_arch_name == NULL!");
+    }
+
+    for(unsigned i = 0; i < _input->count; i++){
+        sl_member_t *tmp = &(_input->members[i]);
+
+        if(tmp->name == NULL){
+            error("Broken library members! One member doesn't have name!");
+        }
+
+        if(tmp->object != NULL){
+            check_structure_obj((void *)tmp->object);
+        }
+        else if(tmp->payload == NULL){
+            error("Broken library members! One member is empty!");
+        }
+    }
+}
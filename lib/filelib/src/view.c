@@ -0,0 +1,515 @@
+#ifdef FILELIB_USE_MMAP
+    #define _POSIX_C_SOURCE 200809L
+
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+#include "_filelib.h"
+
+struct filelib_mapping_s{
+    uint8_t *data;
+    size_t size;
+    bool mapped;
+    unsigned references;
+};
+
+//-----------------------------------
+// File mapping
+
+#ifdef FILELIB_USE_MMAP
+static bool map_file(FILE *fp, uint8_t **data, size_t *size){
+    struct stat info;
+    int fd = fileno(fp);
+
+    if(fd < 0){
+        return false;
+    }
+
+    if(fstat(fd, &info) != 0 || !S_ISREG(info.st_mode) || info.st_size == 0){
+        return false;
+    }
+
+    void *tmp = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+    if(tmp == MAP_FAILED){
+        return false;
+    }
+
+    *data = (uint8_t *)tmp;
+    *size = (size_t)info.st_size;
+
+    return true;
+}
+
+static void unmap_file(uint8_t *data, size_t size){
+    munmap(data, size);
+}
+#else
+static bool map_file(FILE *fp, uint8_t **data, size_t *size){
+    (void)fp;
+    (void)data;
+    (void)size;
+
+    return false;
+}
+
+static void unmap_file(uint8_t *data, size_t size){
+    (void)data;
+    (void)size;
+}
+#endif
+
+static filelib_mapping_t *mapping_new(uint8_t *data, size_t size, bool mapped){
+    filelib_mapping_t *tmp = (filelib_mapping_t *)dynmem_malloc(sizeof(filelib_mapping_t));
+
+    tmp->data = data;
+    tmp->size = size;
+    tmp->mapped = mapped;
+    tmp->references = 1;
+
+    return tmp;
+}
+
+static void mapping_release(filelib_mapping_t *mapping){
+    if(mapping == NULL)
+        return;
+
+    if(--mapping->references > 0)
+        return;
+
+    if(mapping->mapped == true){
+        unmap_file(mapping->data, mapping->size);
+    }
+    else if(mapping->data != NULL){
+        dynmem_free(mapping->data);
+    }
+
+    dynmem_free(mapping);
+}
+
+// map binary file opened by _open_file when platform allows it, otherwise
+// read it whole into memory; stream is closed
+static bool mapping_open(FILE *fp, char *filename, filelib_mapping_t **mapping){
+    uint8_t *data = NULL;
+    size_t size = 0;
+
+    if(map_file(fp, &data, &size)){
+        fclose(fp);
+        *mapping = mapping_new(data, size, true);
+        return true;
+    }
+
+    if(!_read_stream(fp, filename, &data, &size)){
+        fclose(fp);
+        return false;
+    }
+
+    fclose(fp);
+    *mapping = mapping_new(data, size, false);
+
+    return true;
+}
+
+// text files are converted into binary image, so they can be accessed by the same view
+static filelib_mapping_t *mapping_encode(void *data, binary_writing_loop_t *binary_writing_loop){
+    binary_buffer_t *buffer = NULL;
+    filelib_mapping_t *mapping = NULL;
+
+    binary_buffer_init(&buffer);
+    (*binary_writing_loop)(data, buffer);
+
+    mapping = mapping_new(buffer->data, buffer->size, false);
+    buffer->data = NULL;
+
+    binary_buffer_destroy(buffer);
+
+    return mapping;
+}
+
+//-----------------------------------
+// Object view
+
+static bool open_obj_view(char *filename, obj_view_t **view){
+    CHECK_NULL_ARGUMENT(filename);
+    CHECK_NULL_ARGUMENT(view);
+    CHECK_NOT_NULL_ARGUMENT(*view);
+
+    filelib_mapping_t *mapping = NULL;
+    FILE *fp = NULL;
+    bool binary = false;
+
+    if(!_open_file(filename, &fp, &binary)){
+        return false;
+    }
+
+    if(binary == true){
+        if(!mapping_open(fp, filename, &mapping)){
+            return false;
+        }
+    }
+    else{
+        obj_file_t *obj = NULL;
+
+        if(!_load_stream(fp, filename, false, (void **)&obj, &check_structure_obj, &loading_loop_obj, &binary_loading_loop_obj)){
+            return false;
+        }
+
+        mapping = mapping_encode((void *)obj, &binary_writing_loop_obj);
+        obj_file_destroy(obj);
+    }
+
+    *view = (obj_view_t *)dynmem_calloc(1, sizeof(obj_view_t));
+
+    (*view)->filename = dynmem_strdup(filename);
+    (*view)->mapping = mapping;
+
+    if(!binary_obj_view_init(*view, mapping->data, mapping->size, filename)){
+        obj_view_close(*view);
+        *view = NULL;
+        return false;
+    }
+
+    return true;
+}
+
+bool obj_view_open_ctx(filelib_ctx_t *ctx, char *filename, obj_view_t **view){
+    filelib_scope_t scope = _filelib_ctx_enter(ctx);
+    bool retVal = open_obj_view(filename, view);
+
+    _filelib_ctx_leave(scope);
+
+    return retVal;
+}
+
+bool obj_view_open(char *filename, obj_view_t **view){
+    return obj_view_open_ctx(NULL, filename, view);
+}
+
+void obj_view_close(obj_view_t *view){
+    if(view == NULL)
+        return;
+
+    mapping_release(view->mapping);
+
+    if(view->filename != NULL){
+        dynmem_free(view->filename);
+    }
+
+    dynmem_free(view);
+}
+
+void obj_view_section(obj_view_t *view, unsigned index, obj_section_view_t *section){
+    CHECK_NULL_ARGUMENT(view);
+    CHECK_NULL_ARGUMENT(section);
+
+    if(index >= view->section_count){
+        error("Requesting section %u of object file %s with only %u sections!", index, view->filename, view->section_count);
+    }
+
+    uint8_t *record = view->section_table + index * SECTION_RECORD_SIZE;
+
+    section->section_name = view->string_table + binary_get_u32(record + SECTION_RECORD_NAME);
+    section->exported_count = binary_get_u32(record + SECTION_RECORD_EXPORT_COUNT);
+    section->imported_count = binary_get_u32(record + SECTION_RECORD_IMPORT_COUNT);
+    section->data_count = binary_get_u32(record + SECTION_RECORD_DATA_COUNT);
+    section->exported = view->symbol_table + binary_get_u32(record + SECTION_RECORD_EXPORT_FIRST) * SYMBOL_RECORD_SIZE;
+    section->imported = view->symbol_table + binary_get_u32(record + SECTION_RECORD_IMPORT_FIRST) * SYMBOL_RECORD_SIZE;
+    section->data = view->data_table + binary_get_u32(record + SECTION_RECORD_DATA_FIRST) * DATA_RECORD_SIZE;
+}
+
+static void view_symbol(obj_view_t *view, uint8_t *record, obj_symbol_t *symbol){
+    symbol->name = view->string_table + binary_get_u32(record + SYMBOL_RECORD_NAME);
+    symbol->value = (isa_address_t)binary_get_le(record + SYMBOL_RECORD_VALUE, ADDRESS_WIDTH);
+}
+
+void obj_view_exported_symbol(obj_view_t *view, obj_section_view_t *section, unsigned index, obj_symbol_t *symbol){
+    CHECK_NULL_ARGUMENT(view);
+    CHECK_NULL_ARGUMENT(section);
+    CHECK_NULL_ARGUMENT(symbol);
+
+    if(index >= section->exported_count){
+        error("Requesting exported symbol %u out of %u in section %s!", index, section->exported_count, section->section_name);
+    }
+
+    view_symbol(view, section->exported + index * SYMBOL_RECORD_SIZE, symbol);
+}
+
+void obj_view_imported_symbol(obj_view_t *view, obj_section_view_t *section, unsigned index, obj_symbol_t *symbol){
+    CHECK_NULL_ARGUMENT(view);
+    CHECK_NULL_ARGUMENT(section);
+    CHECK_NULL_ARGUMENT(symbol);
+
+    if(index >= section->imported_count){
+        error("Requesting imported symbol %u out of %u in section %s!", index, section->imported_count, section->section_name);
+    }
+
+    view_symbol(view, section->imported + index * SYMBOL_RECORD_SIZE, symbol);
+}
+
+void obj_view_data(obj_section_view_t *section, unsigned index, obj_data_t *data){
+    CHECK_NULL_ARGUMENT(section);
+    CHECK_NULL_ARGUMENT(data);
+
+    if(index >= section->data_count){
+        error("Requesting data %u out of %u in section %s!", index, section->data_count, section->section_name);
+    }
+
+    uint8_t *record = section->data + index * DATA_RECORD_SIZE;
+    uint8_t flags = record[DATA_RECORD_FLAGS];
+    uintmax_t payload = binary_get_le(record + DATA_RECORD_PAYLOAD, WORD_WIDTH);
+
+    data->address = (isa_address_t)binary_get_le(record + DATA_RECORD_ADDRESS, ADDRESS_WIDTH);
+    data->special_value = (isa_address_t)binary_get_le(record + DATA_RECORD_SPECIAL_VALUE, ADDRESS_WIDTH);
+    data->blob = (flags & DATA_FLAG_BLOB) ? true : false;
+    data->relocation = (flags & DATA_FLAG_RELOCATION) ? true : false;
+    data->special = (flags & DATA_FLAG_SPECIAL) ? true : false;
+
+    if(data->blob == true){
+        data->payload.blob_value = (isa_memory_element_t)payload;
+    }
+    else{
+        data->payload.data_value = (isa_instruction_word_t)payload;
+    }
+}
+
+void obj_view_to_file(obj_view_t *view, obj_file_t **f){
+    CHECK_NULL_ARGUMENT(view);
+    CHECK_NULL_ARGUMENT(f);
+    CHECK_NOT_NULL_ARGUMENT(*f);
+
+    obj_file_new(f);
+
+    for(unsigned i = 0; i < view->section_count; i++){
+        obj_section_view_t section_view;
+        obj_section_t *section = NULL;
+
+        obj_view_section(view, i, &section_view);
+        obj_section_new(section_view.section_name, &section);
+
+        for(unsigned j = 0; j < section_view.exported_count; j++){
+            obj_symbol_t symbol;
+            obj_symbol_t *new = NULL;
+
+            obj_view_exported_symbol(view, &section_view, j, &symbol);
+            obj_symbol_new(&new, symbol.name, symbol.value);
+            obj_exported_symbol_into_section(section, new);
+        }
+
+        for(unsigned j = 0; j < section_view.imported_count; j++){
+            obj_symbol_t symbol;
+            obj_symbol_t *new = NULL;
+
+            obj_view_imported_symbol(view, &section_view, j, &symbol);
+            obj_symbol_new(&new, symbol.name, symbol.value);
+            obj_imported_symbol_into_section(section, new);
+        }
+
+        for(unsigned j = 0; j < section_view.data_count; j++){
+            obj_data_t data;
+            obj_data_t *new = NULL;
+
+            obj_view_data(&section_view, j, &data);
+
+            if(data.blob == true){
+                obj_blob_new(&new, data.address, data.payload.blob_value);
+            }
+            else{
+                obj_data_new(&new, data.address, data.payload.data_value, data.relocation, data.special, data.special_value);
+            }
+
+            obj_data_into_section(section, new);
+        }
+
+        obj_section_into_file(*f, section);
+    }
+}
+
+//-----------------------------------
+// Static library view
+
+static bool open_sl_view(char *filename, sl_view_t **view){
+    CHECK_NULL_ARGUMENT(filename);
+    CHECK_NULL_ARGUMENT(view);
+    CHECK_NOT_NULL_ARGUMENT(*view);
+
+    filelib_mapping_t *mapping = NULL;
+    FILE *fp = NULL;
+    bool binary = false;
+
+    if(!_open_file(filename, &fp, &binary)){
+        return false;
+    }
+
+    if(binary == true){
+        if(!mapping_open(fp, filename, &mapping)){
+            return false;
+        }
+    }
+    else{
+        sl_index_t *index = NULL;
+        bool missing = false;
+
+        //only index in front of members is read, members are parsed when they are opened
+        if(_sl_load_index_stream(fp, filename, false, &index, &missing)){
+            *view = (sl_view_t *)dynmem_calloc(1, sizeof(sl_view_t));
+
+            (*view)->filename = dynmem_strdup(filename);
+            (*view)->index = index;
+            (*view)->target_arch_name = index->target_arch_name;
+            (*view)->member_count = index->member_count;
+            (*view)->indexed = true;
+            (*view)->symbol_count = index->symbol_count;
+
+            return true;
+        }
+
+        if(missing == false){
+            return false;
+        }
+
+        //libraries written before symbol index was introduced are loaded whole
+        sl_file_t *sl = NULL;
+
+        if(!sl_load(filename, &sl)){
+            return false;
+        }
+
+        mapping = mapping_encode((void *)sl, &binary_writing_loop_sl);
+        sl_file_destroy(sl);
+    }
+
+    *view = (sl_view_t *)dynmem_calloc(1, sizeof(sl_view_t));
+
+    (*view)->filename = dynmem_strdup(filename);
+    (*view)->mapping = mapping;
+
+    if(!binary_sl_view_init(*view, mapping->data, mapping->size, filename)){
+        sl_view_close(*view);
+        *view = NULL;
+        return false;
+    }
+
+    return true;
+}
+
+bool sl_view_open_ctx(filelib_ctx_t *ctx, char *filename, sl_view_t **view){
+    filelib_scope_t scope = _filelib_ctx_enter(ctx);
+    bool retVal = open_sl_view(filename, view);
+
+    _filelib_ctx_leave(scope);
+
+    return retVal;
+}
+
+bool sl_view_open(char *filename, sl_view_t **view){
+    return sl_view_open_ctx(NULL, filename, view);
+}
+
+void sl_view_close(sl_view_t *view){
+    if(view == NULL)
+        return;
+
+    mapping_release(view->mapping);
+    sl_index_destroy(view->index);
+
+    if(view->filename != NULL){
+        dynmem_free(view->filename);
+    }
+
+    dynmem_free(view);
+}
+
+char *sl_view_member_name(sl_view_t *view, unsigned index){
+    CHECK_NULL_ARGUMENT(view);
+
+    if(index >= view->member_count){
+        error("Requesting member %u of library %s with only %u members!", index, view->filename, view->member_count);
+    }
+
+    if(view->index != NULL){
+        return view->index->members[index].name;
+    }
+
+    return view->string_table + binary_get_u32(view->member_table + index * MEMBER_RECORD_SIZE + MEMBER_RECORD_NAME);
+}
+
+static bool open_sl_view_member(sl_view_t *view, unsigned index, obj_view_t **member){
+    CHECK_NULL_ARGUMENT(view);
+    CHECK_NULL_ARGUMENT(member);
+    CHECK_NOT_NULL_ARGUMENT(*member);
+
+    //member of text library is parsed alone and converted into its own image
+    if(view->index != NULL){
+        obj_file_t *obj = NULL;
+
+        if(!sl_load_member(view->index, index, &obj)){
+            return false;
+        }
+
+        *member = (obj_view_t *)dynmem_calloc(1, sizeof(obj_view_t));
+
+        (*member)->filename = dynmem_strdup(view->filename);
+        (*member)->mapping = mapping_encode((void *)obj, &binary_writing_loop_obj);
+        obj_file_destroy(obj);
+
+        if(!binary_obj_view_init(*member, (*member)->mapping->data, (*member)->mapping->size, view->filename)){
+            obj_view_close(*member);
+            *member = NULL;
+            return false;
+        }
+
+        return true;
+    }
+
+    *member = (obj_view_t *)dynmem_calloc(1, sizeof(obj_view_t));
+
+    (*member)->filename = dynmem_strdup(view->filename);
+
+    if(view->mapping != NULL){
+        view->mapping->references++;
+        (*member)->mapping = view->mapping;
+    }
+
+    if(!binary_sl_view_member_init(view, index, *member)){
+        obj_view_close(*member);
+        *member = NULL;
+        return false;
+    }
+
+    return true;
+}
+
+bool sl_view_member_ctx(filelib_ctx_t *ctx, sl_view_t *view, unsigned index, obj_view_t **member){
+    filelib_scope_t scope = _filelib_ctx_enter(ctx);
+    bool retVal = open_sl_view_member(view, index, member);
+
+    _filelib_ctx_leave(scope);
+
+    return retVal;
+}
+
+bool sl_view_member(sl_view_t *view, unsigned index, obj_view_t **member){
+    return sl_view_member_ctx(NULL, view, index, member);
+}
+
+void sl_view_symbol(sl_view_t *view, unsigned index, sl_index_symbol_t *symbol){
+    CHECK_NULL_ARGUMENT(view);
+    CHECK_NULL_ARGUMENT(symbol);
+
+    if(index >= view->symbol_count){
+        error("Requesting symbol %u of library %s with only %u symbols!", index, view->filename, view->symbol_count);
+    }
+
+    if(view->index != NULL){
+        *symbol = view->index->symbols[index];
+        return;
+    }
+
+    uint8_t *record = view->symbol_table + index * SL_SYMBOL_RECORD_SIZE;
+
+    symbol->name = view->string_table + binary_get_u32(record + SL_SYMBOL_RECORD_NAME);
+    symbol->member = binary_get_u32(record + SL_SYMBOL_RECORD_MEMBER);
+}
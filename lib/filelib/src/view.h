@@ -0,0 +1,78 @@
+#ifndef FILELIB_VIEW_H_included
+#define FILELIB_VIEW_H_included
+
+#include "obj.h"
+#include "sl.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+typedef struct filelib_mapping_s filelib_mapping_t;
+
+// read only view into object image, everything is decoded on access
+typedef struct{
+    char *filename;
+    filelib_mapping_t *mapping;
+    uint8_t *image;
+    size_t image_size;
+    char *target_arch_name;
+    char *string_table;
+    unsigned section_count;
+    uint8_t *section_table;
+    uint8_t *symbol_table;
+    uint8_t *data_table;
+} obj_view_t;
+
+typedef struct{
+    char *section_name;
+    unsigned exported_count;
+    unsigned imported_count;
+    unsigned data_count;
+    uint8_t *exported;
+    uint8_t *imported;
+    uint8_t *data;
+} obj_section_view_t;
+
+// read only view into static library, members are opened on request
+typedef struct{
+    char *filename;
+    filelib_mapping_t *mapping;
+    uint8_t *image;
+    size_t image_size;
+    char *target_arch_name;
+    char *string_table;
+    unsigned member_count;
+    uint8_t *member_table;
+    bool indexed;
+    unsigned symbol_count;
+    uint8_t *symbol_table;
+    // text library is read through its symbol index, there is no image then
+    // and every member is parsed only when it is opened
+    sl_index_t *index;
+} sl_view_t;
+
+bool obj_view_open(char *filename, obj_view_t **view);
+void obj_view_close(obj_view_t *view);
+void obj_view_to_file(obj_view_t *view, obj_file_t **f);
+
+void obj_view_section(obj_view_t *view, unsigned index, obj_section_view_t *section);
+void obj_view_exported_symbol(obj_view_t *view, obj_section_view_t *section, unsigned index, obj_symbol_t *symbol);
+void obj_view_imported_symbol(obj_view_t *view, obj_section_view_t *section, unsigned index, obj_symbol_t *symbol);
+void obj_view_data(obj_section_view_t *section, unsigned index, obj_data_t *data);
+
+bool sl_view_open(char *filename, sl_view_t **view);
+void sl_view_close(sl_view_t *view);
+char *sl_view_member_name(sl_view_t *view, unsigned index);
+bool sl_view_member(sl_view_t *view, unsigned index, obj_view_t **member);
+
+// libraries written with symbol index (indexed is true) carry table of
+// exported symbols ordered by members, so they can be searched without
+// opening members
+void sl_view_symbol(sl_view_t *view, unsigned index, sl_index_symbol_t *symbol);
+
+bool obj_view_open_ctx(filelib_ctx_t *ctx, char *filename, obj_view_t **view);
+bool sl_view_open_ctx(filelib_ctx_t *ctx, char *filename, sl_view_t **view);
+bool sl_view_member_ctx(filelib_ctx_t *ctx, sl_view_t *view, unsigned index, obj_view_t **member);
+
+#endif
@@ -0,0 +1,178 @@
+#include "_filelib.h"
+
+static void writer_new(writer_t **writer, bool memory){
+    size_t capacity = WRITER_MEMORY_BUFFER_SIZE + 1;
+
+    *writer = (writer_t *)dynmem_malloc(sizeof(writer_t));
+
+    //memory writer owns its buffer, it is grown as needed
+    if(memory == true){
+        (*writer)->buffer = (char *)dynmem_malloc(capacity);
+    }
+    else{
+        (*writer)->buffer = (char *)_filelib_scratch_take(FILELIB_SCRATCH_WRITER, WRITER_BUFFER_SIZE + 1, &capacity);
+    }
+
+    (*writer)->fp = NULL;
+    (*writer)->string = NULL;
+    (*writer)->memory = memory;
+    (*writer)->size = 0;
+    (*writer)->capacity = capacity - 1;
+    (*writer)->written = 0;
+    (*writer)->error = false;
+}
+
+void writer_new_stream(writer_t **writer, FILE *fp){
+    CHECK_NULL_ARGUMENT(writer);
+    CHECK_NOT_NULL_ARGUMENT(*writer);
+    CHECK_NULL_ARGUMENT(fp);
+
+    writer_new(writer, false);
+    (*writer)->fp = fp;
+}
+
+void writer_new_string(writer_t **writer, string_t *output){
+    CHECK_NULL_ARGUMENT(writer);
+    CHECK_NOT_NULL_ARGUMENT(*writer);
+    CHECK_NULL_ARGUMENT(output);
+
+    writer_new(writer, false);
+    (*writer)->string = output;
+}
+
+void writer_new_memory(writer_t **writer){
+    CHECK_NULL_ARGUMENT(writer);
+    CHECK_NOT_NULL_ARGUMENT(*writer);
+
+    writer_new(writer, true);
+}
+
+void writer_destroy(writer_t *writer){
+    CHECK_NULL_ARGUMENT(writer);
+
+    if(writer->memory == true){
+        dynmem_free(writer->buffer);
+    }
+    else{
+        _filelib_scratch_give(FILELIB_SCRATCH_WRITER, writer->buffer, writer->capacity + 1);
+    }
+
+    dynmem_free(writer);
+}
+
+// move buffered data into output without flushing the stream itself
+static void writer_drain(writer_t *writer){
+    if(writer->size == 0 || writer->memory == true)
+        return;
+
+    if(writer->fp != NULL){
+        if(fwrite(writer->buffer, 1, writer->size, writer->fp) != writer->size){
+            writer->error = true;
+        }
+    }
+    else if(writer->string != NULL){
+        writer->buffer[writer->size] = '\0';
+        string_append(writer->string, writer->buffer);
+    }
+
+    writer->size = 0;
+}
+
+bool writer_flush(writer_t *writer){
+    CHECK_NULL_ARGUMENT(writer);
+
+    writer_drain(writer);
+
+    if(writer->fp != NULL && fflush(writer->fp) != 0){
+        writer->error = true;
+    }
+
+    return !writer->error;
+}
+
+static void writer_grow(writer_t *writer, size_t length){
+    size_t capacity = writer->capacity * 2;
+
+    while(capacity - writer->size < length){
+        capacity *= 2;
+    }
+
+    char *tmp = (char *)dynmem_malloc(capacity + 1);
+
+    memcpy(tmp, writer->buffer, writer->size);
+    dynmem_free(writer->buffer);
+
+    writer->buffer = tmp;
+    writer->capacity = capacity;
+}
+
+static void writer_append_span(writer_t *writer, char *s, size_t length){
+    if(writer->memory == true && writer->capacity - writer->size < length){
+        writer_grow(writer, length);
+    }
+
+    while(length > 0){
+        if(writer->size == writer->capacity){
+            writer_drain(writer);
+        }
+
+        size_t chunk = writer->capacity - writer->size;
+
+        if(chunk > length){
+            chunk = length;
+        }
+
+        memcpy(writer->buffer + writer->size, s, chunk);
+        writer->size += chunk;
+        writer->written += chunk;
+        s += chunk;
+        length -= chunk;
+    }
+}
+
+void writer_append(writer_t *writer, char *s){
+    CHECK_NULL_ARGUMENT(writer);
+    CHECK_NULL_ARGUMENT(s);
+
+    writer_append_span(writer, s, strlen(s));
+}
+
+void writer_append_char(writer_t *writer, char c){
+    CHECK_NULL_ARGUMENT(writer);
+
+    writer_append_span(writer, &c, 1);
+}
+
+void writer_append_data(writer_t *writer, char *data, size_t size){
+    CHECK_NULL_ARGUMENT(writer);
+    CHECK_NULL_ARGUMENT(data);
+
+    writer_append_span(writer, data, size);
+}
+
+void writer_append_address(writer_t *writer, isa_address_t value){
+    CHECK_NULL_ARGUMENT(writer);
+
+    char tmp[PLATFORMLIB_FORMAT_BUFFER_SIZE];
+    unsigned length = platformlib_format_isa_address(value, tmp, sizeof(tmp));
+
+    writer_append_span(writer, tmp, length);
+}
+
+void writer_append_instruction_word(writer_t *writer, isa_instruction_word_t value){
+    CHECK_NULL_ARGUMENT(writer);
+
+    char tmp[PLATFORMLIB_FORMAT_BUFFER_SIZE];
+    unsigned length = platformlib_format_isa_instruction_word(value, tmp, sizeof(tmp));
+
+    writer_append_span(writer, tmp, length);
+}
+
+void writer_append_memory_element(writer_t *writer, isa_memory_element_t value){
+    CHECK_NULL_ARGUMENT(writer);
+
+    char tmp[PLATFORMLIB_FORMAT_BUFFER_SIZE];
+    unsigned length = platformlib_format_isa_memory_element(value, tmp, sizeof(tmp));
+
+    writer_append_span(writer, tmp, length);
+}
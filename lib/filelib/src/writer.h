@@ -0,0 +1,46 @@
+#ifndef FILELIB_WRITER_H_included
+#define FILELIB_WRITER_H_included
+
+#include <utillib/core.h>
+#include <utillib/utils.h>
+#include <platformlib.h>
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+
+#define WRITER_BUFFER_SIZE (64 * 1024)
+#define WRITER_MEMORY_BUFFER_SIZE 4096
+
+// records are appended into fixed buffer which is flushed into stream by
+// fwrite (or into string) once it is full, so output is never built whole,
+// only memory writer keeps growing its buffer and holds whole output there
+typedef struct{
+    FILE *fp;
+    string_t *string;
+    char *buffer;
+    size_t size;
+    size_t capacity;
+    size_t written;
+    bool memory;
+    bool error;
+} writer_t;
+
+void writer_new_stream(writer_t **writer, FILE *fp);
+void writer_new_string(writer_t **writer, string_t *output);
+// output is kept in buffer, its first size bytes are valid until writer is destroyed
+void writer_new_memory(writer_t **writer);
+void writer_destroy(writer_t *writer);
+
+// returns false if any write into stream failed
+bool writer_flush(writer_t *writer);
+
+void writer_append(writer_t *writer, char *s);
+void writer_append_char(writer_t *writer, char c);
+// append data as they are, used for copying already formatted records
+void writer_append_data(writer_t *writer, char *data, size_t size);
+void writer_append_address(writer_t *writer, isa_address_t value);
+void writer_append_instruction_word(writer_t *writer, isa_instruction_word_t value);
+void writer_append_memory_element(writer_t *writer, isa_memory_element_t value);
+
+#endif
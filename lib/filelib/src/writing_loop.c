@@ -1,145 +1,293 @@
 #include "_filelib.h"
 
-bool writing_loop_ldm(void *input, string_t *output){
+#define LDM_RUN_MAX_COUNT 64
+
+// consecutive elements are written as single ".run address count values..." record
+typedef struct{
+    writer_t *output;
+    isa_address_t address;
+    unsigned count;
+    isa_memory_element_t words[LDM_RUN_MAX_COUNT];
+} ldm_run_t;
+
+static void flush_run(ldm_run_t *run){
+    if(run->count == 0){
+        return;
+    }
+
+    char count[16];
+    snprintf(count, sizeof(count), "%u", run->count);
+
+    writer_append(run->output, ".run ");
+    writer_append_address(run->output, run->address);
+    writer_append_char(run->output, ' ');
+    writer_append(run->output, count);
+
+    for(unsigned i = 0; i < run->count; i++){
+        writer_append_char(run->output, ' ');
+        writer_append_memory_element(run->output, run->words[i]);
+    }
+
+    writer_append(run->output, "\r\n");
+    run->count = 0;
+}
+
+static void append_run_element(isa_address_t address, isa_memory_element_t word, void *context){
+    ldm_run_t *run = (ldm_run_t *)context;
+
+    if(run->count == LDM_RUN_MAX_COUNT || (run->count > 0 && address != (isa_address_t)(run->address + run->count))){
+        flush_run(run);
+    }
+
+    if(run->count == 0){
+        run->address = address;
+    }
+
+    run->words[run->count++] = word;
+}
+
+bool writing_loop_ldm(void *input, writer_t *output){
     CHECK_NULL_ARGUMENT(input);
     CHECK_NULL_ARGUMENT(output);
 
     ldm_file_t *_data = (ldm_file_t *)input;
 
-    string_appendf(output, "%s\r\n", ".ldm");
-    string_appendf(output, "%s %s\r\n", ".arch", _data->target_arch_name);
+    writer_append(output, ".ldm\r\n");
 
-    char *entry_point = platformlib_write_isa_address(_data->entry_point);
-    string_appendf(output, "%s %s\r\n", ".entry", entry_point);
-    dynmem_free(entry_point);
-    entry_point = NULL;
+    writer_append(output, ".arch ");
+    writer_append(output, _data->target_arch_name);
+    writer_append(output, "\r\n");
+
+    writer_append(output, ".entry ");
+    writer_append_address(output, _data->entry_point);
+    writer_append(output, "\r\n");
 
     for(unsigned i = 0; i < list_count(_data->memories); i++){
         ldm_memory_t *head_mem = NULL;
         list_at(_data->memories, i, (void *)&head_mem);
 
-        char *memory_origin = platformlib_write_isa_address(head_mem->begin_addr);
-        char *memory_size = platformlib_write_isa_address(head_mem->size);
-
-        string_appendf(output, "%s %s %s %s\r\n", ".mem", head_mem->memory_name, memory_origin, memory_size);
-
-        dynmem_free(memory_origin);
-        dynmem_free(memory_size);
-
-        for(unsigned j = 0; j < list_count(head_mem->items); j++){
-            ldm_item_t *head_item = NULL;
-            list_at(head_mem->items, j, (void *)&head_item);
+        writer_append(output, ".mem ");
+        writer_append(output, head_mem->memory_name);
+        writer_append_char(output, ' ');
+        writer_append_address(output, head_mem->begin_addr);
+        writer_append_char(output, ' ');
+        writer_append_address(output, head_mem->size);
+        writer_append(output, "\r\n");
 
-            char *item_address = platformlib_write_isa_address(head_item->address);
-            char *item_value = platformlib_write_isa_memory_element(head_item->word);
+        ldm_run_t run;
 
-            string_appendf(output, "%s %s %s\r\n", ".item", item_address, item_value);
+        run.output = output;
+        run.count = 0;
 
-            dynmem_free(item_address);
-            dynmem_free(item_value);
-        }
+        ldm_mem_foreach(head_mem, &append_run_element, (void *)&run);
+        flush_run(&run);
     }
 
-    string_appendf(output, "%s\r\n", ".end");
+    writer_append(output, ".end\r\n");
     return true;
 }
 
-bool writing_loop_obj(void *input, string_t *output){
+bool writing_loop_obj(void *input, writer_t *output){
     CHECK_NULL_ARGUMENT(input);
     CHECK_NULL_ARGUMENT(output);
 
     obj_file_t *_data = (obj_file_t *)input;
 
-    string_appendf(output, ".object\r\n");
-    string_appendf(output, ".arch %s\r\n", _data->target_arch_name);
+    writer_append(output, ".object\r\n");
+
+    writer_append(output, ".arch ");
+    writer_append(output, _data->target_arch_name);
+    writer_append(output, "\r\n");
 
     for(unsigned i = 0; i < list_count(_data->section_list); i++){
         obj_section_t *section = NULL;
         list_at(_data->section_list, i, (void *)&section);
 
-        string_appendf(output, ".section %s\r\n", section->section_name);
+        writer_append(output, ".section ");
+        writer_append(output, section->section_name);
+        writer_append(output, "\r\n");
 
         for(unsigned j = 0; j < list_count(section->exported_symbol_list); j++){
             obj_symbol_t *symbol = NULL;
             list_at(section->exported_symbol_list, j, (void *)&symbol);
 
-            char *value = platformlib_write_isa_address(symbol->value);
-
-            string_appendf(output, ".export %s %s\r\n", symbol->name, value);
-
-            dynmem_free(value);
+            writer_append(output, ".export ");
+            writer_append(output, symbol->name);
+            writer_append_char(output, ' ');
+            writer_append_address(output, symbol->value);
+            writer_append(output, "\r\n");
         }
 
         for(unsigned j = 0; j < list_count(section->imported_symbol_list); j++){
             obj_symbol_t *symbol = NULL;
             list_at(section->imported_symbol_list, j, (void *)&symbol);
 
-            char *value = platformlib_write_isa_address(symbol->value);
-
-            string_appendf(output, ".import %s %s\r\n", symbol->name, value);
-
-            dynmem_free(value);
+            writer_append(output, ".import ");
+            writer_append(output, symbol->name);
+            writer_append_char(output, ' ');
+            writer_append_address(output, symbol->value);
+            writer_append(output, "\r\n");
         }
 
         for(unsigned j = 0; j < list_count(section->data_symbol_list); j++){
             obj_data_t *symbol = NULL;
             list_at(section->data_symbol_list, j, (void *)&symbol);
 
-            char *address = platformlib_write_isa_address(symbol->address);
-            char *value = NULL;
-
             if(symbol->blob == true){
-                value = platformlib_write_isa_memory_element(symbol->payload.blob_value);
-
-                string_appendf(output, ".blob %s %s\r\n", address, value);
+                writer_append(output, ".blob ");
+                writer_append_address(output, symbol->address);
+                writer_append_char(output, ' ');
+                writer_append_memory_element(output, symbol->payload.blob_value);
             }
             else{
-                value = platformlib_write_isa_instruction_word(symbol->payload.data_value);
-                char *relocation = symbol->relocation ? "1" : "0";
-                char *special = symbol->special ? "1" : "0";
-                char *special_value = platformlib_write_isa_address(symbol->special_value);
-
-                string_appendf(output, ".data %s %s %s %s %s\r\n", address, value, special_value, relocation, special);
-
-                dynmem_free(special_value);
+                writer_append(output, ".data ");
+                writer_append_address(output, symbol->address);
+                writer_append_char(output, ' ');
+                writer_append_instruction_word(output, symbol->payload.data_value);
+                writer_append_char(output, ' ');
+                writer_append_address(output, symbol->special_value);
+                writer_append(output, symbol->relocation ? " 1" : " 0");
+                writer_append(output, symbol->special ? " 1" : " 0");
             }
 
-            dynmem_free(address);
-            dynmem_free(value);
+            writer_append(output, "\r\n");
         }
     }
 
-    string_appendf(output, "%s\r\n", ".end");
+    writer_append(output, ".end\r\n");
     return true;
 }
 
-bool writing_loop_sl(void *input, string_t *output){
+// object member is formatted only once, into memory, so its size is known
+// before index is written and the text is then just copied into output
+static bool format_sl_member(sl_member_t *member, writer_t **formatted){
+    writer_new_memory(formatted);
+
+    writer_append(*formatted, ".file ");
+    writer_append(*formatted, member->name);
+    writer_append(*formatted, "\r\n");
+
+    return writing_loop_obj(member->object, *formatted);
+}
+
+// size of ".member name offset" record followed by ".symbol name" record of every export
+static size_t sl_index_size(sl_member_t *member){
+    size_t size = strlen(".member ") + strlen(member->name) + 1 + SL_INDEX_OFFSET_WIDTH + 2;
+
+    for(unsigned i = 0; i < member->symbol_count; i++){
+        size += strlen(".symbol ") + strlen(member->symbols[i].name) + 2;
+    }
+
+    return size;
+}
+
+static void write_sl_index(writer_t *output, sl_member_t *member, size_t offset){
+    char tmp[32];
+    snprintf(tmp, sizeof(tmp), SL_INDEX_OFFSET_FORMAT, (unsigned long)offset);
+
+    writer_append(output, ".member ");
+    writer_append(output, member->name);
+    writer_append_char(output, ' ');
+    writer_append(output, tmp);
+    writer_append(output, "\r\n");
+
+    for(unsigned i = 0; i < member->symbol_count; i++){
+        writer_append(output, ".symbol ");
+        writer_append(output, member->symbols[i].name);
+        writer_append(output, "\r\n");
+    }
+}
+
+bool writing_loop_sl_members(void *input, writer_t *output){
     CHECK_NULL_ARGUMENT(input);
     CHECK_NULL_ARGUMENT(output);
 
-    sl_file_t *_data = (sl_file_t *)input;
+    sl_members_t *_data = (sl_members_t *)input;
+    size_t *offsets = (size_t *)dynmem_calloc(_data->count + 1, sizeof(size_t));
+    writer_t **formatted = (writer_t **)dynmem_calloc(_data->count + 1, sizeof(writer_t *));
+    size_t offset = output->written;
+    bool retVal = true;
+
+    //offsets of members have to be known before index is written, offset
+    //field has fixed width so size of the index itself can be counted too
+    offset += strlen(".sl\r\n") + strlen(".arch ") + strlen(_data->target_arch_name) + 2;
 
-    string_appendf(output, "%s\r\n", ".sl");
-    string_appendf(output, "%s %s\r\n", ".arch", _data->target_arch_name);
+    for(unsigned i = 0; i < _data->count; i++){
+        offset += sl_index_size(&(_data->members[i]));
+    }
 
-    for(unsigned i = 0; i < list_count(_data->objects); i++){
-        sl_holder_t *head = NULL;
-        string_t *tmp = NULL;
+    for(unsigned i = 0; i < _data->count; i++){
+        sl_member_t *member = &(_data->members[i]);
 
-        list_at(_data->objects, i, (void *)&head);
+        offsets[i] = offset;
 
-        string_init(&tmp);
-        if(!writing_loop_obj(head->object, tmp)){
+        //copied member already starts with its .file record
+        if(member->object == NULL){
+            offset += member->payload_size;
+        }
+        else if(format_sl_member(member, &(formatted[i]))){
+            offset += formatted[i]->size;
+        }
+        else{
             FILELIB_ERROR_WRITE("Error writing out object file from library.");
-            return false;
+            retVal = false;
+            break;
+        }
+    }
+
+    if(retVal == true && _data->count > 0 && offsets[_data->count - 1] > SL_INDEX_OFFSET_MAX){
+        FILELIB_ERROR_WRITE("Library is too large to be written in text format!");
+        retVal = false;
+    }
+
+    if(retVal == true){
+        writer_append(output, ".sl\r\n");
+
+        writer_append(output, ".arch ");
+        writer_append(output, _data->target_arch_name);
+        writer_append(output, "\r\n");
+
+        for(unsigned i = 0; i < _data->count; i++){
+            write_sl_index(output, &(_data->members[i]), offsets[i]);
+        }
+
+        for(unsigned i = 0; i < _data->count; i++){
+            sl_member_t *member = &(_data->members[i]);
+
+            if(member->object == NULL){
+                writer_append_data(output, (char *)member->payload, member->payload_size);
+            }
+            else{
+                writer_append_data(output, formatted[i]->buffer, formatted[i]->size);
+            }
         }
 
-        string_appendf(output, ".file %s\r\n", head->object_name);
-        string_concatenate(output, tmp);
+        writer_append(output, ".end\r\n");
+    }
 
-        string_destroy(tmp);
+    for(unsigned i = 0; i < _data->count; i++){
+        if(formatted[i] != NULL){
+            writer_destroy(formatted[i]);
+        }
     }
 
-    string_appendf(output, "%s\r\n", ".end");
-    return true;
+    dynmem_free(formatted);
+    dynmem_free(offsets);
+
+    return retVal;
+}
+
+bool writing_loop_sl(void *input, writer_t *output){
+    CHECK_NULL_ARGUMENT(input);
+    CHECK_NULL_ARGUMENT(output);
+
+    sl_members_t members;
+
+    _sl_members_from_file(&members, (sl_file_t *)input);
+
+    bool retVal = writing_loop_sl_members((void *)&members, output);
+
+    _sl_members_release(&members);
+
+    return retVal;
 }
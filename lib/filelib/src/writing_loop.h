@@ -1,12 +1,16 @@
 #ifndef FILELIB_WRITING_LOOP_H_included
 #define FILELIB_WRITING_LOOP_H_included
 
-#include <utillib/utils.h>
+#include "writer.h"
 
-typedef bool (writing_loop_t)(void *input, string_t *output);
+#include <stdbool.h>
+
+typedef bool (writing_loop_t)(void *input, writer_t *output);
 
 writing_loop_t writing_loop_ldm;
 writing_loop_t writing_loop_obj;
 writing_loop_t writing_loop_sl;
+// input is sl_members_t, used when library is updated
+writing_loop_t writing_loop_sl_members;
 
 #endif
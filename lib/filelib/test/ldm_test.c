@@ -8,9 +8,15 @@
 #include <filelib.h>
 #include <utillib/cli.h>
 
-static bool generate_test(ldm_test_settings_t *settings, int argc, char **argv){
-    UNUSED(settings);
+static bool write_file(ldm_test_settings_t *settings, ldm_file_t *f, char *filename){
+    if(settings->binary == true){
+        return ldm_write_binary(f, filename);
+    }
+
+    return ldm_write(f, filename);
+}
 
+static bool generate_test(ldm_test_settings_t *settings, int argc, char **argv){
     if(!requested_arguments_exact(argc, 1)){
         return false;
     }
@@ -30,9 +36,23 @@ static bool generate_test(ldm_test_settings_t *settings, int argc, char **argv){
     ldm_item_into_mem(mem, item_1);
     ldm_item_into_mem(mem, item_2);
     ldm_mem_into_file(file, mem);
+
+    mem = NULL;
+    ldm_mem_new_image("RAM_1", &mem, 16, 0x100);
+    ldm_mem_set(mem, 0x100, 1);
+    ldm_mem_set(mem, 0x101, 2);
+    ldm_mem_set(mem, 0x10F, 3);
+    ldm_mem_into_file(file, mem);
+
+    if(ldm_mem_set(mem, 0x101, 2)){
+        printf("Element written twice at 0x101 isn't reported!\r\n");
+        ldm_file_destroy(file);
+        return false;
+    }
+
     ldm_file_set_entry(file, 10);
 
-    if(!ldm_write(file, filename)){
+    if(!write_file(settings, file, filename)){
         printf("%s\r\n", filelib_error());
         return false;
     }
@@ -42,6 +62,33 @@ static bool generate_test(ldm_test_settings_t *settings, int argc, char **argv){
     return true;
 }
 
+typedef struct{
+    bool last_mem;
+    unsigned index;
+    unsigned count;
+} print_item_context_t;
+
+static void print_item(isa_address_t address, isa_memory_element_t word, void *context){
+    print_item_context_t *_context = (print_item_context_t *)context;
+
+    char *item_address = platformlib_write_isa_address(address);
+    char *item_value = platformlib_write_isa_instruction_word(word);
+
+    bool last_item = false;
+
+    if((++_context->index) == _context->count){
+        last_item = true;
+    }
+
+    char c1 = (_context->last_mem == true) ? ' ' : '|';
+    char c2 = (last_item == true) ? '\'' : '|';
+
+    printf(" %c       %c- addr: %s value: %s\r\n", c1, c2, item_address, item_value);
+
+    dynmem_free(item_address);
+    dynmem_free(item_value);
+}
+
 static bool print_test(ldm_test_settings_t *settings, int argc, char **argv){
     UNUSED(settings);
 
@@ -82,13 +129,13 @@ static bool print_test(ldm_test_settings_t *settings, int argc, char **argv){
             printf(" '- memory %s\r\n", head_mem->memory_name);
             printf("     |- size: %s\r\n", memory_size);
             printf("     |- origin: %s\r\n", memory_origin);
-            printf("     '- items (%u)\r\n", list_count(head_mem->items));
+            printf("     '- items (%u)\r\n", ldm_mem_count(head_mem));
         }
         else{
             printf(" |- memory %s\r\n", head_mem->memory_name);
             printf(" |   |- size: %s\r\n", memory_size);
             printf(" |   |- origin: %s\r\n", memory_origin);
-            printf(" |   '- items (%u)\r\n", list_count(head_mem->items));
+            printf(" |   '- items (%u)\r\n", ldm_mem_count(head_mem));
         }
 
         dynmem_free(memory_origin);
@@ -97,30 +144,13 @@ static bool print_test(ldm_test_settings_t *settings, int argc, char **argv){
         memory_origin = NULL;
         memory_size = NULL;
 
-        for(unsigned j = 0; j < list_count(head_mem->items); j++){
-            ldm_item_t *head_item = NULL;
-            list_at(head_mem->items, j, (void *)&head_item);
-
-            char *item_address = platformlib_write_isa_address(head_item->address);
-            char *item_value = platformlib_write_isa_instruction_word(head_item->word);
-
-            bool last_item = false;
+        print_item_context_t context;
 
-            if((j + 1) == list_count(head_mem->items)){
-                last_item = true;
-            }
+        context.last_mem = last_mem;
+        context.index = 0;
+        context.count = ldm_mem_count(head_mem);
 
-            char c1 = (last_mem == true) ? ' ' : '|';
-            char c2 = (last_item == true) ? '\'' : '|';
-
-            printf(" %c       %c- addr: %s value: %s\r\n", c1, c2, item_address, item_value);
-
-            dynmem_free(item_address);
-            dynmem_free(item_value);
-
-            item_address = NULL;
-            item_value = NULL;
-        }
+        ldm_mem_foreach(head_mem, &print_item, (void *)&context);
     }
 
     ldm_file_destroy(ldm);
@@ -129,8 +159,6 @@ static bool print_test(ldm_test_settings_t *settings, int argc, char **argv){
 }
 
 static bool load_save_test(ldm_test_settings_t *settings, int argc, char **argv){
-    UNUSED(settings);
-
     if(!requested_arguments_exact(argc, 2)){
         return false;
     }
@@ -145,7 +173,7 @@ static bool load_save_test(ldm_test_settings_t *settings, int argc, char **argv)
         return false;
     }
 
-    if(!ldm_write(ldm, filename_output)){
+    if(!write_file(settings, ldm, filename_output)){
         printf("%s\r\n", filelib_error());
         ldm_file_destroy(ldm);
         return false;
@@ -160,10 +188,12 @@ void ldm_test_args_init(options_t *args, ldm_test_settings_t *settings){
     options_append_flag_2(args, "ldm-generate", "Generate one small ldm file.");
     options_append_flag_2(args, "ldm-print", "Print content of ldm file.");
     options_append_flag_2(args, "ldm-load-save", "Load ldm file and save it again as another file.");
+    options_append_flag_2(args, "ldm-binary", "Write output files in binary format.");
 
     settings->generate = false;
     settings->print = false;
     settings->load_save = false;
+    settings->binary = false;
 }
 
 void ldm_test_args_parse(options_t *args, ldm_test_settings_t *settings){
@@ -176,6 +206,9 @@ void ldm_test_args_parse(options_t *args, ldm_test_settings_t *settings){
     if(options_is_flag_set(args, "ldm-load-save")){
         settings->load_save = true;
     }
+    if(options_is_flag_set(args, "ldm-binary")){
+        settings->binary = true;
+    }
 }
 
 bool ldm_test_should_run(ldm_test_settings_t *settings){
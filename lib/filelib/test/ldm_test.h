@@ -8,6 +8,7 @@ typedef struct{
     bool generate;
     bool print;
     bool load_save;
+    bool binary;
 }ldm_test_settings_t;
 
 void ldm_test_args_init(options_t *args, ldm_test_settings_t *settings);
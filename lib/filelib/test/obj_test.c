@@ -8,9 +8,15 @@
 #include <filelib.h>
 #include <utillib/cli.h>
 
-static bool generate_test(obj_test_settings_t *settings, int argc, char **argv){
-    UNUSED(settings);
+static bool write_file(obj_test_settings_t *settings, obj_file_t *f, char *filename){
+    if(settings->binary == true){
+        return obj_write_binary(f, filename);
+    }
+
+    return obj_write(f, filename);
+}
 
+static bool generate_test(obj_test_settings_t *settings, int argc, char **argv){
     if(!requested_arguments_exact(argc, 1)){
         return false;
     }
@@ -66,7 +72,7 @@ static bool generate_test(obj_test_settings_t *settings, int argc, char **argv){
     obj_section_into_file(file, section_A);
     obj_section_into_file(file, section_B);
 
-    if(!obj_write(file, filename)){
+    if(!write_file(settings, file, filename)){
         printf("%s\r\n", filelib_error());
         obj_file_destroy(file);
         return false;
@@ -186,8 +192,6 @@ static bool print_test(obj_test_settings_t *settings, int argc, char **argv){
 }
 
 static bool load_save_test(obj_test_settings_t *settings, int argc, char **argv){
-    UNUSED(settings);
-
     if(!requested_arguments_exact(argc, 2)){
         return false;
     }
@@ -202,7 +206,7 @@ static bool load_save_test(obj_test_settings_t *settings, int argc, char **argv)
         return false;
     }
 
-    if(!obj_write(obj, filename_output)){
+    if(!write_file(settings, obj, filename_output)){
         obj_file_destroy(obj);
         printf("%s\r\n", filelib_error());
         return false;
@@ -218,10 +222,12 @@ void obj_test_args_init(options_t *args, obj_test_settings_t *settings){
     options_append_flag_2(args, "obj-generate", "Generate one small object file.");
     options_append_flag_2(args, "obj-print", "Print content of object file.");
     options_append_flag_2(args, "obj-load-save", "Load object file and save it again as another file.");
+    options_append_flag_2(args, "obj-binary", "Write output files in binary format.");
 
     settings->generate = false;
     settings->print = false;
     settings->load_save = false;
+    settings->binary = false;
 }
 
 void obj_test_args_parse(options_t *args, obj_test_settings_t *settings){
@@ -234,6 +240,9 @@ void obj_test_args_parse(options_t *args, obj_test_settings_t *settings){
     if(options_is_flag_set(args, "obj-load-save")){
         settings->load_save = true;
     }
+    if(options_is_flag_set(args, "obj-binary")){
+        settings->binary = true;
+    }
 }
 
 bool obj_test_should_run(obj_test_settings_t *settings){
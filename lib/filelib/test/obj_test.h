@@ -8,6 +8,7 @@ typedef struct{
     bool generate;
     bool print;
     bool load_save;
+    bool binary;
 }obj_test_settings_t;
 
 void obj_test_args_init(options_t *args, obj_test_settings_t *settings);
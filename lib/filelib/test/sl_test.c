@@ -4,13 +4,28 @@
 
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
 
 #include <filelib.h>
 #include <utillib/cli.h>
 
-static bool create_test(sl_test_settings_t *settings, int argc, char **argv){
-    UNUSED(settings);
+static bool write_file(sl_test_settings_t *settings, sl_file_t *f, char *filename){
+    if(settings->binary == true){
+        return sl_write_binary(f, filename);
+    }
+
+    return sl_write(f, filename);
+}
+
+static bool write_object(sl_test_settings_t *settings, obj_file_t *f, char *filename){
+    if(settings->binary == true){
+        return obj_write_binary(f, filename);
+    }
+
+    return obj_write(f, filename);
+}
 
+static bool create_test(sl_test_settings_t *settings, int argc, char **argv){
     if(!requested_arguments_more(argc, 2)){
         return false;
     }
@@ -36,7 +51,7 @@ static bool create_test(sl_test_settings_t *settings, int argc, char **argv){
         sl_holder_into_file(lib, tmp);
     }
 
-    if(!sl_write(lib, outname)){
+    if(!write_file(settings, lib, outname)){
         printf("%s\r\n", filelib_error());
         sl_file_destroy(lib);
         return false;
@@ -82,8 +97,6 @@ static bool print_test(sl_test_settings_t *settings, int argc, char **argv){
 }
 
 static bool load_save_test(sl_test_settings_t *settings, int argc, char **argv){
-    UNUSED(settings);
-
     if(!requested_arguments_exact(argc, 2)){
         return false;
     }
@@ -98,7 +111,7 @@ static bool load_save_test(sl_test_settings_t *settings, int argc, char **argv){
         return false;
     }
 
-    if(!sl_write(lib, filename_output)){
+    if(!write_file(settings, lib, filename_output)){
         printf("%s\r\n", filelib_error());
         sl_file_destroy(lib);
         return false;
@@ -109,8 +122,6 @@ static bool load_save_test(sl_test_settings_t *settings, int argc, char **argv){
 }
 
 static bool unpack_test(sl_test_settings_t *settings, int argc, char **argv){
-    UNUSED(settings);
-
     if(!requested_arguments_exact(argc, 1)){
         return false;
     }
@@ -127,7 +138,7 @@ static bool unpack_test(sl_test_settings_t *settings, int argc, char **argv){
         sl_holder_t *holder = NULL;
         list_at(lib->objects, i, (void *)&holder);
 
-        if(!obj_write(holder->object, holder->object_name)){
+        if(!write_object(settings, holder->object, holder->object_name)){
             printf("%s\r\n", filelib_error());
             sl_file_destroy(lib);
             return false;
@@ -140,17 +151,352 @@ static bool unpack_test(sl_test_settings_t *settings, int argc, char **argv){
     return true;
 }
 
+static bool symbols_equal(list_t *a, list_t *b){
+    if(list_count(a) != list_count(b)){
+        return false;
+    }
+
+    for(unsigned i = 0; i < list_count(a); i++){
+        obj_symbol_t *symbol_a = NULL;
+        obj_symbol_t *symbol_b = NULL;
+
+        list_at(a, i, (void *)&symbol_a);
+        list_at(b, i, (void *)&symbol_b);
+
+        if(strcmp(symbol_a->name, symbol_b->name) != 0 || symbol_a->value != symbol_b->value){
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static bool data_equal(list_t *a, list_t *b){
+    if(list_count(a) != list_count(b)){
+        return false;
+    }
+
+    for(unsigned i = 0; i < list_count(a); i++){
+        obj_data_t *data_a = NULL;
+        obj_data_t *data_b = NULL;
+
+        list_at(a, i, (void *)&data_a);
+        list_at(b, i, (void *)&data_b);
+
+        if(data_a->blob != data_b->blob || data_a->address != data_b->address){
+            return false;
+        }
+
+        if(data_a->blob == true){
+            if(data_a->payload.blob_value != data_b->payload.blob_value){
+                return false;
+            }
+        }
+        else if(
+            data_a->payload.data_value != data_b->payload.data_value ||
+            data_a->special_value != data_b->special_value ||
+            data_a->relocation != data_b->relocation ||
+            data_a->special != data_b->special
+        ){
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static bool objects_equal(obj_file_t *a, obj_file_t *b){
+    if(list_count(a->section_list) != list_count(b->section_list)){
+        return false;
+    }
+
+    for(unsigned i = 0; i < list_count(a->section_list); i++){
+        obj_section_t *section_a = NULL;
+        obj_section_t *section_b = NULL;
+
+        list_at(a->section_list, i, (void *)&section_a);
+        list_at(b->section_list, i, (void *)&section_b);
+
+        if(
+            strcmp(section_a->section_name, section_b->section_name) != 0 ||
+            !symbols_equal(section_a->exported_symbol_list, section_b->exported_symbol_list) ||
+            !symbols_equal(section_a->imported_symbol_list, section_b->imported_symbol_list) ||
+            !data_equal(section_a->data_symbol_list, section_b->data_symbol_list)
+        ){
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static bool add_object(sl_file_t *lib, char *name, char *filename){
+    sl_holder_t *tmp = NULL;
+    obj_file_t *obj_file = NULL;
+
+    if(!obj_load(filename, &obj_file)){
+        printf("%s\r\n", filelib_error());
+        return false;
+    }
+
+    sl_holder_new(&tmp, name, obj_file);
+    sl_holder_into_file(lib, tmp);
+
+    return true;
+}
+
+// leaves out index records of text library, so it looks like library written
+// before symbol index was introduced
+static bool strip_index(char *filename){
+    FILE *fp = fopen(filename, "rb");
+    char line[4096];
+    string_t *content = NULL;
+
+    if(fp == NULL){
+        printf("Failed to read file '%s'!\r\n", filename);
+        return false;
+    }
+
+    string_init(&content);
+
+    while(fgets(line, sizeof(line), fp) != NULL){
+        if(strncmp(line, ".member ", 8) != 0 && strncmp(line, ".symbol ", 8) != 0){
+            string_append(content, line);
+        }
+    }
+
+    fclose(fp);
+
+    fp = fopen(filename, "wb");
+
+    if(fp == NULL){
+        printf("Failed to write file '%s'!\r\n", filename);
+        string_destroy(content);
+        return false;
+    }
+
+    fputs(string_get(content), fp);
+    fclose(fp);
+    string_destroy(content);
+
+    return true;
+}
+
+// library is created from given objects, then its second member is replaced
+// by the first object, the first member is deleted and the last object is
+// appended under new name, members which are kept are copied without parsing,
+// with sl-unindexed text library is created without symbol index, update
+// giving the same member twice has to fail
+static bool update_test(sl_test_settings_t *settings, int argc, char **argv){
+    if(!requested_arguments_more(argc, 4)){
+        return false;
+    }
+
+    char *outname = argv[0];
+    char *appended = "sl_update_appended.obj";
+    sl_file_t *lib = NULL;
+    sl_file_t *update = NULL;
+    sl_file_t *expected = NULL;
+    sl_file_t *result = NULL;
+    bool retVal = true;
+
+    sl_file_new(&lib);
+    sl_file_new(&update);
+    sl_file_new(&expected);
+
+    for(int i = 1; i < argc && retVal == true; i++){
+        retVal = add_object(lib, argv[i], argv[i]);
+    }
+
+    if(retVal == true && !write_file(settings, lib, outname)){
+        printf("%s\r\n", filelib_error());
+        retVal = false;
+    }
+
+    if(retVal == true && settings->unindexed == true && settings->binary == false){
+        retVal = strip_index(outname);
+    }
+
+    retVal = retVal && add_object(update, argv[2], argv[1]);
+    retVal = retVal && add_object(update, appended, argv[argc - 1]);
+
+    retVal = retVal && add_object(expected, argv[2], argv[1]);
+
+    for(int i = 3; i < argc && retVal == true; i++){
+        retVal = add_object(expected, argv[i], argv[i]);
+    }
+
+    retVal = retVal && add_object(expected, appended, argv[argc - 1]);
+
+    if(retVal == true && !sl_update(outname, update, &(argv[1]), 1)){
+        printf("%s\r\n", filelib_error());
+        retVal = false;
+    }
+
+    if(retVal == true && !sl_load(outname, &result)){
+        printf("%s\r\n", filelib_error());
+        retVal = false;
+    }
+
+    if(retVal == true && list_count(result->objects) != list_count(expected->objects)){
+        printf("Library %s has %u members, %u expected!\r\n", outname, list_count(result->objects), list_count(expected->objects));
+        retVal = false;
+    }
+
+    for(unsigned i = 0; retVal == true && i < list_count(expected->objects); i++){
+        sl_holder_t *holder = NULL;
+        sl_holder_t *expected_holder = NULL;
+
+        list_at(result->objects, i, (void *)&holder);
+        list_at(expected->objects, i, (void *)&expected_holder);
+
+        if(strcmp(holder->object_name, expected_holder->object_name) != 0){
+            printf("Member %u of library %s is %s, %s expected!\r\n", i, outname, holder->object_name, expected_holder->object_name);
+            retVal = false;
+        }
+        else if(!objects_equal(holder->object, expected_holder->object)){
+            printf("Content of member %s of library %s doesn't match!\r\n", holder->object_name, outname);
+            retVal = false;
+        }
+    }
+
+    //the same member given twice has to be rejected
+    if(retVal == true){
+        sl_file_t *duplicate = NULL;
+
+        sl_file_new(&duplicate);
+
+        retVal = add_object(duplicate, argv[2], argv[1]) && add_object(duplicate, argv[2], argv[1]);
+
+        if(retVal == true && sl_update(outname, duplicate, NULL, 0)){
+            printf("Library %s was updated by the same member twice!\r\n", outname);
+            retVal = false;
+        }
+
+        sl_file_destroy(duplicate);
+    }
+
+    if(result != NULL){
+        sl_file_destroy(result);
+    }
+
+    sl_file_destroy(expected);
+    sl_file_destroy(update);
+    sl_file_destroy(lib);
+
+    return retVal;
+}
+
+// members loaded one by one through symbol index have to match whole library
+static bool index_test(sl_test_settings_t *settings, int argc, char **argv){
+    UNUSED(settings);
+
+    if(!requested_arguments_exact(argc, 1)){
+        return false;
+    }
+
+    char *filename = argv[0];
+    sl_file_t *lib = NULL;
+    sl_index_t *index = NULL;
+
+    if(!sl_load(filename, &lib)){
+        printf("%s\r\n", filelib_error());
+        return false;
+    }
+
+    if(!sl_load_index(filename, &index)){
+        printf("%s\r\n", filelib_error());
+        sl_file_destroy(lib);
+        return false;
+    }
+
+    bool retVal = true;
+
+    if(index->member_count != list_count(lib->objects)){
+        printf("Index of library %s has %u members, %u expected!\r\n", filename, index->member_count, list_count(lib->objects));
+        retVal = false;
+    }
+
+    for(unsigned i = 0; retVal == true && i < index->member_count; i++){
+        sl_holder_t *holder = NULL;
+        obj_file_t *member = NULL;
+        unsigned symbol = index->members[i].first_symbol;
+
+        list_at(lib->objects, i, (void *)&holder);
+
+        if(strcmp(index->members[i].name, holder->object_name) != 0){
+            printf("Member %u of library %s is %s in index, %s expected!\r\n", i, filename, index->members[i].name, holder->object_name);
+            retVal = false;
+            break;
+        }
+
+        //exported symbols are indexed in the order of sections
+        for(unsigned j = 0; retVal == true && j < list_count(holder->object->section_list); j++){
+            obj_section_t *section = NULL;
+            list_at(holder->object->section_list, j, (void *)&section);
+
+            for(unsigned k = 0; retVal == true && k < list_count(section->exported_symbol_list); k++){
+                obj_symbol_t *exported = NULL;
+                list_at(section->exported_symbol_list, k, (void *)&exported);
+
+                if(
+                    symbol >= index->members[i].first_symbol + index->members[i].symbol_count ||
+                    strcmp(index->symbols[symbol].name, exported->name) != 0 ||
+                    index->symbols[symbol].member != i
+                ){
+                    printf("Symbol %s of member %s is missing in index of library %s!\r\n", exported->name, holder->object_name, filename);
+                    retVal = false;
+                }
+
+                symbol++;
+            }
+        }
+
+        if(retVal == true && symbol != index->members[i].first_symbol + index->members[i].symbol_count){
+            printf("Index of library %s holds extra symbols of member %s!\r\n", filename, holder->object_name);
+            retVal = false;
+        }
+
+        if(retVal == true && !sl_load_member(index, i, &member)){
+            printf("%s\r\n", filelib_error());
+            retVal = false;
+        }
+
+        if(retVal == true && !objects_equal(member, holder->object)){
+            printf("Content of member %s of library %s doesn't match!\r\n", holder->object_name, filename);
+            retVal = false;
+        }
+
+        if(member != NULL){
+            obj_file_destroy(member);
+        }
+    }
+
+    sl_index_destroy(index);
+    sl_file_destroy(lib);
+
+    return retVal;
+}
+
 void sl_test_args_init(options_t *args, sl_test_settings_t *settings){
     options_append_section(args, "SL Tests", NULL);
     options_append_flag_2(args, "sl-create", "Generate static library from given object files.");
     options_append_flag_2(args, "sl-print", "Print content of library.");
     options_append_flag_2(args, "sl-load-save", "Load library and save it again as another file.");
     options_append_flag_2(args, "sl-unpack", "Unpack static library back into object files.");
+    options_append_flag_2(args, "sl-update", "Create library from object files, replace, delete and append member and check the result.");
+    options_append_flag_2(args, "sl-index", "Load members of library one by one through its symbol index and compare them.");
+    options_append_flag_2(args, "sl-unindexed", "Create text library for sl-update without symbol index.");
+    options_append_flag_2(args, "sl-binary", "Write output files in binary format.");
 
     settings->create = false;
     settings->print = false;
     settings->load_save = false;
+    settings->binary = false;
     settings->unpack = false;
+    settings->update = false;
+    settings->index = false;
+    settings->unindexed = false;
 }
 
 void sl_test_args_parse(options_t *args, sl_test_settings_t *settings){
@@ -163,13 +509,25 @@ void sl_test_args_parse(options_t *args, sl_test_settings_t *settings){
     if(options_is_flag_set(args, "sl-load-save")){
         settings->load_save = true;
     }
+    if(options_is_flag_set(args, "sl-binary")){
+        settings->binary = true;
+    }
     if(options_is_flag_set(args, "sl-unpack")){
         settings->unpack = true;
     }
+    if(options_is_flag_set(args, "sl-update")){
+        settings->update = true;
+    }
+    if(options_is_flag_set(args, "sl-index")){
+        settings->index = true;
+    }
+    if(options_is_flag_set(args, "sl-unindexed")){
+        settings->unindexed = true;
+    }
 }
 
 bool sl_test_should_run(sl_test_settings_t *settings){
-    return (settings->create || settings->load_save || settings->print || settings->unpack);
+    return (settings->create || settings->load_save || settings->print || settings->unpack || settings->update || settings->index);
 }
 
 bool sl_test_run(sl_test_settings_t *settings, int argc, char **argv){
@@ -185,6 +543,12 @@ bool sl_test_run(sl_test_settings_t *settings, int argc, char **argv){
     else if(settings->unpack == true){
         return unpack_test(settings, argc, argv);
     }
+    else if(settings->update == true){
+        return update_test(settings, argc, argv);
+    }
+    else if(settings->index == true){
+        return index_test(settings, argc, argv);
+    }
     else{
         return false;
     }
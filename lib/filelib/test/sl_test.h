@@ -8,7 +8,11 @@ typedef struct{
     bool create;
     bool print;
     bool load_save;
+    bool binary;
     bool unpack;
+    bool update;
+    bool index;
+    bool unindexed;
 }sl_test_settings_t;
 
 void sl_test_args_init(options_t *args, sl_test_settings_t *settings);
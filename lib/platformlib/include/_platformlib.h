@@ -0,0 +1,14 @@
+#ifndef PLATFORMLIB_INTERNAL_H_included
+#define PLATFORMLIB_INTERNAL_H_included
+
+#include <utillib/core.h>
+
+// Not part of platformlib API, filelib contexts keep platformlib errors of
+// every thread apart by it, tools get them through filelib_ctx_t.
+
+// errors raised by the calling thread go into given buffer instead of the
+// global one, NULL switches the thread back to the global buffer; buffer set
+// before is returned, so it can be restored afterwards
+error_t *_platformlib_set_thread_error_buffer(error_t *buffer);
+
+#endif
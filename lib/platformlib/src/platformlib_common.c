@@ -1,4 +1,5 @@
 #include "platformlib_common.h"
+#include "../include/_platformlib.h"
 #include "platformlib_private.h"
 
 #include <stddef.h>
@@ -10,6 +11,11 @@
 
 error_t *platformlib_error_buffer = NULL;
 bool platformlib_initialized = false;
+static PLATFORMLIB_THREAD_LOCAL error_t *platformlib_thread_error_buffer = NULL;
+
+#ifdef PLATFORMLIB_DECODE_TABLE_SIZE
+static instruction_signature_t *platformlib_decode_table[PLATFORMLIB_DECODE_TABLE_SIZE];
+#endif
 
 void platformlib_init(void){
     if(platformlib_initialized == true){
@@ -18,6 +24,10 @@ void platformlib_init(void){
 
     error_buffer_init(&platformlib_error_buffer);
 
+#ifdef PLATFORMLIB_DECODE_TABLE_SIZE
+    platformlib_build_decode_table(platformlib_decode_table);
+#endif
+
     platformlib_initialized = true;
 }
 
@@ -34,40 +44,68 @@ void platformlib_deinit(void){
 
 char *platformlib_error(void){
     CHECK_INITIALIZED();
-    return error_buffer_get(platformlib_error_buffer);
+    return error_buffer_get(platformlib_current_error_buffer());
 }
 
-bool platformlib_is_instruction_opcode(char *opcode){
-    CHECK_NULL_ARGUMENT(opcode);
+error_t *_platformlib_set_thread_error_buffer(error_t *buffer){
+    error_t *previous = platformlib_thread_error_buffer;
 
-    bool found = false;
+    platformlib_thread_error_buffer = buffer;
 
-    for(unsigned i = 0; platformlib_instruction_signatures[i].opcode != NULL; i++){
-        if(strcmp(opcode, platformlib_instruction_signatures[i].opcode) == 0){
-            found = true;
-            break;
-        }
+    return previous;
+}
+
+error_t *platformlib_current_error_buffer(void){
+    if(platformlib_thread_error_buffer != NULL){
+        return platformlib_thread_error_buffer;
     }
 
-    return found;
+    return platformlib_error_buffer;
+}
+
+bool platformlib_is_instruction_opcode(char *opcode){
+    CHECK_NULL_ARGUMENT(opcode);
+
+    return (platformlib_get_instruction_signature(opcode) != NULL) ? true : false;
 }
 
 instruction_signature_t *platformlib_get_instruction_signature(char *opcode){
     CHECK_NULL_ARGUMENT(opcode);
 
-    instruction_signature_t *signature = NULL;
+    unsigned low = 0;
+    unsigned high = platformlib_mnemonic_count;
+
+    while(low < high){
+        unsigned middle = low + (high - low) / 2;
+        instruction_signature_t *signature = &(platformlib_instruction_signatures[platformlib_mnemonic_index[middle]]);
+        int result = strcmp(opcode, signature->opcode);
 
-    for(unsigned i = 0; platformlib_instruction_signatures[i].opcode != NULL; i++){
-        if(strcmp(opcode, platformlib_instruction_signatures[i].opcode) == 0){
-            signature = &(platformlib_instruction_signatures[i]);
-            break;
+        if(result == 0){
+            return signature;
+        }
+        else if(result < 0){
+            high = middle;
+        }
+        else{
+            low = middle + 1;
         }
     }
 
-    return signature;
+    return NULL;
 }
 
 instruction_signature_t *platformlib_get_instruction_signature_1(isa_instruction_word_t word){
+#ifdef PLATFORMLIB_DECODE_TABLE_SIZE
+    CHECK_INITIALIZED();
+
+    unsigned index = 0;
+
+    if(!platformlib_get_decode_index(word, &index) || index >= PLATFORMLIB_DECODE_TABLE_SIZE){
+        return NULL;
+    }
+
+    return platformlib_decode_table[index];
+#else
     char *opcode = NULL;
 
     if(!platformlib_get_instruction_opcode(word, &opcode)){
@@ -75,4 +113,5 @@ instruction_signature_t *platformlib_get_instruction_signature_1(isa_instruction
     }
 
     return platformlib_get_instruction_signature(opcode);
+#endif
 }
@@ -3,6 +3,8 @@
 
 #include <platformlib_target_specific.h>
 
+#include <utillib/core.h>
+
 #include <stdbool.h>
 
 void platformlib_init(void);
@@ -4,10 +4,23 @@
 #include <stdbool.h>
 #include <utillib/utils.h>
 
-#define ERROR_WRITE(x, ...) error_buffer_write(platformlib_error_buffer, (x), ##__VA_ARGS__)
+#if defined(_MSC_VER)
+#define PLATFORMLIB_THREAD_LOCAL __declspec(thread)
+#else
+#define PLATFORMLIB_THREAD_LOCAL __thread
+#endif
+
+#define ERROR_WRITE(x, ...) error_buffer_write(platformlib_current_error_buffer(), (x), ##__VA_ARGS__)
 #define CHECK_INITIALIZED() { if(platformlib_initialized == false){ error("Platform lib is not initialized!"); }}
 
 extern bool platformlib_initialized;
+
+// generated at build time, indexes into platformlib_instruction_signatures[] sorted by opcode
+extern const unsigned platformlib_mnemonic_count;
+extern const unsigned platformlib_mnemonic_index[];
 extern error_t *platformlib_error_buffer;
 
+// error buffer of calling thread, global one when thread didn't set its own
+error_t *platformlib_current_error_buffer(void);
+
 #endif
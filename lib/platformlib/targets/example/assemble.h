@@ -11,6 +11,7 @@
 #define ASSEMBLE_H_included
 
 #include "datatypes.h"
+#include "instructions_description.h"
 
 #include <stdbool.h>
 
@@ -31,6 +32,25 @@ bool platformlib_assemble_instruction(
     void *section,
     isa_instruction_word_t *result);
 
+/**
+ * @brief Assemble instruction whose signature was already looked up.
+ * @param signature Signature of opcode args[0], as platformlib_get_instruction_signature() returns it.
+ * @param args Strings from tokenized input.
+ * @param argc Count of element of array args.
+ * @param find_symbol_callback This function can be called to resolve symbol into address.
+ * @param section Put this into call back, otherwise do not touch it!
+ * @param result Pointer where this function should store its output.
+ * @return true Return true if everything was parsed correctly.
+ * @return false Return false if there was something wrong.
+ */
+bool platformlib_assemble_instruction_1(
+    instruction_signature_t *signature,
+    char **args,
+    int argc,
+    bool (*find_symbol_callback)(char *label, void *section, isa_address_t *result),
+    void *section,
+    isa_instruction_word_t *result);
+
 /**
  * @brief Relocate instruction that have relative argument and relocation flag set.
  * @note Used in linker.
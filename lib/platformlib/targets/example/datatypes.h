@@ -9,7 +9,9 @@
  *
  * In addition to these datatypes, there are also functions that are mentioned for
  * dealing with printing these datatypes into strings and converting them back
- * from string representation into actual numbers.
+ * from string representation into actual numbers. The write and read functions
+ * are convenient for occasional use, parse and format functions work without
+ * allocations and are used for bulk processing of files.
  */
 
 #ifndef DATATYPES_H_included
@@ -96,6 +98,86 @@ char *platformlib_write_isa_instruction_word(isa_instruction_word_t value);
  */
 char *platformlib_write_isa_memory_element(isa_memory_element_t value);
 
+/**
+ * @brief Size of buffer that is large enough for formatted value of any ISA
+ * type including terminating null character.
+ */
+#define PLATFORMLIB_FORMAT_BUFFER_SIZE 32
+
+/**
+ * @brief Maximal number of memory elements of single instruction word.
+ */
+#define PLATFORMLIB_MAX_WORD_ELEMENTS (sizeof(isa_instruction_word_t) / sizeof(isa_memory_element_t))
+
+/**
+ * @brief Parse isa_address_t value from span of characters.
+ * @note Span doesn't have to be null terminated, whole span have to be consumed.
+ * @note Complementary to platformlib_format_isa_address().
+ * @param s Beginning of the span.
+ * @param length Count of characters in span.
+ * @param value Pointer where value will be stored.
+ * @return true Span was successfully decoded and result is stored in *value.
+ * @return false Span wasn't decoded correctly and *value is not affected.
+ */
+bool platformlib_parse_isa_address(const char *s, unsigned length, isa_address_t *value);
+
+/**
+ * @brief Parse isa_instruction_word_t value from span of characters.
+ * @note Span doesn't have to be null terminated, whole span have to be consumed.
+ * @note Complementary to platformlib_format_isa_instruction_word().
+ * @param s Beginning of the span.
+ * @param length Count of characters in span.
+ * @param value Pointer where value will be stored.
+ * @return true Span was successfully decoded and result is stored in *value.
+ * @return false Span wasn't decoded correctly and *value is not affected.
+ */
+bool platformlib_parse_isa_instruction_word(const char *s, unsigned length, isa_instruction_word_t *value);
+
+/**
+ * @brief Parse isa_memory_element_t value from span of characters.
+ * @note Span doesn't have to be null terminated, whole span have to be consumed.
+ * @note Complementary to platformlib_format_isa_memory_element().
+ * @param s Beginning of the span.
+ * @param length Count of characters in span.
+ * @param value Pointer where value will be stored.
+ * @return true Span was successfully decoded and result is stored in *value.
+ * @return false Span wasn't decoded correctly and *value is not affected.
+ */
+bool platformlib_parse_isa_memory_element(const char *s, unsigned length, isa_memory_element_t *value);
+
+/**
+ * @brief Format isa_address_t value into buffer provided by caller.
+ * @note Output is same as from platformlib_write_isa_address() and it is null terminated.
+ * @note Complementary to platformlib_parse_isa_address().
+ * @param value Numerical value to be converted.
+ * @param buffer Buffer for the result.
+ * @param size Size of the buffer, PLATFORMLIB_FORMAT_BUFFER_SIZE is always enough.
+ * @return unsigned Length of the result without null character, 0 if buffer is too small.
+ */
+unsigned platformlib_format_isa_address(isa_address_t value, char *buffer, unsigned size);
+
+/**
+ * @brief Format isa_instruction_word_t value into buffer provided by caller.
+ * @note Output is same as from platformlib_write_isa_instruction_word() and it is null terminated.
+ * @note Complementary to platformlib_parse_isa_instruction_word().
+ * @param value Numerical value to be converted.
+ * @param buffer Buffer for the result.
+ * @param size Size of the buffer, PLATFORMLIB_FORMAT_BUFFER_SIZE is always enough.
+ * @return unsigned Length of the result without null character, 0 if buffer is too small.
+ */
+unsigned platformlib_format_isa_instruction_word(isa_instruction_word_t value, char *buffer, unsigned size);
+
+/**
+ * @brief Format isa_memory_element_t value into buffer provided by caller.
+ * @note Output is same as from platformlib_write_isa_memory_element() and it is null terminated.
+ * @note Complementary to platformlib_parse_isa_memory_element().
+ * @param value Numerical value to be converted.
+ * @param buffer Buffer for the result.
+ * @param size Size of the buffer, PLATFORMLIB_FORMAT_BUFFER_SIZE is always enough.
+ * @return unsigned Length of the result without null character, 0 if buffer is too small.
+ */
+unsigned platformlib_format_isa_memory_element(isa_memory_element_t value, char *buffer, unsigned size);
+
 /**
  * @brief Used to convert instruction to memory elements when linker is generating
  * output ldm file.
@@ -107,4 +189,14 @@ char *platformlib_write_isa_memory_element(isa_memory_element_t value);
  */
 void platformlib_convert_isa_word_to_element(isa_instruction_word_t word, array_t **output);
 
+/**
+ * @brief Split instruction into memory elements stored in buffer provided by
+ * caller, same as platformlib_convert_isa_word_to_element() but without allocation.
+ * @param word Input data.
+ * @param elements Buffer for the result.
+ * @param size Number of elements in the buffer, PLATFORMLIB_MAX_WORD_ELEMENTS is always enough.
+ * @return unsigned Number of memory elements written, 0 if buffer is too small.
+ */
+unsigned platformlib_split_isa_word(isa_instruction_word_t word, isa_memory_element_t *elements, unsigned size);
+
 #endif
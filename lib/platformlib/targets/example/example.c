@@ -29,6 +29,24 @@ bool platformlib_assemble_instruction(
     return false;
 }
 
+bool platformlib_assemble_instruction_1(
+    instruction_signature_t *signature,
+    char **args,
+    int argc,
+    bool (*find_symbol_callback)(char *label, void *section, isa_address_t *result),
+    void *section,
+    isa_instruction_word_t *result
+){
+    UNUSED(signature);
+    UNUSED(args);
+    UNUSED(argc);
+    UNUSED(find_symbol_callback);
+    UNUSED(section);
+    UNUSED(result);
+    _error();
+    return false;
+}
+
 bool platformlib_relocate_instruction(
     isa_instruction_word_t input,
     isa_instruction_word_t *output,
@@ -92,12 +110,68 @@ char *platformlib_write_isa_memory_element(isa_memory_element_t value){
     return NULL;
 }
 
+bool platformlib_parse_isa_address(const char *s, unsigned length, isa_address_t *value){
+    UNUSED(s);
+    UNUSED(length);
+    UNUSED(value);
+    _error();
+    return false;
+}
+
+bool platformlib_parse_isa_instruction_word(const char *s, unsigned length, isa_instruction_word_t *value){
+    UNUSED(s);
+    UNUSED(length);
+    UNUSED(value);
+    _error();
+    return false;
+}
+
+bool platformlib_parse_isa_memory_element(const char *s, unsigned length, isa_memory_element_t *value){
+    UNUSED(s);
+    UNUSED(length);
+    UNUSED(value);
+    _error();
+    return false;
+}
+
+unsigned platformlib_format_isa_address(isa_address_t value, char *buffer, unsigned size){
+    UNUSED(value);
+    UNUSED(buffer);
+    UNUSED(size);
+    _error();
+    return 0;
+}
+
+unsigned platformlib_format_isa_instruction_word(isa_instruction_word_t value, char *buffer, unsigned size){
+    UNUSED(value);
+    UNUSED(buffer);
+    UNUSED(size);
+    _error();
+    return 0;
+}
+
+unsigned platformlib_format_isa_memory_element(isa_memory_element_t value, char *buffer, unsigned size){
+    UNUSED(value);
+    UNUSED(buffer);
+    UNUSED(size);
+    _error();
+    return 0;
+}
+
 void platformlib_convert_isa_word_to_element(isa_instruction_word_t word, array_t **output){
     UNUSED(word);
     UNUSED(output);
     _error();
 }
 
+unsigned platformlib_split_isa_word(isa_instruction_word_t word, isa_memory_element_t *elements, unsigned size){
+    UNUSED(word);
+    UNUSED(elements);
+    UNUSED(size);
+    _error();
+    return 0;
+}
+
 bool platformlib_get_instruction_opcode(isa_instruction_word_t word, char **opcode){
     UNUSED(word);
     UNUSED(opcode);
@@ -7,6 +7,7 @@
 #define MISCELLANEOUS_H_included
 
 #include "datatypes.h"
+#include "instructions_description.h"
 
 /**
  * @brief Convert translated instruction into mnemotechnic
@@ -20,4 +21,36 @@
  */
 bool platformlib_get_instruction_opcode(isa_instruction_word_t word, char **opcode);
 
+/*
+ * Optional decode table
+ *
+ * By default platformlib_get_instruction_signature_1() decodes instruction
+ * word by platformlib_get_instruction_opcode() followed by search of the
+ * signature by its name. Linker does this for every instruction word, so
+ * target can provide table that maps some key of instruction word (leading
+ * opcode byte for example) directly to signature. To do so, define
+ * PLATFORMLIB_DECODE_TABLE_SIZE here and implement both functions below.
+ * Table is owned by platformlib and it is built once by platformlib_init().
+ */
+
+#ifdef PLATFORMLIB_DECODE_TABLE_SIZE
+
+/**
+ * @brief Fill all PLATFORMLIB_DECODE_TABLE_SIZE entries of decode table.
+ * @note Entries that don't belong to any instruction have to be NULL.
+ * @param table Table to be filled.
+ */
+void platformlib_build_decode_table(instruction_signature_t **table);
+
+/**
+ * @brief Compute index into decode table for instruction word.
+ * @param word Word to be decoded.
+ * @param index Pointer to result, has to be lower than PLATFORMLIB_DECODE_TABLE_SIZE.
+ * @return true Index was computed.
+ * @return false Word can't be instruction.
+ */
+bool platformlib_get_decode_index(isa_instruction_word_t word, unsigned *index);
+
+#endif
+
 #endif
@@ -165,6 +165,26 @@ bool platformlib_assemble_instruction(
     isa_instruction_word_t *result)
 {
     CHECK_NULL_ARGUMENT(args);
+
+    instruction_signature_t *signature = platformlib_get_instruction_signature(args[0]);
+
+    if(signature == NULL){
+        error("Tryting to get type of something that isn't instruction!");
+    }
+
+    return platformlib_assemble_instruction_1(signature, args, argc, find_symbol_callback, section, result);
+}
+
+bool platformlib_assemble_instruction_1(
+    instruction_signature_t *signature,
+    char **args,
+    int argc,
+    bool (*find_symbol_callback)(char *label, void *section, isa_address_t *result),
+    void *section,
+    isa_instruction_word_t *result)
+{
+    CHECK_NULL_ARGUMENT(signature);
+    CHECK_NULL_ARGUMENT(args);
     CHECK_NULL_ARGUMENT(section);
     CHECK_NULL_ARGUMENT(result);
     CHECK_NULL_ARGUMENT(find_symbol_callback);
@@ -173,16 +193,11 @@ bool platformlib_assemble_instruction(
     }
 
     isa_instruction_word_t instruction = 0;
-    instruction_signature_t *signature = platformlib_get_instruction_signature(args[0]);
 
     isa_instruction_word_t tmp_a = 0;
     isa_instruction_word_t tmp_b = 0;
     isa_instruction_word_t tmp_c = 0;
 
-    if(signature == NULL){
-        error("Tryting to get type of something that isn't instruction!");
-    }
-
     instruction = signature->instruction_code;
 
     if((unsigned)argc != signature->argc + 1){
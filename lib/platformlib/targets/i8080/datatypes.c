@@ -78,6 +78,121 @@ char *platformlib_write_isa_memory_element(isa_memory_element_t value){
     return tmp;
 }
 
+// Values are written as 0x prefix followed by fixed count of lowercase hex
+// digits, same as PRIisa_* formats above. Parsing accepts 1 up to that count
+// of digits in either case and span have to be consumed completely.
+
+static const char hex_digits[] = "0123456789abcdef";
+
+static unsigned format_hex(uint32_t value, unsigned digits, char *buffer, unsigned size){
+    if(size < digits + 3){
+        return 0;
+    }
+
+    buffer[0] = '0';
+    buffer[1] = 'x';
+
+    for(unsigned i = digits + 1; i > 1; i--){
+        buffer[i] = hex_digits[value & 0xf];
+        value >>= 4;
+    }
+
+    buffer[digits + 2] = '\0';
+
+    return digits + 2;
+}
+
+static bool parse_hex(const char *s, unsigned length, unsigned digits, uint32_t *value){
+    if(length < 3 || length > digits + 2 || s[0] != '0' || s[1] != 'x'){
+        return false;
+    }
+
+    uint32_t tmp = 0;
+
+    for(unsigned i = 2; i < length; i++){
+        char c = s[i];
+        uint32_t nibble = 0;
+
+        if(c >= '0' && c <= '9'){
+            nibble = (uint32_t)(c - '0');
+        }
+        else if(c >= 'a' && c <= 'f'){
+            nibble = (uint32_t)(c - 'a' + 10);
+        }
+        else if(c >= 'A' && c <= 'F'){
+            nibble = (uint32_t)(c - 'A' + 10);
+        }
+        else{
+            return false;
+        }
+
+        tmp = (tmp << 4) | nibble;
+    }
+
+    *value = tmp;
+    return true;
+}
+
+bool platformlib_parse_isa_address(const char *s, unsigned length, isa_address_t *value){
+    CHECK_NULL_ARGUMENT(value);
+    CHECK_NULL_ARGUMENT(s);
+
+    uint32_t tmp = 0;
+
+    if(!parse_hex(s, length, 2 * sizeof(isa_address_t), &tmp)){
+        return false;
+    }
+
+    *value = (isa_address_t)tmp;
+    return true;
+}
+
+bool platformlib_parse_isa_instruction_word(const char *s, unsigned length, isa_instruction_word_t *value){
+    CHECK_NULL_ARGUMENT(value);
+    CHECK_NULL_ARGUMENT(s);
+
+    uint32_t tmp = 0;
+
+    if(!parse_hex(s, length, 2 * sizeof(isa_instruction_word_t), &tmp)){
+        return false;
+    }
+
+    *value = (isa_instruction_word_t)tmp;
+    return true;
+}
+
+bool platformlib_parse_isa_memory_element(const char *s, unsigned length, isa_memory_element_t *value){
+    CHECK_NULL_ARGUMENT(value);
+    CHECK_NULL_ARGUMENT(s);
+
+    uint32_t tmp = 0;
+
+    if(!parse_hex(s, length, 2 * sizeof(isa_memory_element_t), &tmp)){
+        return false;
+    }
+
+    *value = (isa_memory_element_t)tmp;
+    return true;
+}
+
+unsigned platformlib_format_isa_address(isa_address_t value, char *buffer, unsigned size){
+    CHECK_NULL_ARGUMENT(buffer);
+
+    return format_hex(value, 2 * sizeof(isa_address_t), buffer, size);
+}
+
+unsigned platformlib_format_isa_instruction_word(isa_instruction_word_t value, char *buffer, unsigned size){
+    CHECK_NULL_ARGUMENT(buffer);
+
+    return format_hex(value, 2 * sizeof(isa_instruction_word_t), buffer, size);
+}
+
+unsigned platformlib_format_isa_memory_element(isa_memory_element_t value, char *buffer, unsigned size){
+    CHECK_NULL_ARGUMENT(buffer);
+
+    return format_hex(value, 2 * sizeof(isa_memory_element_t), buffer, size);
+}
+
 void platformlib_convert_isa_word_to_element(isa_instruction_word_t word, array_t **output){
     CHECK_NULL_ARGUMENT(output);
     CHECK_NOT_NULL_ARGUMENT(*output);
@@ -97,3 +212,24 @@ void platformlib_convert_isa_word_to_element(isa_instruction_word_t word, array_
         array_set(*output, pos++, &data);
     }
 }
+
+unsigned platformlib_split_isa_word(isa_instruction_word_t word, isa_memory_element_t *elements, unsigned size){
+    CHECK_NULL_ARGUMENT(elements);
+
+    instruction_signature_t *signature = platformlib_get_instruction_signature_1(word);
+
+    if(signature == NULL){
+        error("Converting isa_instruction_word_t into elements but it is not instruction!");
+    }
+
+    if(signature->size > size){
+        return 0;
+    }
+
+    unsigned pos = 0;
+    for(isa_address_t i = signature->size; i > 0; i--){
+        elements[pos++] = (word >> ((i - 1) * 8)) & 0xFF;
+    }
+
+    return pos;
+}
@@ -9,20 +9,104 @@
 #include <stddef.h>
 #include <string.h>
 
+#define REGISTER_FIELD 0x07
+#define RP_FIELD 0x03
+#define RP_BD_FIELD 0x01
+#define RST_FIELD 0x07
+
+// bits of leading byte that are occupied by operands encoded into opcode
+static uint8_t operand_mask(instruction_mnemonic_t mnemonic){
+    switch(mnemonic){
+        case INSTRU_MOV:
+            return SHIFT_TO_DST(REGISTER_FIELD) | SHIFT_TO_SRC(REGISTER_FIELD);
+        case INSTRU_MVI:
+        case INSTRU_INR:
+        case INSTRU_DCR:
+            return SHIFT_TO_DST(REGISTER_FIELD);
+        case INSTRU_ADD:
+        case INSTRU_ADC:
+        case INSTRU_SUB:
+        case INSTRU_SBB:
+        case INSTRU_ANA:
+        case INSTRU_ORA:
+        case INSTRU_XRA:
+        case INSTRU_CMP:
+            return SHIFT_TO_SRC(REGISTER_FIELD);
+        case INSTRU_LXI:
+        case INSTRU_INX:
+        case INSTRU_DCX:
+        case INSTRU_DAD:
+        case INSTRU_PUSH:
+        case INSTRU_POP:
+            return SHIFT_TO_RP(RP_FIELD);
+        case INSTRU_LDAX:
+        case INSTRU_STAX:
+            return SHIFT_TO_RP(RP_BD_FIELD);
+        case INSTRU_RST:
+            return SHIFT_TO_DST(RST_FIELD);
+        default:
+            return 0;
+    }
+}
+
+void platformlib_build_decode_table(instruction_signature_t **table){
+    CHECK_NULL_ARGUMENT(table);
+
+    for(unsigned i = 0; i < PLATFORMLIB_DECODE_TABLE_SIZE; i++){
+        table[i] = NULL;
+    }
+
+    //instructions with operands in opcode first, exact opcodes then override
+    //them (HLT is MOV M,M, LHLD and LDA are in place of LDAX H and LDAX SP...)
+    for(unsigned pass = 0; pass < 2; pass++){
+        for(unsigned i = 0; platformlib_instruction_signatures[i].opcode != NULL; i++){
+            instruction_signature_t *signature = &(platformlib_instruction_signatures[i]);
+            uint8_t mask = operand_mask(signature->instruction_mnemonic);
+
+            if((pass == 0) != (mask != 0)){
+                continue;
+            }
+
+            for(unsigned byte = 0; byte < PLATFORMLIB_DECODE_TABLE_SIZE; byte++){
+                if((byte & ~mask) == signature->instruction_code){
+                    table[byte] = signature;
+                }
+            }
+        }
+    }
+}
+
+bool platformlib_get_decode_index(isa_instruction_word_t word, unsigned *index){
+    CHECK_NULL_ARGUMENT(index);
+
+    //opcode is in the most significant byte of instruction and only single
+    //byte instruction (NOP) has zero opcode, so position is given by magnitude
+    if(word > 0xFFFFFF){
+        return false;
+    }
+    else if(word > 0xFFFF){
+        *index = (word >> 16) & 0xFF;
+    }
+    else if(word > 0xFF){
+        *index = (word >> 8) & 0xFF;
+    }
+    else{
+        *index = word;
+    }
+
+    return true;
+}
+
 bool platformlib_get_instruction_opcode(isa_instruction_word_t word, char **opcode){
     CHECK_NULL_ARGUMENT(opcode);
     CHECK_NOT_NULL_ARGUMENT(*opcode);
 
-    for(int i = 0; platformlib_instruction_signatures[i].opcode != NULL; i++){
-        isa_instruction_word_t head = platformlib_instruction_signatures[i].instruction_code;
+    instruction_signature_t *signature = platformlib_get_instruction_signature_1(word);
 
-        head = SHIFT(head, (platformlib_instruction_signatures[i].size - 1) * 8);
-
-        if((word & head) == head){
-            *opcode = platformlib_instruction_signatures[i].opcode;
-            return true;
-        }
+    if(signature == NULL){
+        return false;
     }
 
-    return false;
+    *opcode = signature->opcode;
+    return true;
 }
@@ -21,4 +21,19 @@
  */
 bool platformlib_get_instruction_opcode(isa_instruction_word_t word, char **opcode);
 
+/**
+ * @brief Instructions are decoded by their leading opcode byte.
+ */
+#define PLATFORMLIB_DECODE_TABLE_SIZE 256
+
+/**
+ * @brief Fill decode table, see example target for details.
+ */
+void platformlib_build_decode_table(instruction_signature_t **table);
+
+/**
+ * @brief Get leading opcode byte of instruction word.
+ */
+bool platformlib_get_decode_index(isa_instruction_word_t word, unsigned *index);
+
 #endif
@@ -0,0 +1,90 @@
+/**
+ * @file gen_mnemonic_index.c
+ *
+ * @brief Build time generator of sorted mnemonic index.
+ *
+ * It is linked with signature table of selected target and writes C source
+ * with indexes into platformlib_instruction_signatures[] ordered by opcode
+ * name, so platformlib can find signature by binary search.
+ *
+ * Usage: gen_mnemonic_index <output.c>
+ */
+
+#include <platformlib_target_specific.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static int compare_signatures(const void *a, const void *b){
+    unsigned index_a = *(const unsigned *)a;
+    unsigned index_b = *(const unsigned *)b;
+
+    return strcmp(platformlib_instruction_signatures[index_a].opcode, platformlib_instruction_signatures[index_b].opcode);
+}
+
+int main(int argc, char **argv){
+    if(argc != 2){
+        fprintf(stderr, "Usage: %s <output.c>\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    unsigned count = 0;
+
+    while(platformlib_instruction_signatures[count].opcode != NULL){
+        count++;
+    }
+
+    unsigned *index = (unsigned *)malloc((count + 1) * sizeof(unsigned));
+
+    if(index == NULL){
+        fprintf(stderr, "Out of memory!\n");
+        return EXIT_FAILURE;
+    }
+
+    for(unsigned i = 0; i < count; i++){
+        index[i] = i;
+    }
+
+    qsort(index, count, sizeof(unsigned), compare_signatures);
+
+    for(unsigned i = 1; i < count; i++){
+        if(compare_signatures(&index[i - 1], &index[i]) == 0){
+            fprintf(stderr, "Opcode %s is in signature table more than once!\n", platformlib_instruction_signatures[index[i]].opcode);
+            free(index);
+            return EXIT_FAILURE;
+        }
+    }
+
+    FILE *fp = fopen(argv[1], "w");
+
+    if(fp == NULL){
+        fprintf(stderr, "Can't open %s for writing!\n", argv[1]);
+        free(index);
+        return EXIT_FAILURE;
+    }
+
+    fprintf(fp, "// Generated by gen_mnemonic_index from %s signature table, don't edit!\n\n", TARGET_ARCH_NAME);
+    fprintf(fp, "const unsigned platformlib_mnemonic_count = %u;\n\n", count);
+    fprintf(fp, "const unsigned platformlib_mnemonic_index[] = {\n");
+
+    for(unsigned i = 0; i < count; i++){
+        fprintf(fp, "    %u, // %s\n", index[i], platformlib_instruction_signatures[index[i]].opcode);
+    }
+
+    //keep array non empty for targets without instructions
+    if(count == 0){
+        fprintf(fp, "    0\n");
+    }
+
+    fprintf(fp, "};\n");
+
+    free(index);
+
+    if(fclose(fp) != 0){
+        fprintf(stderr, "Failed to write %s!\n", argv[1]);
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -19,7 +19,14 @@
  *
  * You can also use this tool to extract static library into object files from
  * which it was created. For this --extract is used. Or you can simply list them
- * by using --list.
+ * by using --list. Symbols exported by members are printed by --symbols, which
+ * reads only symbol index stored at the beginning of library.
+ *
+ * $archiver --replace -o my_lib.sl obj_b.o obj_d.o
+ * $archiver --delete -o my_lib.sl obj_c.o
+ *
+ * Update existing library in place, only replaced or appended members are
+ * written again, all the other ones are copied as they are.
  *
  * Source code of this utility is pretty straight forward and doesn't need any futher
  * explanation. All hard work is done by sllib and objlib.
@@ -35,17 +42,29 @@
 
 #include <filelib.h>
 
+#ifdef ARCHIVER_USE_PTHREADS
+#include <pthread.h>
+#endif
+
+#define ARCHIVER_MAX_JOBS 256
+
 static void arg_parse(int argc, char **argv);
 static void clean_mem(void);
 static void failure(char *errmsg);
 static void create_library(char *out_file, char **input_files, unsigned file_count);
+static void replace_members(char *out_file, char **input_files, unsigned file_count);
+static void delete_members(char *out_file, char **input_files, unsigned file_count);
 static void list_library(char *input_archive);
+static void list_symbols(char *input_archive);
 static void extract_library(char *input_archive);
 
 typedef enum{
     ACTION_CREATE_ARCHIVE = 0,
+    ACTION_REPLACE_ARCHIVE,
+    ACTION_DELETE_ARCHIVE,
     ACTION_LIST_ARCHIVE,
     ACTION_EXTRACT_ARCHIVE,
+    ACTION_SYMBOLS_ARCHIVE,
     ACTION_NOT_SPECIFIED,
     ACTION_HELP,
     ACTION_VERSION
@@ -57,8 +76,33 @@ typedef struct{
     int input_files_count;
     char **input_files;
     bool verbose;
+    bool binary;
+    unsigned jobs;
 }settings_t;
 
+// object file loaded or written by worker through its own filelib context,
+// errors are kept there until results are checked in the order of jobs
+typedef struct{
+    char *filename;
+    obj_file_t *object;
+    bool ok;
+    filelib_ctx_t *files;
+}archiver_job_t;
+
+typedef void (archiver_work_t)(archiver_job_t *job);
+
+static void job_failure(archiver_job_t *job);
+
+typedef struct{
+    archiver_job_t *jobs;
+    unsigned count;
+    unsigned next;
+    archiver_work_t *work;
+#ifdef ARCHIVER_USE_PTHREADS
+    pthread_mutex_t lock;
+#endif
+}archiver_queue_t;
+
 settings_t settings;
 options_t *args = NULL;
 
@@ -90,6 +134,28 @@ int main(int argc, char **argv){
 
             create_library(settings.out_file_name, settings.input_files, settings.input_files_count);
             break;
+        case ACTION_REPLACE_ARCHIVE:
+            if(settings.out_file_name == NULL){
+                failure("Missing library file name!");
+            }
+
+            if(settings.input_files_count < 1){
+                failure("You have to set at least one input object file!");
+            }
+
+            replace_members(settings.out_file_name, settings.input_files, settings.input_files_count);
+            break;
+        case ACTION_DELETE_ARCHIVE:
+            if(settings.out_file_name == NULL){
+                failure("Missing library file name!");
+            }
+
+            if(settings.input_files_count < 1){
+                failure("You have to set at least one member to delete!");
+            }
+
+            delete_members(settings.out_file_name, settings.input_files, settings.input_files_count);
+            break;
         case ACTION_LIST_ARCHIVE:
 
             if(settings.input_files_count > 1){
@@ -114,6 +180,18 @@ int main(int argc, char **argv){
 
             extract_library(settings.input_files[0]);
             break;
+        case ACTION_SYMBOLS_ARCHIVE:
+
+            if(settings.input_files_count > 1){
+                failure("Too much input files!");
+            }
+
+            if(settings.input_files_count < 1){
+                failure("You didn't specified input file!");
+            }
+
+            list_symbols(settings.input_files[0]);
+            break;
         default:
             failure("Action didn't specified!");
     }
@@ -129,32 +207,180 @@ static void clean_mem(void){
     filelib_deinit();
 }
 
-static void create_library(char *out_file, char **input_files, unsigned file_count){
-    sl_file_t *new_lib = NULL;
+static void run_job(archiver_queue_t *queue, archiver_job_t *job){
+    (*queue->work)(job);
+}
 
-    sl_file_new(&new_lib);
+#ifdef ARCHIVER_USE_PTHREADS
+static void *archiver_worker(void *arg){
+    archiver_queue_t *queue = (archiver_queue_t *)arg;
+
+    for(;;){
+        archiver_job_t *job = NULL;
+
+        pthread_mutex_lock(&(queue->lock));
+
+        if(queue->next < queue->count){
+            job = &(queue->jobs[queue->next++]);
+        }
+
+        pthread_mutex_unlock(&(queue->lock));
+
+        if(job == NULL){
+            break;
+        }
+
+        run_job(queue, job);
+    }
+
+    return NULL;
+}
+#endif
+
+// run work on every job by pool of settings.jobs threads, results are left in
+// jobs, so caller can go through them in order
+static void run_jobs(archiver_job_t *jobs, unsigned count, archiver_work_t *work){
+    archiver_queue_t queue;
+
+    queue.jobs = jobs;
+    queue.count = count;
+    queue.next = 0;
+    queue.work = work;
+
+#ifdef ARCHIVER_USE_PTHREADS
+    unsigned threads_count = (settings.jobs < count) ? settings.jobs : count;
+
+    if(threads_count > 1){
+        unsigned started = 0;
+        pthread_t *threads = (pthread_t *)dynmem_malloc(threads_count * sizeof(pthread_t));
+
+        pthread_mutex_init(&(queue.lock), NULL);
+
+        for(unsigned i = 0; i < threads_count; i++){
+            if(pthread_create(&(threads[started]), NULL, archiver_worker, (void *)&queue) == 0){
+                started++;
+            }
+        }
+
+        for(unsigned i = 0; i < started; i++){
+            pthread_join(threads[i], NULL);
+        }
+
+        pthread_mutex_destroy(&(queue.lock));
+        dynmem_free(threads);
+    }
+#endif
+
+    //whatever is left when threads couldn't be started is done serially
+    for(; queue.next < queue.count; queue.next++){
+        run_job(&queue, &(queue.jobs[queue.next]));
+    }
+}
+
+static archiver_job_t *jobs_new(unsigned count){
+    archiver_job_t *jobs = (archiver_job_t *)dynmem_calloc(count, sizeof(archiver_job_t));
+
+    for(unsigned i = 0; i < count; i++){
+        filelib_ctx_new(&(jobs[i].files));
+    }
+
+    return jobs;
+}
+
+static void jobs_destroy(archiver_job_t *jobs, unsigned count){
+    for(unsigned i = 0; i < count; i++){
+        filelib_ctx_destroy(jobs[i].files);
+    }
+
+    dynmem_free(jobs);
+}
+
+static void load_work(archiver_job_t *job){
+    job->ok = obj_load_ctx(job->files, job->filename, &(job->object));
+}
+
+static void write_work(archiver_job_t *job){
+    job->ok = settings.binary ? obj_write_binary_ctx(job->files, job->object, job->filename) : obj_write_ctx(job->files, job->object, job->filename);
+}
+
+// load object files in parallel, but put them into library in given order
+static void load_objects(sl_file_t *lib, char **input_files, unsigned file_count){
+    archiver_job_t *jobs = jobs_new(file_count);
 
     for(unsigned i = 0; i < file_count; i++){
-        obj_file_t *tmp_obj = NULL;
-        sl_holder_t *tmp_holder = NULL;
+        jobs[i].filename = input_files[i];
+    }
 
-        char *filename = input_files[i];
+    run_jobs(jobs, file_count, &load_work);
 
-        if(!obj_load(filename, &tmp_obj)){
-            failure(filelib_error());
+    for(unsigned i = 0; i < file_count; i++){
+        if(jobs[i].ok == false){
+            job_failure(&(jobs[i]));
         }
 
-        sl_holder_new(&tmp_holder, filename, tmp_obj);
-        sl_holder_into_file(new_lib, tmp_holder);
+        sl_holder_t *tmp_holder = NULL;
+
+        sl_holder_new(&tmp_holder, jobs[i].filename, jobs[i].object);
+        sl_holder_into_file(lib, tmp_holder);
     }
 
-    if(!sl_write(new_lib, out_file)){
+    jobs_destroy(jobs, file_count);
+}
+
+static void create_library(char *out_file, char **input_files, unsigned file_count){
+    sl_file_t *new_lib = NULL;
+
+    sl_file_new(&new_lib);
+
+    load_objects(new_lib, input_files, file_count);
+
+    bool written = settings.binary ? sl_write_binary(new_lib, out_file) : sl_write(new_lib, out_file);
+
+    if(!written){
         failure(filelib_error());
     }
 
     sl_file_destroy(new_lib);
 }
 
+static void replace_members(char *out_file, char **input_files, unsigned file_count){
+    FILE *fp = fopen(out_file, "rb");
+
+    //same as with ar, library is created when it doesn't exist yet
+    if(fp == NULL){
+        create_library(out_file, input_files, file_count);
+        return;
+    }
+
+    fclose(fp);
+
+    sl_file_t *update = NULL;
+
+    sl_file_new(&update);
+
+    load_objects(update, input_files, file_count);
+
+    if(!sl_update(out_file, update, NULL, 0)){
+        sl_file_destroy(update);
+        failure(filelib_error());
+    }
+
+    sl_file_destroy(update);
+}
+
+static void delete_members(char *out_file, char **input_files, unsigned file_count){
+    sl_file_t *update = NULL;
+
+    sl_file_new(&update);
+
+    if(!sl_update(out_file, update, input_files, file_count)){
+        sl_file_destroy(update);
+        failure(filelib_error());
+    }
+
+    sl_file_destroy(update);
+}
+
 static void extract_library(char *input_archive){
     sl_file_t *lib = NULL;
 
@@ -162,7 +388,10 @@ static void extract_library(char *input_archive){
         failure(filelib_error());
     }
 
-    for(unsigned i = 0; i < list_count(lib->objects); i++){
+    unsigned count = list_count(lib->objects);
+    archiver_job_t *jobs = jobs_new(count);
+
+    for(unsigned i = 0; i < count; i++){
         sl_holder_t *holder = NULL;
         list_at(lib->objects, i, (void *)&holder);
 
@@ -170,12 +399,21 @@ static void extract_library(char *input_archive){
             fprintf(stdout, "Extracting %s\r\n", holder->object_name);
         }
 
-        if(!obj_write(holder->object, holder->object_name)){
+        jobs[i].filename = holder->object_name;
+        jobs[i].object = holder->object;
+    }
+
+    run_jobs(jobs, count, &write_work);
+
+    //first failed member is reported, same as when members are written one by one
+    for(unsigned i = 0; i < count; i++){
+        if(jobs[i].ok == false){
             sl_file_destroy(lib);
-            failure(filelib_error());
+            job_failure(&(jobs[i]));
         }
     }
 
+    jobs_destroy(jobs, count);
     sl_file_destroy(lib);
 }
 
@@ -204,6 +442,30 @@ static void list_library(char *input_archive){
     sl_file_destroy(lib);
 }
 
+static void list_symbols(char *input_archive){
+
+    sl_index_t *index = NULL;
+
+    if(!sl_load_index(input_archive, &index)){
+        failure(filelib_error());
+    }
+
+    printf("Static library %s:\r\n", input_archive);
+
+    if(index->symbol_count > 0){
+        for(unsigned i = 0; i < index->symbol_count; i++){
+            sl_index_symbol_t *symbol = &(index->symbols[i]);
+
+            printf("- %s in %s\r\n", symbol->name, index->members[symbol->member].name);
+        }
+    }
+    else{
+        printf("EMPTY\r\n");
+    }
+
+    sl_index_destroy(index);
+}
+
 static void arg_parse(int argc, char **argv){
     options_init(&args, VERSION, PROG_NAME);
     options_append_about(args, about_string);
@@ -224,10 +486,22 @@ static void arg_parse(int argc, char **argv){
     "c", "create",
     "Create an archive from given object files.");
 
+    options_append_flag_2(args,
+    "replace",
+    "Replace members of library given by -o with given object files, or append them.");
+
+    options_append_flag_2(args,
+    "delete",
+    "Delete given members from library given by -o.");
+
     options_append_flag_2(args,
     "list",
     "Print object files in archive.");
 
+    options_append_flag_2(args,
+    "symbols",
+    "Print symbols exported by object files in archive.");
+
     options_append_flag_2(args,
     "extract",
     "Extract all object files from archive into current dir.");
@@ -236,10 +510,37 @@ static void arg_parse(int argc, char **argv){
     "verbose",
     "Be verbose when extracting.");
 
+    options_append_flag_2(args,
+    "binary",
+    "Write archive or extracted object files in binary format.");
+
+    options_append_number_option_3(args,
+    "j", "jobs",
+    "Number of threads used for loading or extracting object files.");
+
     int _argc = options_parse(args, argc, argv);
     char **_argv = options_get_argv(args);
 
     settings.verbose = options_is_flag_set(args, "verbose");
+    settings.binary = options_is_flag_set(args, "binary");
+    settings.jobs = 1;
+
+    if(options_is_option_set(args, "j") || options_is_option_set(args, "jobs")){
+        long long jobs = 0;
+
+        if(options_is_option_set(args, "j")){
+            options_get_option_value_number(args, "j", &jobs);
+        }
+        else{
+            options_get_option_value_number(args, "jobs", &jobs);
+        }
+
+        if(jobs < 1 || jobs > ARCHIVER_MAX_JOBS){
+            failure("Number of jobs has to be between 1 and 256!");
+        }
+
+        settings.jobs = (unsigned)jobs;
+    }
 
     if(options_is_flag_set(args, "help") || options_is_flag_set(args, "h")){
         settings.action = ACTION_HELP;
@@ -247,9 +548,18 @@ static void arg_parse(int argc, char **argv){
     else if(options_is_flag_set(args, "version")){
         settings.action = ACTION_VERSION;
     }
+    else if(options_is_flag_set(args, "replace")){
+        settings.action = ACTION_REPLACE_ARCHIVE;
+    }
+    else if(options_is_flag_set(args, "delete")){
+        settings.action = ACTION_DELETE_ARCHIVE;
+    }
     else if(options_is_flag_set(args, "list")){
         settings.action = ACTION_LIST_ARCHIVE;
     }
+    else if(options_is_flag_set(args, "symbols")){
+        settings.action = ACTION_SYMBOLS_ARCHIVE;
+    }
     else if(options_is_flag_set(args, "extract")){
         settings.action = ACTION_EXTRACT_ARCHIVE;
     }
@@ -279,3 +589,13 @@ static void failure(char *errmsg){
     fflush(stderr);
     exit(EXIT_FAILURE);
 }
+
+static void job_failure(archiver_job_t *job){
+    char *platform_error = filelib_ctx_platform_error(job->files);
+
+    if(platform_error != NULL && platform_error[0] != '\0'){
+        fprintf(stderr, "%s\r\n", platform_error);
+    }
+
+    failure(filelib_ctx_error(job->files));
+}
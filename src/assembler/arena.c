@@ -0,0 +1,112 @@
+#include "arena.h"
+
+#include <utillib/core.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+#define CHUNK_SIZE (64 * 1024)
+#define ALIGNMENT 16
+#define ALIGN_UP(x) (((x) + (ALIGNMENT - 1)) & ~((size_t)ALIGNMENT - 1))
+#define CHUNK_HEADER_SIZE ALIGN_UP(sizeof(arena_chunk_t))
+
+static arena_chunk_t *chunk_new(size_t size);
+
+void arena_init(arena_t **arena){
+    CHECK_NULL_ARGUMENT(arena);
+    CHECK_NOT_NULL_ARGUMENT(*arena);
+
+    arena_t *tmp = (arena_t *)dynmem_calloc(1, sizeof(arena_t));
+
+    tmp->chunks = NULL;
+    tmp->used = 0;
+    tmp->allocated = 0;
+    tmp->chunk_count = 0;
+
+    *arena = tmp;
+}
+
+void arena_destroy(arena_t *arena){
+    CHECK_NULL_ARGUMENT(arena);
+
+    arena_chunk_t *chunk = arena->chunks;
+
+    while(chunk != NULL){
+        arena_chunk_t *next = chunk->next;
+        dynmem_free(chunk);
+        chunk = next;
+    }
+
+    dynmem_free(arena);
+}
+
+void *arena_alloc(arena_t *arena, size_t size){
+    CHECK_NULL_ARGUMENT(arena);
+
+    size = ALIGN_UP(size);
+
+    arena_chunk_t *chunk = arena->chunks;
+
+    if((chunk == NULL) || ((chunk->size - chunk->used) < size)){
+        size_t chunk_size = (size > CHUNK_SIZE) ? size : CHUNK_SIZE;
+
+        chunk = chunk_new(chunk_size);
+
+        // oversized chunk is put behind actual one, so free space of actual chunk isn't lost
+        if((size > CHUNK_SIZE) && (arena->chunks != NULL)){
+            chunk->next = arena->chunks->next;
+            arena->chunks->next = chunk;
+        }
+        else{
+            chunk->next = arena->chunks;
+            arena->chunks = chunk;
+        }
+
+        arena->allocated += chunk_size;
+        arena->chunk_count++;
+    }
+
+    void *retVal = (unsigned char *)chunk + CHUNK_HEADER_SIZE + chunk->used;
+
+    chunk->used += size;
+    arena->used += size;
+
+    return retVal;
+}
+
+char *arena_strdup(arena_t *arena, char *string){
+    CHECK_NULL_ARGUMENT(arena);
+    CHECK_NULL_ARGUMENT(string);
+
+    size_t length = strlen(string);
+    char *retVal = (char *)arena_alloc(arena, length + 1);
+
+    memcpy(retVal, string, length + 1);
+
+    return retVal;
+}
+
+size_t arena_get_used(arena_t *arena){
+    CHECK_NULL_ARGUMENT(arena);
+    return arena->used;
+}
+
+size_t arena_get_allocated(arena_t *arena){
+    CHECK_NULL_ARGUMENT(arena);
+    return arena->allocated;
+}
+
+unsigned arena_get_chunk_count(arena_t *arena){
+    CHECK_NULL_ARGUMENT(arena);
+    return arena->chunk_count;
+}
+
+static arena_chunk_t *chunk_new(size_t size){
+    arena_chunk_t *tmp = (arena_chunk_t *)dynmem_calloc(1, CHUNK_HEADER_SIZE + size);
+
+    tmp->next = NULL;
+    tmp->size = size;
+    tmp->used = 0;
+
+    return tmp;
+}
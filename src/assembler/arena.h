@@ -0,0 +1,33 @@
+#ifndef ARENA_H_included
+#define ARENA_H_included
+
+#include <stddef.h>
+
+// Bump allocator, memory is handed out from chunks and released only all at
+// once by arena_destroy. Returned memory is zeroed.
+
+typedef struct arena_chunk{
+    struct arena_chunk *next;
+    size_t size;
+    size_t used;
+} arena_chunk_t;
+
+typedef struct{
+    arena_chunk_t *chunks;
+    size_t used;
+    size_t allocated;
+    unsigned chunk_count;
+} arena_t;
+
+void arena_init(arena_t **arena);
+void arena_destroy(arena_t *arena);
+
+void *arena_alloc(arena_t *arena, size_t size);
+char *arena_strdup(arena_t *arena, char *string);
+
+// bytes handed out (including alignment) and bytes held in chunks
+size_t arena_get_used(arena_t *arena);
+size_t arena_get_allocated(arena_t *arena);
+unsigned arena_get_chunk_count(arena_t *arena);
+
+#endif
@@ -10,13 +10,11 @@
  */
 
 #include "preprocessor.h"
-#include "section_table.h"
-#include "symbol_table.h"
-#include "pass_item.h"
 #include "pass1.h"
 #include "pass2.h"
 #include "filegen.h"
 #include "common.h"
+#include "context.h"
 #include "verbose.h"
 
 #include <filelib.h>
@@ -29,6 +27,13 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdbool.h>
+#include <string.h>
+
+#ifdef ASSEMBLER_USE_PTHREADS
+#include <pthread.h>
+#endif
+
+#define ASSEMBLER_MAX_JOBS 256
 
 typedef enum{
     ACTION_NOT_SPECIFIED,
@@ -39,11 +44,41 @@ typedef enum{
 
 typedef struct{
     action_t action;
-    char *input_file;
+    char **input_files;
+    unsigned input_count;
     char *output_file;
+    char *output_dir;
     bool verbose;
+    bool binary;
+    unsigned jobs;
+    char *include_cache;
+    bool include_cache_stats;
+    bool depfile;
+    char *depfile_name;
+    bool depfile_skipped;
 }settings_t;
 
+// one input file, assembled in its own context by any of worker threads,
+// errors are kept until results are reported in the order of inputs
+typedef struct{
+    char *input_file;
+    char *output_file;
+    char *depfile;
+    bool ok;
+    error_t *errors;
+    unsigned include_cache_hits;
+    unsigned include_cache_misses;
+}assembler_job_t;
+
+typedef struct{
+    assembler_job_t *jobs;
+    unsigned count;
+    unsigned next;
+#ifdef ASSEMBLER_USE_PTHREADS
+    pthread_mutex_t lock;
+#endif
+}assembler_queue_t;
+
 options_t *args = NULL;
 settings_t settings;
 
@@ -51,7 +86,8 @@ char *about_string = "This is simple two pass assembler for "TARGET_ARCH_NAME" C
 
 bool argparse(int argc, char **argv);
 void memclean(void);
-bool assembler_run(char *input_filename, char *output_filename, bool verbose);
+bool assembler_run(char *input_filename, char *output_filename, preprocessor_settings_t *preprocessor_settings, bool verbose, bool binary);
+static bool assemble_files(void);
 
 int main(int argc, char **argv){
     bool retVal = false;
@@ -63,9 +99,6 @@ int main(int argc, char **argv){
 
     filelib_init();
     platformlib_init();
-    section_table_init();
-    symbol_table_init();
-    pass_item_db_init();
 
     if(argparse(argc, argv)){
         switch (settings.action) {
@@ -78,9 +111,7 @@ int main(int argc, char **argv){
                 retVal = true;
                 break;
             case ACTION_ASSEMBLE:
-                retVal = assembler_run(settings.input_file, settings.output_file, settings.verbose);
-                if(retVal == false)
-                    ERROR_WRITE("Failed to run assembler on %s!", settings.input_file);
+                retVal = assemble_files();
                 break;
             default:
                 ERROR_WRITE("Action didn't specified!");
@@ -102,6 +133,219 @@ int main(int argc, char **argv){
     }
 }
 
+// output_dir/basename of input with .obj extension
+static char *output_name(char *input_file, char *output_dir){
+    char *base = input_file;
+
+    for(char *c = input_file; *c != '\0'; c++){
+        if(*c == '/' || *c == '\\'){
+            base = c + 1;
+        }
+    }
+
+    char *dot = strrchr(base, '.');
+    size_t base_length = (dot == NULL || dot == base) ? strlen(base) : (size_t)(dot - base);
+    size_t dir_length = strlen(output_dir);
+    char *retVal = (char *)dynmem_malloc(dir_length + 1 + base_length + sizeof(".obj"));
+
+    memcpy(retVal, output_dir, dir_length);
+
+    if(dir_length > 0 && output_dir[dir_length - 1] != '/' && output_dir[dir_length - 1] != '\\'){
+        retVal[dir_length++] = '/';
+    }
+
+    memcpy(retVal + dir_length, base, base_length);
+    strcpy(retVal + dir_length + base_length, ".obj");
+
+    return retVal;
+}
+
+// output file with .d extension
+static char *depfile_name(char *output_file){
+    char *base = output_file;
+
+    for(char *c = output_file; *c != '\0'; c++){
+        if(*c == '/' || *c == '\\'){
+            base = c + 1;
+        }
+    }
+
+    char *dot = strrchr(base, '.');
+    size_t length = (dot == NULL || dot == base) ? strlen(output_file) : (size_t)(dot - output_file);
+    char *retVal = (char *)dynmem_malloc(length + sizeof(".d"));
+
+    memcpy(retVal, output_file, length);
+    strcpy(retVal + length, ".d");
+
+    return retVal;
+}
+
+static void run_job(assembler_job_t *job){
+    assembler_ctx_t *ctx = NULL;
+    preprocessor_settings_t preprocessor_settings;
+
+    preprocessor_settings.include_cache = settings.include_cache;
+    preprocessor_settings.depfile = job->depfile;
+    preprocessor_settings.depfile_target = job->output_file;
+    preprocessor_settings.depfile_skipped = settings.depfile_skipped;
+
+    assembler_ctx_new(&ctx);
+    assembler_ctx_enter(ctx);
+
+    job->ok = assembler_run(job->input_file, job->output_file, &preprocessor_settings, settings.verbose, settings.binary);
+
+    if(job->ok == false){
+        ERROR_WRITE("Failed to run assembler on %s!", job->input_file);
+    }
+
+    assembler_ctx_leave();
+
+    job->include_cache_hits = ctx->include_cache_hits;
+    job->include_cache_misses = ctx->include_cache_misses;
+
+    //errors outlive the context, they are reported when all jobs are done
+    job->errors = ctx->error_buffer;
+    ctx->error_buffer = NULL;
+
+    assembler_ctx_destroy(ctx);
+}
+
+#ifdef ASSEMBLER_USE_PTHREADS
+static void *assembler_worker(void *arg){
+    assembler_queue_t *queue = (assembler_queue_t *)arg;
+
+    for(;;){
+        assembler_job_t *job = NULL;
+
+        pthread_mutex_lock(&(queue->lock));
+
+        if(queue->next < queue->count){
+            job = &(queue->jobs[queue->next++]);
+        }
+
+        pthread_mutex_unlock(&(queue->lock));
+
+        if(job == NULL){
+            break;
+        }
+
+        run_job(job);
+    }
+
+    return NULL;
+}
+#endif
+
+static void run_jobs(assembler_queue_t *queue, unsigned threads_count){
+#ifdef ASSEMBLER_USE_PTHREADS
+    if(threads_count > 1){
+        unsigned started = 0;
+        pthread_t *threads = (pthread_t *)dynmem_malloc(threads_count * sizeof(pthread_t));
+
+        pthread_mutex_init(&(queue->lock), NULL);
+
+        for(unsigned i = 0; i < threads_count; i++){
+            if(pthread_create(&(threads[started]), NULL, assembler_worker, (void *)queue) == 0){
+                started++;
+            }
+        }
+
+        for(unsigned i = 0; i < started; i++){
+            pthread_join(threads[i], NULL);
+        }
+
+        pthread_mutex_destroy(&(queue->lock));
+        dynmem_free(threads);
+    }
+#else
+    (void)threads_count;
+#endif
+
+    //whatever is left when threads couldn't be started is done serially
+    for(; queue->next < queue->count; queue->next++){
+        run_job(&(queue->jobs[queue->next]));
+    }
+}
+
+// every input is assembled even when some of them fail, errors are reported
+// in the order of inputs
+static bool assemble_files(void){
+    bool retVal = true;
+    assembler_queue_t queue;
+
+    queue.count = settings.input_count;
+    queue.next = 0;
+    queue.jobs = (assembler_job_t *)dynmem_calloc(queue.count, sizeof(assembler_job_t));
+
+    for(unsigned i = 0; i < queue.count; i++){
+        queue.jobs[i].input_file = settings.input_files[i];
+
+        if(settings.output_dir == NULL){
+            queue.jobs[i].output_file = dynmem_strdup(settings.output_file);
+        }
+        else{
+            queue.jobs[i].output_file = output_name(settings.input_files[i], settings.output_dir);
+        }
+
+        if(settings.depfile_name != NULL){
+            queue.jobs[i].depfile = dynmem_strdup(settings.depfile_name);
+        }
+        else if(settings.depfile == true){
+            queue.jobs[i].depfile = depfile_name(queue.jobs[i].output_file);
+        }
+
+        for(unsigned j = 0; j < i; j++){
+            if(strcmp(queue.jobs[i].output_file, queue.jobs[j].output_file) == 0){
+                ERROR_WRITE("Input files %s and %s would be both assembled into %s!", queue.jobs[j].input_file, queue.jobs[i].input_file, queue.jobs[i].output_file);
+                retVal = false;
+            }
+        }
+    }
+
+    if(retVal == true){
+        //verbose output of jobs would be mixed together
+        unsigned threads_count = settings.verbose ? 1 : settings.jobs;
+
+        if(threads_count > queue.count){
+            threads_count = queue.count;
+        }
+
+        run_jobs(&queue, threads_count);
+
+        unsigned hits = 0;
+        unsigned misses = 0;
+
+        for(unsigned i = 0; i < queue.count; i++){
+            if(queue.jobs[i].ok == false){
+                fprintf(stderr, "%s", error_buffer_get(queue.jobs[i].errors));
+                retVal = false;
+            }
+
+            hits += queue.jobs[i].include_cache_hits;
+            misses += queue.jobs[i].include_cache_misses;
+        }
+
+        if(settings.include_cache_stats == true){
+            printf("Include cache: %u hits, %u misses\n", hits, misses);
+        }
+    }
+
+    for(unsigned i = 0; i < queue.count; i++){
+        if(queue.jobs[i].errors != NULL){
+            error_buffer_destroy(queue.jobs[i].errors);
+        }
+        dynmem_free(queue.jobs[i].output_file);
+
+        if(queue.jobs[i].depfile != NULL){
+            dynmem_free(queue.jobs[i].depfile);
+        }
+    }
+
+    dynmem_free(queue.jobs);
+
+    return retVal;
+}
+
 bool argparse(int argc, char **argv){
     options_init(&args, VERSION, PROG_NAME);
     options_append_about(args, about_string);
@@ -109,9 +353,18 @@ bool argparse(int argc, char **argv){
     bool retVal = true;
 
     settings.action = ACTION_NOT_SPECIFIED;
-    settings.input_file = NULL;
+    settings.input_files = NULL;
+    settings.input_count = 0;
     settings.output_file = NULL;
+    settings.output_dir = NULL;
     settings.verbose = false;
+    settings.binary = false;
+    settings.jobs = 1;
+    settings.include_cache = NULL;
+    settings.include_cache_stats = false;
+    settings.depfile = false;
+    settings.depfile_name = NULL;
+    settings.depfile_skipped = false;
 
     options_append_flag_3(args,
         "h", "help",
@@ -134,6 +387,46 @@ bool argparse(int argc, char **argv){
         "Filename for output."
     );
 
+    options_append_string_option_2(args,
+        "output-dir",
+        "Directory for output files, they are named after input files with .obj extension."
+    );
+
+    options_append_number_option_3(args,
+        "j", "jobs",
+        "Number of input files assembled in parallel."
+    );
+
+    options_append_flag_2(args,
+        "binary",
+        "Write object file in binary format."
+    );
+
+    options_append_string_option_2(args,
+        "include-cache",
+        "Directory where tokens of included files are cached between runs."
+    );
+
+    options_append_flag_2(args,
+        "include-cache-stats",
+        "Print number of include cache hits and misses."
+    );
+
+    options_append_flag_2(args,
+        "MD",
+        "Write dependency file for make next to each output file, with .d extension."
+    );
+
+    options_append_string_option_2(args,
+        "MF",
+        "Filename of dependency file, implies --MD."
+    );
+
+    options_append_flag_2(args,
+        "MD-skipped",
+        "List also files included from regions skipped by conditionals in dependency file."
+    );
+
     int _argc = options_parse(args, argc, argv);
     char **_argv = options_get_argv(args);
 
@@ -151,32 +444,94 @@ bool argparse(int argc, char **argv){
         settings.verbose = true;
     }
 
+    if(options_is_flag_set(args, "binary")){
+        settings.binary = true;
+    }
+
     if(options_is_flag_set(args, "o")){
         options_get_option_value_string(args, "o", &(settings.output_file));
     }
     else if(options_is_flag_set(args, "output")){
         options_get_option_value_string(args, "output", &(settings.output_file));
     }
-    else{
-        settings.output_file = "a.obj";
+
+    if(options_is_option_set(args, "output-dir")){
+        options_get_option_value_string(args, "output-dir", &(settings.output_dir));
+    }
+
+    if(options_is_option_set(args, "include-cache")){
+        options_get_option_value_string(args, "include-cache", &(settings.include_cache));
+    }
+
+    if(options_is_flag_set(args, "include-cache-stats")){
+        settings.include_cache_stats = true;
+    }
+
+    if(options_is_flag_set(args, "MD")){
+        settings.depfile = true;
+    }
+
+    if(options_is_option_set(args, "MF")){
+        options_get_option_value_string(args, "MF", &(settings.depfile_name));
+        settings.depfile = true;
+    }
+
+    if(options_is_flag_set(args, "MD-skipped")){
+        settings.depfile_skipped = true;
+    }
+
+    if(options_is_option_set(args, "j") || options_is_option_set(args, "jobs")){
+        long long jobs = 0;
+
+        if(options_is_option_set(args, "j")){
+            options_get_option_value_number(args, "j", &jobs);
+        }
+        else{
+            options_get_option_value_number(args, "jobs", &jobs);
+        }
+
+        if(jobs < 1 || jobs > ASSEMBLER_MAX_JOBS){
+            ERROR_WRITE("Number of jobs has to be between 1 and 256!");
+            retVal = false;
+        }
+        else{
+            settings.jobs = (unsigned)jobs;
+        }
     }
 
     if(settings.action == ACTION_NOT_SPECIFIED){
-        if(_argc == 1){
-            settings.input_file = _argv[0];
+        if(_argc >= 1){
+            settings.input_files = _argv;
+            settings.input_count = (unsigned)_argc;
             settings.action = ACTION_ASSEMBLE;
         }
         else{
-            if(_argc > 1){
-                ERROR_WRITE("Too much input files are given!");
-            }
-            else{
-                ERROR_WRITE("Not enough input files!");
-            }
+            ERROR_WRITE("Not enough input files!");
             retVal = false;
         }
     }
 
+    if(settings.output_file != NULL && settings.output_dir != NULL){
+        ERROR_WRITE("Options --output and --output-dir can't be used together!");
+        retVal = false;
+    }
+    else if(settings.output_file != NULL && settings.input_count > 1){
+        ERROR_WRITE("Option --output can be used only with single input file, use --output-dir instead!");
+        retVal = false;
+    }
+    else if(settings.depfile_name != NULL && settings.input_count > 1){
+        ERROR_WRITE("Option --MF can be used only with single input file, use --MD instead!");
+        retVal = false;
+    }
+    else if(settings.output_dir == NULL){
+        if(settings.input_count > 1){
+            settings.output_dir = ".";
+        }
+        else{
+            settings.output_file = (settings.output_file == NULL) ? "a.obj" : settings.output_file;
+        }
+    }
+
     return retVal;
 }
 
@@ -191,15 +546,12 @@ void memclean(void){
 
     filelib_deinit();
     platformlib_deinit();
-    section_table_deinit();
-    symbol_table_deinit();
-    pass_item_db_deinit();
 }
 
-bool assembler_run(char *input_filename, char *output_filename, bool verbose){
+bool assembler_run(char *input_filename, char *output_filename, preprocessor_settings_t *preprocessor_settings, bool verbose, bool binary){
     queue_t *preprocessor_output = NULL;
 
-    if(!preprocessor_run(input_filename, &preprocessor_output)){
+    if(!preprocessor_run(input_filename, preprocessor_settings, &preprocessor_output)){
         ERROR_WRITE("Failed to run preprocessor on file %s!", input_filename);
         return false;
     }
@@ -228,7 +580,7 @@ bool assembler_run(char *input_filename, char *output_filename, bool verbose){
         verbose_print_pass(2);
     }
 
-    if(!generate_file(output_filename)){
+    if(!generate_file(output_filename, binary)){
         ERROR_WRITE("Failed to generate output file %s!", output_filename);
         preprocessor_clear_output(preprocessor_output);
         return false;
@@ -2,12 +2,23 @@
 #define COMMON_H_included
 
 #include "preprocessor.h"
+#include "arena.h"
 #include <utillib/utils.h>
 
-#define ERROR_WRITE(x, ...) error_buffer_write(error_buffer, (x), ##__VA_ARGS__)
+#if defined(_MSC_VER)
+#define ASSEMBLER_THREAD_LOCAL __declspec(thread)
+#else
+#define ASSEMBLER_THREAD_LOCAL __thread
+#endif
+
+#define ERROR_WRITE(x, ...) error_buffer_write(assembler_error_buffer(), (x), ##__VA_ARGS__)
 
+// errors raised outside of any assembled file (command line and so on)
 extern error_t *error_buffer;
 
+// error buffer of context active in calling thread, global one without it
+error_t *assembler_error_buffer(void);
+
 void error_buffer_append_if_defined(preprocessed_token_t *tok);
 
 #endif
@@ -0,0 +1,91 @@
+#include "context.h"
+
+#include "common.h"
+#include "string_pool.h"
+
+#include <filelib.h>
+#include <utillib/core.h>
+
+#include <stdlib.h>
+
+static ASSEMBLER_THREAD_LOCAL assembler_ctx_t *active_ctx = NULL;
+
+void assembler_ctx_new(assembler_ctx_t **ctx){
+    CHECK_NULL_ARGUMENT(ctx);
+    CHECK_NOT_NULL_ARGUMENT(*ctx);
+
+    assembler_ctx_t *previous = active_ctx;
+
+    *ctx = (assembler_ctx_t *)dynmem_calloc(1, sizeof(assembler_ctx_t));
+
+    error_buffer_init(&((*ctx)->error_buffer));
+    filelib_ctx_new(&((*ctx)->files));
+    arena_init(&((*ctx)->arena));
+
+    // tables are initialized into active context
+    active_ctx = *ctx;
+
+    string_pool_init();
+    section_table_init();
+    symbol_table_init();
+    pass_item_db_init();
+
+    active_ctx = previous;
+}
+
+void assembler_ctx_destroy(assembler_ctx_t *ctx){
+    if(ctx == NULL)
+        return;
+
+    assembler_ctx_t *previous = active_ctx;
+
+    active_ctx = ctx;
+
+    section_table_deinit();
+    symbol_table_deinit();
+    pass_item_db_deinit();
+    string_pool_deinit();
+
+    active_ctx = (previous == ctx) ? NULL : previous;
+
+    arena_destroy(ctx->arena);
+    filelib_ctx_destroy(ctx->files);
+
+    if(ctx->error_buffer != NULL){
+        error_buffer_destroy(ctx->error_buffer);
+    }
+
+    dynmem_free(ctx);
+}
+
+void assembler_ctx_enter(assembler_ctx_t *ctx){
+    CHECK_NULL_ARGUMENT(ctx);
+
+    if(active_ctx != NULL){
+        error("Assembler context is already active in this thread!");
+    }
+
+    active_ctx = ctx;
+    filelib_ctx_enter(ctx->files);
+}
+
+void assembler_ctx_leave(void){
+    active_ctx = NULL;
+    filelib_ctx_leave();
+}
+
+assembler_ctx_t *assembler_ctx(void){
+    if(active_ctx == NULL){
+        error("No assembler context is active!");
+    }
+
+    return active_ctx;
+}
+
+error_t *assembler_error_buffer(void){
+    if(active_ctx != NULL){
+        return active_ctx->error_buffer;
+    }
+
+    return error_buffer;
+}
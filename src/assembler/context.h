@@ -0,0 +1,51 @@
+#ifndef CONTEXT_H_included
+#define CONTEXT_H_included
+
+#include "arena.h"
+#include "hash_table.h"
+#include "section_table.h"
+#include "symbol_table.h"
+#include "pass_item.h"
+
+#include <filelib.h>
+#include <utillib/core.h>
+
+#include <stddef.h>
+
+// Everything one assembled file works with. Tables are reached through the
+// context active in calling thread, so each thread can assemble its own file
+// while the table modules keep their simple interface.
+typedef struct{
+    // can be taken over by caller (and set to NULL) before context is destroyed
+    error_t *error_buffer;
+    // entered together with context, so it holds platformlib errors too
+    filelib_ctx_t *files;
+    // owns tokens, pass items, symbols, sections and interned strings
+    arena_t *arena;
+    hash_table_t *string_pool;
+    list_t *symbol_table;
+    // (section, name) -> first symbol of that name, others are chained by homonym
+    hash_table_t *symbol_index;
+    list_t *section_table;
+    section_t *actual_section;
+    list_t *item_db;
+    pass_item_t *last_item;
+    symbol_t *last_found_symbol;
+    size_t verbose_last_used;
+    // statistics of included files loaded from include cache
+    unsigned include_cache_hits;
+    unsigned include_cache_misses;
+} assembler_ctx_t;
+
+// context with all tables initialized
+void assembler_ctx_new(assembler_ctx_t **ctx);
+void assembler_ctx_destroy(assembler_ctx_t *ctx);
+
+// make context active in calling thread, leave switches back to none
+void assembler_ctx_enter(assembler_ctx_t *ctx);
+void assembler_ctx_leave(void);
+
+// active context, calling it without one is an error
+assembler_ctx_t *assembler_ctx(void);
+
+#endif
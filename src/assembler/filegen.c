@@ -3,6 +3,7 @@
 #include "symbol_table.h"
 #include "section_table.h"
 #include "common.h"
+#include "context.h"
 #include "pass_item.h"
 
 #include <utillib/core.h>
@@ -12,7 +13,7 @@
 #include <stdbool.h>
 #include <stdlib.h>
 
-bool generate_file(char *output_filename){
+bool generate_file(char *output_filename, bool binary){
     CHECK_NULL_ARGUMENT(output_filename);
 
     obj_file_t *obj_file = NULL;
@@ -76,8 +77,11 @@ bool generate_file(char *output_filename){
         obj_section_into_file(obj_file, obj_section);
     }
 
-    if(!obj_write(obj_file, output_filename)){
-        ERROR_WRITE(filelib_error());
+    filelib_ctx_t *files = assembler_ctx()->files;
+    bool written = binary ? obj_write_binary_ctx(files, obj_file, output_filename) : obj_write_ctx(files, obj_file, output_filename);
+
+    if(!written){
+        ERROR_WRITE("%s", filelib_ctx_error(files));
         obj_file_destroy(obj_file);
         return false;
     }
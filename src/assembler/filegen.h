@@ -3,6 +3,6 @@
 
 #include <stdbool.h>
 
-bool generate_file(char *output_filename);
+bool generate_file(char *output_filename, bool binary);
 
 #endif
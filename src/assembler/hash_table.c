@@ -0,0 +1,196 @@
+#include "hash_table.h"
+
+#include <utillib/core.h>
+#include <filelib.h>
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#define INITIAL_CAPACITY 64
+
+static size_t hash_key(void *scope, char *key, size_t length);
+static hash_table_entry_t *find_entry(hash_table_t *table, void *scope, char *key, size_t length, size_t hash);
+static hash_table_entry_t *insert_entry(hash_table_t *table, void *scope, char *key, size_t length, size_t hash, void *value);
+static void grow(hash_table_t *table);
+
+void hash_table_init(hash_table_t **table, arena_t *arena){
+    CHECK_NULL_ARGUMENT(table);
+    CHECK_NOT_NULL_ARGUMENT(*table);
+
+    hash_table_t *tmp = (hash_table_t *)dynmem_calloc(1, sizeof(hash_table_t));
+
+    tmp->capacity = INITIAL_CAPACITY;
+    tmp->count = 0;
+    tmp->arena = arena;
+    tmp->buckets = (hash_table_entry_t **)dynmem_calloc(tmp->capacity, sizeof(hash_table_entry_t *));
+
+    *table = tmp;
+}
+
+void hash_table_destroy(hash_table_t *table, hash_table_value_destructor_t *destructor){
+    CHECK_NULL_ARGUMENT(table);
+
+    for(size_t i = 0; i < table->capacity; i++){
+        hash_table_entry_t *entry = table->buckets[i];
+
+        while(entry != NULL){
+            hash_table_entry_t *next = entry->next;
+
+            if(destructor != NULL){
+                destructor(entry->value);
+            }
+
+            if(table->arena == NULL){
+                dynmem_free(entry->key);
+                dynmem_free(entry);
+            }
+
+            entry = next;
+        }
+    }
+
+    dynmem_free(table->buckets);
+    dynmem_free(table);
+}
+
+void *hash_table_get(hash_table_t *table, void *scope, char *key){
+    CHECK_NULL_ARGUMENT(table);
+    CHECK_NULL_ARGUMENT(key);
+
+    size_t length = strlen(key);
+    hash_table_entry_t *entry = find_entry(table, scope, key, length, hash_key(scope, key, length));
+
+    if(entry == NULL){
+        return NULL;
+    }
+
+    return entry->value;
+}
+
+char *hash_table_get_key(hash_table_t *table, void *scope, char *key){
+    CHECK_NULL_ARGUMENT(table);
+    CHECK_NULL_ARGUMENT(key);
+
+    size_t length = strlen(key);
+    hash_table_entry_t *entry = find_entry(table, scope, key, length, hash_key(scope, key, length));
+
+    if(entry == NULL){
+        return NULL;
+    }
+
+    return entry->key;
+}
+
+char *hash_table_intern_key(hash_table_t *table, void *scope, char *key, size_t length, void *value){
+    CHECK_NULL_ARGUMENT(table);
+    CHECK_NULL_ARGUMENT(key);
+
+    size_t hash = hash_key(scope, key, length);
+    hash_table_entry_t *entry = find_entry(table, scope, key, length, hash);
+
+    if(entry == NULL){
+        entry = insert_entry(table, scope, key, length, hash, value);
+    }
+
+    return entry->key;
+}
+
+bool hash_table_insert(hash_table_t *table, void *scope, char *key, void *value){
+    CHECK_NULL_ARGUMENT(table);
+    CHECK_NULL_ARGUMENT(key);
+
+    size_t length = strlen(key);
+    size_t hash = hash_key(scope, key, length);
+
+    if(find_entry(table, scope, key, length, hash) != NULL){
+        return false;
+    }
+
+    insert_entry(table, scope, key, length, hash, value);
+
+    return true;
+}
+
+size_t hash_table_count(hash_table_t *table){
+    CHECK_NULL_ARGUMENT(table);
+    return table->count;
+}
+
+// first length characters of the key, seeded by scope pointer
+static size_t hash_key(void *scope, char *key, size_t length){
+    uint64_t hash = filelib_hash(FILELIB_HASH_INIT, &scope, sizeof(scope));
+
+    hash = filelib_hash(hash, key, length);
+
+    return (size_t)(hash ^ (hash >> 32));
+}
+
+static hash_table_entry_t *find_entry(hash_table_t *table, void *scope, char *key, size_t length, size_t hash){
+    hash_table_entry_t *entry = table->buckets[hash & (table->capacity - 1)];
+
+    while(entry != NULL){
+        if((entry->hash == hash) && (entry->scope == scope) && (strncmp(entry->key, key, length) == 0) && (entry->key[length] == '\0')){
+            return entry;
+        }
+
+        entry = entry->next;
+    }
+
+    return NULL;
+}
+
+// key doesn't have to be terminated, its copy held by table is
+static hash_table_entry_t *insert_entry(hash_table_t *table, void *scope, char *key, size_t length, size_t hash, void *value){
+    if((table->count + 1) > ((table->capacity / 4) * 3)){
+        grow(table);
+    }
+
+    hash_table_entry_t *entry = NULL;
+
+    if(table->arena != NULL){
+        entry = (hash_table_entry_t *)arena_alloc(table->arena, sizeof(hash_table_entry_t));
+        entry->key = (char *)arena_alloc(table->arena, length + 1);
+    }
+    else{
+        entry = (hash_table_entry_t *)dynmem_calloc(1, sizeof(hash_table_entry_t));
+        entry->key = (char *)dynmem_malloc(length + 1);
+    }
+
+    memcpy(entry->key, key, length);
+    entry->key[length] = '\0';
+
+    entry->scope = scope;
+    entry->value = value;
+    entry->hash = hash;
+
+    size_t index = hash & (table->capacity - 1);
+    entry->next = table->buckets[index];
+    table->buckets[index] = entry;
+    table->count++;
+
+    return entry;
+}
+
+static void grow(hash_table_t *table){
+    size_t capacity = table->capacity * 2;
+    hash_table_entry_t **buckets = (hash_table_entry_t **)dynmem_calloc(capacity, sizeof(hash_table_entry_t *));
+
+    for(size_t i = 0; i < table->capacity; i++){
+        hash_table_entry_t *entry = table->buckets[i];
+
+        while(entry != NULL){
+            hash_table_entry_t *next = entry->next;
+            size_t index = entry->hash & (capacity - 1);
+
+            entry->next = buckets[index];
+            buckets[index] = entry;
+            entry = next;
+        }
+    }
+
+    dynmem_free(table->buckets);
+    table->buckets = buckets;
+    table->capacity = capacity;
+}
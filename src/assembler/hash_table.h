@@ -0,0 +1,45 @@
+#ifndef HASH_TABLE_H_included
+#define HASH_TABLE_H_included
+
+#include "arena.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+
+// Keys are pairs of scope pointer and string, scope can be NULL when only
+// string is needed. Key strings are copied into the table, values are owned
+// by caller. When arena is given, entries and keys are allocated from it and
+// they are released together with the arena.
+
+typedef struct hash_table_entry{
+    void *scope;
+    char *key;
+    void *value;
+    size_t hash;
+    struct hash_table_entry *next;
+} hash_table_entry_t;
+
+typedef struct{
+    hash_table_entry_t **buckets;
+    size_t capacity;
+    size_t count;
+    arena_t *arena;
+} hash_table_t;
+
+typedef void (hash_table_value_destructor_t)(void *value);
+
+void hash_table_init(hash_table_t **table, arena_t *arena);
+void hash_table_destroy(hash_table_t *table, hash_table_value_destructor_t *destructor);
+
+void *hash_table_get(hash_table_t *table, void *scope, char *key);
+// copy of the key held by table, NULL when key isn't present
+char *hash_table_get_key(hash_table_t *table, void *scope, char *key);
+// returns false when the key is already present, value is not replaced then
+bool hash_table_insert(hash_table_t *table, void *scope, char *key, void *value);
+// copy of the first length characters of key held by table, key is inserted
+// with value when it isn't present yet, so it is hashed only once
+char *hash_table_intern_key(hash_table_t *table, void *scope, char *key, size_t length, void *value);
+
+size_t hash_table_count(hash_table_t *table);
+
+#endif
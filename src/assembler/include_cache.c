@@ -0,0 +1,322 @@
+#include "include_cache.h"
+
+#include "common.h"
+#include "context.h"
+#include "string_pool.h"
+
+#include <utillib/core.h>
+#include <filelib.h>
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#if defined(_WIN32)
+    #include <process.h>
+    #define include_cache_getpid() ((unsigned long)_getpid())
+#else
+    #include <unistd.h>
+    #define include_cache_getpid() ((unsigned long)getpid())
+#endif
+
+// Entry layout, all numbers are little endian:
+//
+// | Size | Content                                         |
+// |------|-------------------------------------------------|
+// | 4    | Magic `M2IC`                                    |
+// | 2    | Format version                                  |
+// | 2    | Reserved                                        |
+// | 4    | Length of path                                  |
+// | n    | Path (not terminated)                           |
+// | 8    | Modification time of file                       |
+// | 8    | Size of file                                    |
+// | 8    | Hash of content                                 |
+// | 4    | Count of tokens                                 |
+//
+// Followed by tokens, each of them stored as line number (4), column (4),
+// length (4) and characters of token (not terminated).
+
+#define INCLUDE_CACHE_VERSION 1
+#define INCLUDE_CACHE_INITIAL_CAPACITY 4096
+
+typedef struct{
+    uint8_t *data;
+    size_t size;
+    size_t capacity;
+} cache_buffer_t;
+
+typedef struct{
+    uint8_t *data;
+    size_t size;
+    size_t pos;
+} cache_reader_t;
+
+static char *entry_filename(char *cache_dir, char *filename){
+    size_t dir_length = strlen(cache_dir);
+    char *retVal = (char *)dynmem_malloc(dir_length + 1 + 16 + sizeof(".tok"));
+
+    sprintf(retVal, "%s%s%016llx.tok",
+        cache_dir,
+        (dir_length > 0 && cache_dir[dir_length - 1] != '/' && cache_dir[dir_length - 1] != '\\') ? "/" : "",
+        (unsigned long long)filelib_hash(FILELIB_HASH_INIT, filename, strlen(filename))
+    );
+
+    return retVal;
+}
+
+static bool file_stamp(char *filename, int64_t *mtime, uint64_t *size){
+    struct stat info;
+
+    if(stat(filename, &info) != 0){
+        return false;
+    }
+
+    *mtime = (int64_t)info.st_mtime;
+    *size = (uint64_t)info.st_size;
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+// Serialization
+
+static void buffer_put(cache_buffer_t *buffer, void *data, size_t size){
+    if(buffer->size + size > buffer->capacity){
+        size_t capacity = (buffer->capacity == 0) ? INCLUDE_CACHE_INITIAL_CAPACITY : buffer->capacity;
+
+        while(buffer->size + size > capacity){
+            capacity *= 2;
+        }
+
+        uint8_t *tmp = (uint8_t *)dynmem_malloc(capacity);
+
+        if(buffer->data != NULL){
+            memcpy(tmp, buffer->data, buffer->size);
+            dynmem_free(buffer->data);
+        }
+
+        buffer->data = tmp;
+        buffer->capacity = capacity;
+    }
+
+    memcpy(buffer->data + buffer->size, data, size);
+    buffer->size += size;
+}
+
+static void buffer_put_number(cache_buffer_t *buffer, uint64_t value, unsigned width){
+    uint8_t bytes[8];
+
+    for(unsigned i = 0; i < width; i++){
+        bytes[i] = (uint8_t)(value >> (8 * i));
+    }
+
+    buffer_put(buffer, bytes, width);
+}
+
+static bool reader_get_number(cache_reader_t *reader, uint64_t *value, unsigned width){
+    if(reader->size - reader->pos < width){
+        return false;
+    }
+
+    *value = 0;
+
+    for(unsigned i = 0; i < width; i++){
+        *value |= ((uint64_t)reader->data[reader->pos + i]) << (8 * i);
+    }
+
+    reader->pos += width;
+
+    return true;
+}
+
+static bool reader_get_bytes(cache_reader_t *reader, uint8_t **bytes, size_t size){
+    if(reader->size - reader->pos < size){
+        return false;
+    }
+
+    *bytes = reader->data + reader->pos;
+    reader->pos += size;
+
+    return true;
+}
+
+static bool read_entry(char *entry, uint8_t **data, size_t *size){
+    FILE *fp = fopen(entry, "rb");
+
+    if(fp == NULL){
+        return false;
+    }
+
+    bool retVal = false;
+    long length = -1;
+
+    if(fseek(fp, 0, SEEK_END) == 0){
+        length = ftell(fp);
+    }
+
+    if(length > 0 && fseek(fp, 0, SEEK_SET) == 0){
+        *data = (uint8_t *)dynmem_malloc((size_t)length);
+
+        if(fread(*data, 1, (size_t)length, fp) == (size_t)length){
+            *size = (size_t)length;
+            retVal = true;
+        }
+        else{
+            dynmem_free(*data);
+            *data = NULL;
+        }
+    }
+
+    fclose(fp);
+    return retVal;
+}
+
+//-----------------------------------------------------------------------------
+// Interface
+
+bool include_cache_load(char *cache_dir, char *filename, char *content, size_t size, lexed_token_t **tokens, unsigned *count){
+    CHECK_NULL_ARGUMENT(cache_dir);
+    CHECK_NULL_ARGUMENT(filename);
+    CHECK_NULL_ARGUMENT(content);
+    CHECK_NULL_ARGUMENT(tokens);
+    CHECK_NULL_ARGUMENT(count);
+
+    int64_t mtime = 0;
+    uint64_t file_size = 0;
+
+    if(!file_stamp(filename, &mtime, &file_size)){
+        return false;
+    }
+
+    char *entry = entry_filename(cache_dir, filename);
+    cache_reader_t reader = {NULL, 0, 0};
+
+    if(!read_entry(entry, &(reader.data), &(reader.size))){
+        dynmem_free(entry);
+        return false;
+    }
+
+    dynmem_free(entry);
+
+    bool retVal = false;
+    uint8_t *magic = NULL;
+    uint8_t *path = NULL;
+    uint64_t version = 0;
+    uint64_t reserved = 0;
+    uint64_t path_length = 0;
+    uint64_t entry_mtime = 0;
+    uint64_t entry_size = 0;
+    uint64_t entry_hash = 0;
+    uint64_t token_count = 0;
+
+    if(
+        reader_get_bytes(&reader, &magic, 4) && memcmp(magic, "M2IC", 4) == 0 &&
+        reader_get_number(&reader, &version, 2) && version == INCLUDE_CACHE_VERSION &&
+        reader_get_number(&reader, &reserved, 2) &&
+        reader_get_number(&reader, &path_length, 4) &&
+        reader_get_bytes(&reader, &path, (size_t)path_length) &&
+        path_length == strlen(filename) && memcmp(path, filename, (size_t)path_length) == 0 &&
+        reader_get_number(&reader, &entry_mtime, 8) && (int64_t)entry_mtime == mtime &&
+        reader_get_number(&reader, &entry_size, 8) && entry_size == file_size && entry_size == size &&
+        reader_get_number(&reader, &entry_hash, 8) && entry_hash == filelib_hash(FILELIB_HASH_INIT, content, size) &&
+        reader_get_number(&reader, &token_count, 4) &&
+        token_count <= (reader.size - reader.pos) / 12
+    ){
+        lexed_token_t *tmp = (lexed_token_t *)arena_alloc(assembler_ctx()->arena, ((size_t)token_count + 1) * sizeof(lexed_token_t));
+        unsigned loaded = 0;
+
+        while(loaded < token_count){
+            uint64_t line_number = 0;
+            uint64_t column = 0;
+            uint64_t length = 0;
+            uint8_t *text = NULL;
+
+            if(
+                !reader_get_number(&reader, &line_number, 4) ||
+                !reader_get_number(&reader, &column, 4) ||
+                !reader_get_number(&reader, &length, 4) ||
+                length == 0 ||
+                !reader_get_bytes(&reader, &text, (size_t)length)
+            ){
+                break;
+            }
+
+            tmp[loaded].token = string_pool_intern_length((char *)text, (unsigned long)length);
+            tmp[loaded].line_number = (long)line_number;
+            tmp[loaded].column = (long)column;
+            loaded++;
+        }
+
+        if(loaded == token_count && reader.pos == reader.size){
+            *tokens = tmp;
+            *count = loaded;
+            retVal = true;
+        }
+    }
+
+    dynmem_free(reader.data);
+
+    return retVal;
+}
+
+void include_cache_store(char *cache_dir, char *filename, char *content, size_t size, lexed_token_t *tokens, unsigned count){
+    CHECK_NULL_ARGUMENT(cache_dir);
+    CHECK_NULL_ARGUMENT(filename);
+    CHECK_NULL_ARGUMENT(content);
+
+    int64_t mtime = 0;
+    uint64_t file_size = 0;
+
+    if(!file_stamp(filename, &mtime, &file_size) || file_size != size){
+        return;
+    }
+
+    cache_buffer_t buffer = {NULL, 0, 0};
+
+    buffer_put(&buffer, "M2IC", 4);
+    buffer_put_number(&buffer, INCLUDE_CACHE_VERSION, 2);
+    buffer_put_number(&buffer, 0, 2);
+    buffer_put_number(&buffer, strlen(filename), 4);
+    buffer_put(&buffer, filename, strlen(filename));
+    buffer_put_number(&buffer, (uint64_t)mtime, 8);
+    buffer_put_number(&buffer, file_size, 8);
+    buffer_put_number(&buffer, filelib_hash(FILELIB_HASH_INIT, content, size), 8);
+    buffer_put_number(&buffer, count, 4);
+
+    for(unsigned i = 0; i < count; i++){
+        size_t length = strlen(tokens[i].token);
+
+        buffer_put_number(&buffer, (uint64_t)tokens[i].line_number, 4);
+        buffer_put_number(&buffer, (uint64_t)tokens[i].column, 4);
+        buffer_put_number(&buffer, length, 4);
+        buffer_put(&buffer, tokens[i].token, length);
+    }
+
+    char *entry = entry_filename(cache_dir, filename);
+    char *tmp_entry = (char *)dynmem_malloc(strlen(entry) + 64);
+
+    //unique among processes and among jobs of this one
+    sprintf(tmp_entry, "%s.%lu.%llx.tmp", entry, include_cache_getpid(), (unsigned long long)(uintptr_t)assembler_ctx());
+
+    FILE *fp = fopen(tmp_entry, "wb");
+
+    if(fp != NULL){
+        bool written = (fwrite(buffer.data, 1, buffer.size, fp) == buffer.size);
+
+        written = (fclose(fp) == 0) && written;
+
+        //when rename fails, other writer already stored the entry
+        if(!written || rename(tmp_entry, entry) != 0){
+            remove(tmp_entry);
+        }
+    }
+
+    dynmem_free(tmp_entry);
+    dynmem_free(entry);
+    dynmem_free(buffer.data);
+}
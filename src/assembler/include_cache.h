@@ -0,0 +1,21 @@
+#ifndef INCLUDE_CACHE_H_included
+#define INCLUDE_CACHE_H_included
+
+#include "preprocessor.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+
+// Lexed content of included files kept in directory between runs. Entry is
+// named after hash of the path and it is used only when path, modification
+// time, size and hash of content all match the file. Entry holds whole token
+// stream, so #define and conditional directives of the file are replayed from
+// it as well. Entries are written into temporary file which is then renamed,
+// so concurrent writers never leave partially written entry behind.
+
+// tokens are allocated from assembler arena, false when there is no valid entry
+bool include_cache_load(char *cache_dir, char *filename, char *content, size_t size, lexed_token_t **tokens, unsigned *count);
+// storing is best effort, cache that can't be written just stays cold
+void include_cache_store(char *cache_dir, char *filename, char *content, size_t size, lexed_token_t *tokens, unsigned count);
+
+#endif
@@ -4,6 +4,7 @@
 #include "section_table.h"
 #include "common.h"
 #include "pass_item.h"
+#include "string_pool.h"
 
 #include <utillib/core.h>
 #include <utillib/utils.h>
@@ -34,14 +35,15 @@ static bool eval_pseudo(queue_t *preprocessor_output, unsigned int *position);
 static bool is_label(preprocessed_token_t *token);
 static bool eval_label(queue_t *preprocessor_output, unsigned int *position);
 static bool check_openned_section(void);
-static bool is_instru(preprocessed_token_t *token);
-static bool eval_instru(queue_t *preprocessor_output, unsigned int *position);
+static instruction_signature_t *get_instru_signature(preprocessed_token_t *token);
+static bool eval_instru(queue_t *preprocessor_output, unsigned int *position, instruction_signature_t *signature);
 
 bool pass1(queue_t *preprocessor_output){
     unsigned int position = 0;
 
     while(position < list_count(preprocessor_output)){
         bool retVal = false;
+        instruction_signature_t *signature = NULL;
 
         preprocessed_token_t *head = NULL;
         list_at(preprocessor_output, position, (void *)&head);
@@ -50,8 +52,8 @@ bool pass1(queue_t *preprocessor_output){
         if(is_pseudo(head)){
             retVal = eval_pseudo(preprocessor_output, &position);
         }
-        else if(is_instru(head)){
-            retVal = eval_instru(preprocessor_output, &position);
+        else if((signature = get_instru_signature(head)) != NULL){
+            retVal = eval_instru(preprocessor_output, &position, signature);
         }
         else if(is_label(head)){
             retVal = eval_label(preprocessor_output, &position);
@@ -82,8 +84,9 @@ static bool save_symbol(char *name, isa_address_t value, symbol_type_t type, pre
 
     unsigned long len = strlen(name);
 
+    // tokens are interned, so label is stripped into new pool entry
     if(name[len - 1] == ':'){
-        name[len - 1] = '\0';
+        name = string_pool_intern_length(name, len - 1);
     }
 
     if(!check_openned_section()){
@@ -499,43 +502,22 @@ static bool eval_label(queue_t *preprocessor_output, unsigned int *position){
 //------------------------------------------------------------------------------
 // Instructions implementation
 
-static bool is_instru(preprocessed_token_t *token){
+// signature is looked up only once per instruction, pass2 assembles instruction
+// by the one cached in pass item
+static instruction_signature_t *get_instru_signature(preprocessed_token_t *token){
     CHECK_NULL_ARGUMENT(token);
-    return platformlib_is_instruction_opcode(token->token);
+    return platformlib_get_instruction_signature(token->token);
 }
 
-static instruction_signature_t * get_instru_signature(preprocessed_token_t *token){
-    CHECK_NULL_ARGUMENT(token);
-
-    instruction_signature_t *signature = platformlib_get_instruction_signature(token->token);
-
-    if(signature == NULL){
-        error("Tryting to get type of something that isn't instruction!");
-    }
-
-    return signature;
-}
-
-static unsigned int get_instru_argc(preprocessed_token_t *token){
-    CHECK_NULL_ARGUMENT(token);
-    instruction_signature_t *signature = get_instru_signature(token);
-    return signature->argc;
-}
-
-static isa_address_t get_instru_size(preprocessed_token_t *token){
-    CHECK_NULL_ARGUMENT(token);
-    instruction_signature_t *signature = get_instru_signature(token);
-    return signature->size;
-}
-
-static bool eval_instru(queue_t *preprocessor_output, unsigned int *position){
+static bool eval_instru(queue_t *preprocessor_output, unsigned int *position, instruction_signature_t *signature){
     CHECK_NULL_ARGUMENT(preprocessor_output);
     CHECK_NULL_ARGUMENT(position);
+    CHECK_NULL_ARGUMENT(signature);
 
     preprocessed_token_t *head = NULL;
     list_at(preprocessor_output, *position, (void *)&head);
 
-    unsigned int argc_requested = get_instru_argc(head);
+    unsigned int argc_requested = signature->argc;
 
     if(argc_requested + *position + 1 > list_count(preprocessor_output)){
         ERROR_WRITE("Unexpected end of input when processing %s from %s+%ld!", head->token, head->origin.filename, head->origin.line_number);
@@ -551,6 +533,7 @@ static bool eval_instru(queue_t *preprocessor_output, unsigned int *position){
     }
 
     pass_item_db_create_item(get_location_counter(), section_table_get_actual_section(), ITEM_INST);
+    pass_item_db_get_last()->signature = signature;
     pass_item_db_append_arg(pass_item_db_get_last(), head);
 
     for(unsigned int argc_processed = 0; argc_processed < argc_requested; argc_processed++){
@@ -560,6 +543,6 @@ static bool eval_instru(queue_t *preprocessor_output, unsigned int *position){
         pass_item_db_append_arg(pass_item_db_get_last(), arg);
     }
 
-    increment_location_counter(get_instru_size(head));
+    increment_location_counter(signature->size);
     return true;
 }
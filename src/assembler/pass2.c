@@ -3,6 +3,7 @@
 #include "symbol_table.h"
 #include "section_table.h"
 #include "common.h"
+#include "context.h"
 #include "pass_item.h"
 
 #include <utillib/core.h>
@@ -15,7 +16,7 @@
 static bool assign_values_to_exported_imported_symbols(void);
 static bool assemble_instructions(void);
 
-static symbol_t *last_found_symbol = NULL;
+#define last_found_symbol (assembler_ctx()->last_found_symbol)
 
 bool pass2(void){
     if(!assign_values_to_exported_imported_symbols()){
@@ -31,28 +32,6 @@ bool pass2(void){
     return true;
 }
 
-static symbol_t *find_counterpart_to_exported_symbol(symbol_t *exported_symbol, list_t *symbol_list){
-    CHECK_NULL_ARGUMENT(exported_symbol);
-    CHECK_NULL_ARGUMENT(symbol_list);
-
-    symbol_t *retVal = NULL;
-
-    for(unsigned int i = 0; i < list_count(symbol_list); i++){
-        symbol_t *checked_symbol = NULL;
-        list_at(symbol_list, i, (void *)&checked_symbol);
-
-        if((strcmp(exported_symbol->name, checked_symbol->name) == 0) &&
-           (strcmp(exported_symbol->section->section_name, checked_symbol->section->section_name) == 0) &&
-           (checked_symbol->type != SYMBOL_TYPE_EXPORT) && (checked_symbol->type != SYMBOL_TYPE_IMPORT))
-        {
-            retVal = checked_symbol;
-            break;
-        }
-    }
-
-    return retVal;
-}
-
 static bool assign_values_to_exported_imported_symbols(void){
     list_t *sections = section_table_get_all();
     list_t *symbols = symbol_table_get_all();
@@ -72,7 +51,7 @@ static bool assign_values_to_exported_imported_symbols(void){
             head->value = head->section->last_location_counter++;
         }
         else if(head->type == SYMBOL_TYPE_EXPORT){
-            symbol_t *counterpart = find_counterpart_to_exported_symbol(head, symbols);
+            symbol_t *counterpart = symbol_table_find_definition(head->section, head->name);
 
             if(counterpart == NULL){
                 ERROR_WRITE("Definition of exported symbol %s from %s+%ld not found!", head->name, head->parent->origin.filename, head->parent->origin.line_number);
@@ -95,33 +74,25 @@ static bool find_symbol_for_instruction_assemble_callback(char *label, void *sec
     CHECK_NULL_ARGUMENT(section);
     CHECK_NULL_ARGUMENT(result);
 
-    list_t *symbols = symbol_table_get_all();
-
     if(last_found_symbol != NULL){
         error("Last found symbol isn't null! Instructions can't have multiple labels!");
     }
 
-    for(unsigned int i = 0; i < list_count(symbols); i++){
-        symbol_t *head = NULL;
-        list_at(symbols, i, (void *)&head);
+    symbol_t *head = symbol_table_find_label((section_t *)section, label);
 
-        if(
-            (strcmp(label, head->name) == 0) &&
-            (strcmp( ((section_t *)section)->section_name, head->section->section_name) == 0) &&
-            (head->type != SYMBOL_TYPE_EXPORT)
-        ){
-            if(head->type == SYMBOL_TYPE_IMPORT){
-                *result = 0;
-            }
-            else{
-                *result = head->value;
-            }
-            last_found_symbol = head;
-            return true;
-        }
+    if(head == NULL){
+        return false;
     }
 
-    return false;
+    if(head->type == SYMBOL_TYPE_IMPORT){
+        *result = 0;
+    }
+    else{
+        *result = head->value;
+    }
+
+    last_found_symbol = head;
+    return true;
 }
 
 static bool assemble_instructions(void){
@@ -132,13 +103,12 @@ static bool assemble_instructions(void){
         list_at(items, i, (void *)&head);
 
         if(head->type == ITEM_BLOB){
-            if(list_count(head->args) != 1){
+            if(head->argc != 1){
                 error("Internal error, blob pass_item need exactly one arg!");
             }
 
-            preprocessed_token_t *arg = NULL;
+            preprocessed_token_t *arg = head->args[0];
             long long num = 0;
-            list_at(head->args, 0, (void *)&arg);
 
             if(!is_number(arg->token)){
                 ERROR_WRITE("Error! Expected number at %s+%ld!", arg->origin.filename, arg->origin.line_number);
@@ -159,20 +129,17 @@ static bool assemble_instructions(void){
             head->value.blob = (isa_memory_element_t)num;
         }
         else if(head->type == ITEM_INST){
-            int argc = (int)list_count(head->args);
+            int argc = (int)head->argc;
             char **argv = (char **)dynmem_calloc(argc, sizeof(char *));
 
-            for(unsigned int j = 0; j < list_count(head->args); j++){
-                preprocessed_token_t *tok = NULL;
-                list_at(head->args, j, (void *)&tok);
-                argv[j] = tok->token;
+            for(unsigned int j = 0; j < head->argc; j++){
+                argv[j] = head->args[j]->token;
             }
 
             last_found_symbol = NULL;
 
-            if(!platformlib_assemble_instruction(argv, argc, &find_symbol_for_instruction_assemble_callback, (void *)head->section, &head->value.instr)){
-                preprocessed_token_t *instruction = NULL;
-                list_at(head->args, 0, (void *)&instruction);
+            if(!platformlib_assemble_instruction_1(head->signature, argv, argc, &find_symbol_for_instruction_assemble_callback, (void *)head->section, &head->value.instr)){
+                preprocessed_token_t *instruction = head->args[0];
 
                 ERROR_WRITE("%s", platformlib_error());
                 ERROR_WRITE("Error! Instruction at %s+%ld cannot be correctly assembled!", instruction->origin.filename, instruction->origin.line_number);
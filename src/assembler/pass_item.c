@@ -1,15 +1,21 @@
 #include "pass_item.h"
 
+#include "common.h"
+#include "context.h"
+
 #include <utillib/core.h>
 
+#include <string.h>
+
 #define CHECK_IF_INITIALIZED() {if(item_db == NULL){ error("Item db is not initialized!"); }}
 #define CHECK_IF_NOT_INITIALIZED() {if(item_db != NULL){ error("item db is already initialized!"); }}
 
-static void pass_item_destroy(pass_item_t *item);
+#define INITIAL_ARGS_CAPACITY 4
+
 static pass_item_t *pass_item_create(void);
 
-static list_t *item_db = NULL;
-static pass_item_t *last_item = NULL;
+#define item_db (assembler_ctx()->item_db)
+#define last_item (assembler_ctx()->last_item)
 
 void pass_item_db_init(void){
     CHECK_IF_NOT_INITIALIZED();
@@ -20,13 +26,7 @@ void pass_item_db_init(void){
 void pass_item_db_deinit(void){
     CHECK_IF_INITIALIZED();
 
-    for(unsigned int i = 0; i < list_count(item_db); i++){
-        pass_item_t *item = NULL;
-        list_at(item_db, i, (void *)&item);
-
-        pass_item_destroy(item);
-    }
-
+    // items and their args are owned by assembler arena
     list_destroy(item_db);
 
     item_db = NULL;
@@ -34,10 +34,13 @@ void pass_item_db_deinit(void){
 }
 
 static pass_item_t *pass_item_create(void){
-    pass_item_t *tmp = (pass_item_t *)dynmem_calloc(1, sizeof(pass_item_t));
+    pass_item_t *tmp = (pass_item_t *)arena_alloc(assembler_ctx()->arena, sizeof(pass_item_t));
 
     tmp->address = 0;
     tmp->args = NULL;
+    tmp->argc = 0;
+    tmp->args_capacity = 0;
+    tmp->signature = NULL;
     tmp->section = NULL;
     tmp->type = ITEM_INST;
     tmp->relocation = false;
@@ -46,17 +49,9 @@ static pass_item_t *pass_item_create(void){
     tmp->value.blob = 0;
     tmp->special_value = 0;
 
-    list_init(&(tmp->args), sizeof(preprocessed_token_t *));
-
     return tmp;
 }
 
-static void pass_item_destroy(pass_item_t *item){
-    CHECK_NULL_ARGUMENT(item);
-    list_destroy(item->args);
-    dynmem_free(item);
-}
-
 void pass_item_db_create_item(isa_address_t address, section_t *section, pass_item_type_t type){
     CHECK_NULL_ARGUMENT(section);
     CHECK_IF_INITIALIZED();
@@ -83,7 +78,21 @@ void pass_item_db_append_arg(pass_item_t *item, preprocessed_token_t *arg){
     CHECK_NULL_ARGUMENT(item);
     CHECK_NULL_ARGUMENT(arg);
     CHECK_IF_INITIALIZED();
-    list_append(item->args, (void *)&arg);
+
+    // arena can't grow in place, old array is simply left behind
+    if(item->argc == item->args_capacity){
+        unsigned capacity = (item->args_capacity == 0) ? INITIAL_ARGS_CAPACITY : item->args_capacity * 2;
+        preprocessed_token_t **args = (preprocessed_token_t **)arena_alloc(assembler_ctx()->arena, capacity * sizeof(preprocessed_token_t *));
+
+        if(item->argc > 0){
+            memcpy(args, item->args, item->argc * sizeof(preprocessed_token_t *));
+        }
+
+        item->args = args;
+        item->args_capacity = capacity;
+    }
+
+    item->args[item->argc++] = arg;
 }
 
 list_t *pass_item_db_get_all(void){
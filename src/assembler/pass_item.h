@@ -18,7 +18,10 @@ typedef struct{
         isa_instruction_word_t instr;
         isa_memory_element_t blob;
     }value;
-    list_t *args;
+    preprocessed_token_t **args;
+    unsigned argc;
+    unsigned args_capacity;
+    instruction_signature_t *signature;
     section_t *section;
     isa_address_t address;
     pass_item_type_t type;
@@ -1,106 +1,79 @@
 #include "preprocessor.h"
 
 #include "preprocessor_symbol_table.h"
+#include "include_cache.h"
 #include "common.h"
+#include "context.h"
+#include "string_pool.h"
+#include "hash_table.h"
 
 #include <stdbool.h>
+#include <stdio.h>
 #include <string.h>
 
 #include <utillib/core.h>
 #include <utillib/utils.h>
 
-void preprocessor_clear_file_list(void);
-static list_t *file_list = NULL;
-
-static inline unsigned int items_left(queue_t *queue, unsigned int pos){
-    return queue_count(queue) - pos - 1;
-}
-
-static inline bool is_define_a_macro(queue_t *queue, unsigned int pos){
-    CHECK_NULL_ARGUMENT(queue);
-
-    if(items_left(queue, pos) == 0)
-        return false;
-
-    token_t *next = NULL;
-
-    list_at((list_t *)queue, pos, (void *)&next);
-
-    unsigned long len = strlen(next->token);
-
-    if(next->token[len] == ')')
-        return true;
-    else
-        return false;
-}
-
-static inline bool has_define_two_args(queue_t *queue, unsigned int pos){
-    CHECK_NULL_ARGUMENT(queue);
-
-    if(items_left(queue, pos) <= 2)
-        return false;
-
-    token_t *next = NULL;
-    token_t *next_next = NULL;
-
-    list_at((list_t *)queue, pos + 0, (void *)&next);
-    list_at((list_t *)queue, pos + 1, (void *)&next_next);
-
-    if(next->line_number == next_next->line_number)
-        return true;
-    else
-        return false;
+typedef struct{
+    pst_t *symbol_table;
+    hash_table_t *guards; //filename -> name of macro guarding whole file
+    preprocessor_settings_t *settings;
+    unsigned include_depth; //main file isn't cached, only included ones
+    list_t *dependencies; //files for dependency file in order of inclusion
+    hash_table_t *dependency_set;
+} preprocessor_state_t;
+
+// conditionals of one file and detection of its include guard
+typedef struct{
+    unsigned depth; //nesting of all conditionals
+    unsigned falseifs; //nesting of conditionals inside inactive region
+    //whole file is guarded when its first line is #ifndef and matching #endif is the last one
+    char *guard;
+    bool guard_closed;
+    bool guard_possible;
+} conditional_t;
+
+static bool _preprocessor_run(char *input_file, queue_t *output, preprocessor_state_t *state);
+
+static inline bool is_word(char *word, size_t length, char *x){
+    return (strlen(x) == length && strncmp(word, x, length) == 0);
 }
 
-static bool is_token(token_t *token, char *x){
+static inline bool is_token(lexed_token_t *token, char *x){
     CHECK_NULL_ARGUMENT(token);
     CHECK_NULL_ARGUMENT(x);
 
-    if(strcmp(token->token, x) == 0)
-        return true;
-    else
-        return false;
+    return (strcmp(token->token, x) == 0);
 }
 
-static inline bool is_preprocessor(token_t *tok){
+static inline bool is_preprocessor(lexed_token_t *tok){
     CHECK_NULL_ARGUMENT(tok);
 
-    if(tok->token[0] == '#')
-        return true;
-    else
-        return false;
-}
-
-static inline bool is_include(token_t *tok){
-    return is_token(tok, "#include");
-}
-
-static inline bool is_define(token_t *tok){
-    return is_token(tok, "#define");
+    return (tok->token[0] == '#');
 }
 
-static inline bool is_ifdef(token_t *tok){
-    return is_token(tok, "#ifdef");
+static inline bool is_conditional_word(char *word, size_t length){
+    return is_word(word, length, "#ifdef") || is_word(word, length, "#ifndef") || is_word(word, length, "#endif");
 }
 
-static inline bool is_ifndef(token_t *tok){
-    return is_token(tok, "#ifndef");
-}
+//function like macros are rejected, name is split by lexer at spaces,
+//so MAX(a, b) comes as "MAX(a," and only parenthesis tells it apart
+static inline bool is_define_a_macro(lexed_token_t *tokens, unsigned count, unsigned pos){
+    if(pos >= count)
+        return false;
 
-static inline bool is_endif(token_t *tok){
-    return is_token(tok, "#endif");
+    return (strchr(tokens[pos].token, '(') != NULL);
 }
 
-static token_t *_token_load(queue_t *queue, unsigned int pos){
-    CHECK_NULL_ARGUMENT(queue);
+static inline bool has_define_two_args(lexed_token_t *tokens, unsigned count, unsigned pos){
+    if(pos + 1 >= count)
+        return false;
 
-    token_t *tmp = NULL;
-    list_at((list_t *) queue, pos, (void*)&tmp);
-    return tmp;
+    return (tokens[pos].line_number == tokens[pos + 1].line_number);
 }
 
 static preprocessed_token_t *new_preprocessed_token(){
-    preprocessed_token_t *tmp = (preprocessed_token_t *)dynmem_calloc(1, sizeof(preprocessed_token_t));
+    preprocessed_token_t *tmp = (preprocessed_token_t *)arena_alloc(assembler_ctx()->arena, sizeof(preprocessed_token_t));
 
     tmp->token = NULL;
     tmp->preprocessed = false;
@@ -114,55 +87,31 @@ static preprocessed_token_t *new_preprocessed_token(){
     return tmp;
 }
 
-static void preprocessed_token_destroy(preprocessed_token_t *token){
-    CHECK_NULL_ARGUMENT(token);
-
-    if(token->token != NULL)
-        dynmem_free(token->token);
-
-    dynmem_free(token);
-}
-
-static char *handle_filenames(char *input){
-
-    //check for existence (if found return it)
-    for(unsigned int i = 0; i < list_count(file_list); i++){
-        char *tmp = NULL;
-        list_at(file_list, i, (void *)&tmp);
-
-        if(strcmp(tmp, input) == 0){
-            return tmp;
-        }
-    }
-
-    //didn't found anything, make new record
-    char *tmp = dynmem_strdup(input);
-    list_append(file_list, (void *)&tmp);
-
-    return tmp;
-}
-
-static bool _append_into_output(token_t *token, queue_t *output, pst_t *symbol_table){
+static bool _append_into_output(char *filename, lexed_token_t *token, queue_t *output, pst_t *symbol_table){
     preprocessed_token_t *new_token = new_preprocessed_token();
 
-    new_token->token = dynmem_strdup(token->token);
+    new_token->token = token->token;
 
-    new_token->origin.filename = handle_filenames(token->filename);
+    new_token->origin.filename = filename;
     new_token->origin.column = token->column;
     new_token->origin.line_number = token->line_number;
 
-    if(pst_is_defined(symbol_table, token)){
-        token_t *symbol_value = NULL;
+    lexed_token_t *symbol_value = NULL;
+    char *defined_in = NULL;
 
-        if(!pst_get_constant_value(symbol_table, token, &symbol_value)){
-            ERROR_WRITE("Failed to load value of constant '%s' at %s+%ld.", token->token, token->filename, token->line_number);
-            preprocessed_token_destroy(new_token);
+    //every emitted token is looked up, so it is resolved by single lookup and
+    //result is kept in preprocessed token for later passes
+    if(pst_lookup(symbol_table, token, &symbol_value, &defined_in)){
+        if(symbol_value == NULL){
+            //reports why the value is missing
+            pst_get_constant_value(symbol_table, filename, token, &symbol_value);
+            ERROR_WRITE("Failed to load value of constant '%s' at %s+%ld.", token->token, filename, token->line_number);
             return false;
         }
 
         new_token->preprocessed = true;
 
-        new_token->defined.filename = handle_filenames(symbol_value->filename);
+        new_token->defined.filename = defined_in;
         new_token->defined.column = token->column;
         new_token->defined.line_number = token->line_number;
     }
@@ -179,155 +128,554 @@ static bool is_comment_start(tokenizer_t *this){
         return false;
 }
 
-static bool _preprocessor_run(char *input_file, queue_t *output, pst_t *symbol_table, list_t *to_be_cleaned){
+//-----------------------------------------------------------------------------
+// Files are scanned line by line. Conditional directives are evaluated right
+// from the line, so inactive regions are skipped without being tokenized, only
+// runs of active lines between conditionals are handed to tokenizer. Files
+// loaded from include cache are already lexed, they go through the same
+// conditionals, just line by line of tokens.
+
+static bool read_file(char *filename, char **content, size_t *size){
+    FILE *fp = fopen(filename, "rb");
+
+    if(fp == NULL){
+        return false;
+    }
+
+    bool retVal = false;
+    long length = -1;
+
+    if(fseek(fp, 0, SEEK_END) == 0){
+        length = ftell(fp);
+    }
+
+    if(length >= 0 && fseek(fp, 0, SEEK_SET) == 0){
+        *content = (char *)dynmem_malloc((size_t)length + 1);
+
+        if(fread(*content, 1, (size_t)length, fp) == (size_t)length){
+            (*content)[length] = '\0';
+            *size = (size_t)length;
+            retVal = true;
+        }
+        else{
+            dynmem_free(*content);
+            *content = NULL;
+        }
+    }
+
+    fclose(fp);
+    return retVal;
+}
+
+// tokenize text starting at first_line of file, tokens are allocated from arena
+static bool lex(char *input_file, char *text, size_t length, long first_line, lexed_token_t **tokens, unsigned *count){
     tokenizer_t *tokenizer = NULL;
     queue_t *tokenizer_output = NULL;
+    string_t *string = NULL;
+
+    //text is part of bigger buffer, so it is terminated only for a while
+    char saved = text[length];
+    text[length] = '\0';
+    string_init(&string);
+    string_append(string, text);
+    text[length] = saved;
 
     tokenizer_init(&tokenizer);
     tokenizer_config_comment(tokenizer, is_comment_start, tokenizer->methods.is_comment_end);
 
-    if(!tokenizer_tokenize_file(tokenizer, input_file)){
-        ERROR_WRITE("Failed to read file %s!", input_file);
-        return false;
-    }
+    bool retVal = tokenizer_tokenize_string(tokenizer, string);
 
     tokenizer_end(tokenizer, &tokenizer_output);
+    string_destroy(string);
 
-    bool retVal = true;
-    token_t *head = NULL;
-    unsigned falseifs = 0;
-    unsigned pos = 0;
+    if(retVal == false){
+        ERROR_WRITE("Failed to tokenize file %s!", input_file);
+    }
+    else{
+        *count = queue_count(tokenizer_output);
+        *tokens = (lexed_token_t *)arena_alloc(assembler_ctx()->arena, (*count + 1) * sizeof(lexed_token_t));
 
-    while(pos < queue_count(tokenizer_output)){
-        head = _token_load(tokenizer_output, pos++);
+        for(unsigned i = 0; i < *count; i++){
+            token_t *tmp = NULL;
+            list_at((list_t *)tokenizer_output, i, (void *)&tmp);
 
-        if(falseifs > 0){
-            if(is_ifdef(head) || is_ifndef(head)){
-                falseifs++;
-            }
+            (*tokens)[i].token = string_pool_intern(tmp->token);
+            (*tokens)[i].line_number = tmp->line_number + first_line - 1;
+            (*tokens)[i].column = tmp->column;
+        }
+    }
 
-            if(is_endif(head)){
-                falseifs--;
-            }
+    tokenizer_clean_output_queue(tokenizer_output);
+
+    return retVal;
+}
+
+// next word on the line, returns its length, zero at the end of line or at comment
+static size_t next_word(char **cursor, char *line_end, char **word){
+    char *c = *cursor;
+
+    while(c < line_end && (*c == ' ' || *c == '\t' || *c == '\r' || *c == '\v' || *c == '\f')){
+        c++;
+    }
+
+    *word = c;
+
+    while(c < line_end && *c != ' ' && *c != '\t' && *c != '\r' && *c != '\v' && *c != '\f' && *c != ';'){
+        c++;
+    }
+
+    *cursor = c;
+
+    return (size_t)(c - *word);
+}
+
+static void conditional_init(conditional_t *cond){
+    cond->depth = 0;
+    cond->falseifs = 0;
+    cond->guard = NULL;
+    cond->guard_closed = false;
+    cond->guard_possible = true;
+}
+
+// called for first word of every line which isn't empty
+static void conditional_line(conditional_t *cond, char *word, size_t length){
+    //anything before guarding #ifndef or after its #endif
+    if(cond->guard_closed || (cond->guard == NULL && !(cond->depth == 0 && is_word(word, length, "#ifndef")))){
+        cond->guard_possible = false;
+    }
+}
+
+static bool conditional_evaluate(conditional_t *cond, pst_t *symbol_table, char *input_file, long line_number, char *word, size_t length, char *arg, size_t arg_length){
+    if(is_word(word, length, "#endif")){
+        //unpaired #endif was always ignored
+        if(cond->depth > 0){
+            cond->depth--;
         }
         else{
-            if(is_preprocessor(head)){
-                if(is_include(head)){
-                    token_t *arg = _token_load(tokenizer_output, pos++);
-
-                    if(!_preprocessor_run(arg->token, output, symbol_table, to_be_cleaned)){
-                        ERROR_WRITE("Failed to preprocess file %s included at %s+%ld!", arg->token, head->filename, head->line_number);
-                        retVal = false;
-                        break;
-                    }
+            cond->guard_possible = false;
+        }
+
+        if(cond->falseifs > 0){
+            cond->falseifs--;
+        }
+
+        if(cond->depth == 0 && cond->guard != NULL){
+            cond->guard_closed = true;
+        }
+
+        return true;
+    }
+
+    if(arg_length == 0){
+        ERROR_WRITE("Missing argument of %.*s at %s+%ld!", (int)length, word, input_file, line_number);
+        return false;
+    }
+
+    if(cond->depth == 0 && cond->guard == NULL && cond->guard_possible && is_word(word, length, "#ifndef")){
+        cond->guard = string_pool_intern_length(arg, arg_length);
+    }
+
+    cond->depth++;
+
+    if(cond->falseifs > 0){
+        cond->falseifs++;
+    }
+    else{
+        char *name = string_pool_intern_length(arg, arg_length);
+        bool defined = pst_is_defined(symbol_table, name);
+
+        if(is_word(word, length, "#ifdef") ? !defined : defined){
+            cond->falseifs++;
+        }
+    }
+
+    return true;
+}
+
+static void add_dependency(preprocessor_state_t *state, char *filename){
+    if(state->settings->depfile == NULL)
+        return;
+
+    filename = string_pool_intern(filename);
+
+    if(hash_table_insert(state->dependency_set, NULL, filename, (void *)filename)){
+        list_append(state->dependencies, (void *)&filename);
+    }
+}
+
+static bool is_guarded(preprocessor_state_t *state, char *filename){
+    char *guard = (char *)hash_table_get(state->guards, NULL, filename);
+
+    return (guard != NULL && pst_is_defined(state->symbol_table, guard));
+}
+
+// tokens of active lines, there are no conditionals among them
+static bool _process_tokens(char *input_file, lexed_token_t *tokens, unsigned count, queue_t *output, preprocessor_state_t *state){
+    unsigned pos = 0;
+
+    while(pos < count){
+        lexed_token_t *head = &(tokens[pos++]);
+
+        if(is_preprocessor(head)){
+            if(is_token(head, "#include")){
+                if(pos >= count){
+                    ERROR_WRITE("Missing argument of #include at %s+%ld!", input_file, head->line_number);
+                    return false;
                 }
-                else if(is_define(head)){
-                    if(is_define_a_macro(tokenizer_output, pos)){
-                        ERROR_WRITE("Syntax error at %s+%ld!", head->filename, head->line_number);
-                        ERROR_WRITE("Macros aren't supported!");
-                        retVal = false;
-                        break;
-                    }
-
-                    token_t *name = NULL;
-                    token_t *value = NULL;
-
-                    if(has_define_two_args(tokenizer_output, pos)){
-                        name = _token_load(tokenizer_output, pos++);
-                        value = _token_load(tokenizer_output, pos++);
-                    }
-                    else{
-                        name = _token_load(tokenizer_output, pos++);
-                    }
-
-                    pst_define_constant(symbol_table, name, value);
+
+                lexed_token_t *arg = &(tokens[pos++]);
+
+                if(is_guarded(state, arg->token)){
+                    continue;
                 }
-                else if(is_ifdef(head)){
-                    token_t *arg = _token_load(tokenizer_output, pos++);
 
-                    if(!pst_is_defined(symbol_table, arg)){
-                        falseifs++;
-                    }
+                state->include_depth++;
+
+                bool included = _preprocessor_run(arg->token, output, state);
+
+                state->include_depth--;
+
+                if(!included){
+                    ERROR_WRITE("Failed to preprocess file %s included at %s+%ld!", arg->token, input_file, head->line_number);
+                    return false;
+                }
+            }
+            else if(is_token(head, "#define")){
+                if(pos >= count){
+                    ERROR_WRITE("Missing argument of #define at %s+%ld!", input_file, head->line_number);
+                    return false;
                 }
-                else if(is_ifndef(head)){
-                    token_t *arg = _token_load(tokenizer_output, pos++);
 
-                    if(pst_is_defined(symbol_table, arg)){
-                        falseifs++;
-                    }
+                if(is_define_a_macro(tokens, count, pos)){
+                    ERROR_WRITE("Syntax error at %s+%ld!", input_file, head->line_number);
+                    ERROR_WRITE("Macros aren't supported!");
+                    return false;
                 }
-                else if(is_endif(head)){
-                    //there is nothing interesting to do
+
+                lexed_token_t *name = NULL;
+                lexed_token_t *value = NULL;
+
+                if(has_define_two_args(tokens, count, pos)){
+                    name = &(tokens[pos++]);
+                    value = &(tokens[pos++]);
                 }
                 else{
-                    ERROR_WRITE("Unknown preprocessor directive %s at %s+%ld!", head->token, input_file, head->line_number);
-                    retVal = false;
-                    break;
+                    name = &(tokens[pos++]);
                 }
+
+                pst_define_constant(state->symbol_table, input_file, name, value);
+            }
+            else if(is_token(head, "#ifdef") || is_token(head, "#ifndef") || is_token(head, "#endif")){
+                ERROR_WRITE("Directive %s has to be placed at the beginning of line at %s+%ld!", head->token, input_file, head->line_number);
+                return false;
             }
             else{
-                if(!_append_into_output(head, output, symbol_table)){
-                    retVal = false;
-                    break;
+                ERROR_WRITE("Unknown preprocessor directive %s at %s+%ld!", head->token, input_file, head->line_number);
+                return false;
+            }
+        }
+        else{
+            if(!_append_into_output(input_file, head, output, state->symbol_table)){
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+// run of active lines is tokenized just before it is processed
+static bool _process_text(char *input_file, char *text, size_t length, long first_line, queue_t *output, preprocessor_state_t *state){
+    lexed_token_t *tokens = NULL;
+    unsigned count = 0;
+
+    if(!lex(input_file, text, length, first_line, &tokens, &count)){
+        return false;
+    }
+
+    return _process_tokens(input_file, tokens, count, output, state);
+}
+
+static bool _preprocess_raw(char *input_file, char *content, size_t size, queue_t *output, preprocessor_state_t *state, conditional_t *cond){
+    char *end = content + size;
+    char *line = content;
+    long line_number = 1;
+
+    char *chunk = content; //start of active lines not processed yet
+    long chunk_line = 1;
+
+    while(line < end){
+        char *line_end = memchr(line, '\n', (size_t)(end - line));
+        char *next_line = (line_end == NULL) ? end : line_end + 1;
+
+        if(line_end == NULL){
+            line_end = end;
+        }
+
+        char *cursor = line;
+        char *word = NULL;
+        size_t length = next_word(&cursor, line_end, &word);
+
+        if(length > 0){
+            conditional_line(cond, word, length);
+        }
+
+        if(length > 0 && is_conditional_word(word, length)){
+            char *arg = NULL;
+            size_t arg_length = next_word(&cursor, line_end, &arg);
+
+            //preceding active lines have to be processed, they can define the argument
+            if(cond->falseifs == 0 && chunk < line){
+                if(!_process_text(input_file, chunk, (size_t)(line - chunk), chunk_line, output, state)){
+                    return false;
                 }
             }
+
+            if(!conditional_evaluate(cond, state->symbol_table, input_file, line_number, word, length, arg, arg_length)){
+                return false;
+            }
+
+            chunk = next_line;
+            chunk_line = line_number + 1;
+        }
+        else if(cond->falseifs > 0){
+            if(state->settings->depfile_skipped && is_word(word, length, "#include")){
+                char *arg = NULL;
+                size_t arg_length = next_word(&cursor, line_end, &arg);
+
+                if(arg_length > 0){
+                    add_dependency(state, string_pool_intern_length(arg, arg_length));
+                }
+            }
+
+            chunk = next_line;
+            chunk_line = line_number + 1;
+        }
+
+        line = next_line;
+        line_number++;
+    }
+
+    if(cond->falseifs == 0 && chunk < end){
+        return _process_text(input_file, chunk, (size_t)(end - chunk), chunk_line, output, state);
+    }
+
+    return true;
+}
+
+static bool _preprocess_lexed(char *input_file, lexed_token_t *tokens, unsigned count, queue_t *output, preprocessor_state_t *state, conditional_t *cond){
+    unsigned chunk = 0; //first active token not processed yet
+    unsigned pos = 0;
+
+    while(pos < count){
+        //tokens of one line
+        unsigned line_end = pos + 1;
+
+        while(line_end < count && tokens[line_end].line_number == tokens[pos].line_number){
+            line_end++;
+        }
+
+        char *word = tokens[pos].token;
+        size_t length = strlen(word);
+
+        conditional_line(cond, word, length);
+
+        if(is_conditional_word(word, length)){
+            char *arg = (line_end > pos + 1) ? tokens[pos + 1].token : "";
+
+            if(cond->falseifs == 0 && chunk < pos){
+                if(!_process_tokens(input_file, &(tokens[chunk]), pos - chunk, output, state)){
+                    return false;
+                }
+            }
+
+            if(!conditional_evaluate(cond, state->symbol_table, input_file, tokens[pos].line_number, word, length, arg, strlen(arg))){
+                return false;
+            }
+
+            chunk = line_end;
+        }
+        else if(cond->falseifs > 0){
+            if(state->settings->depfile_skipped && is_word(word, length, "#include") && line_end > pos + 1){
+                add_dependency(state, tokens[pos + 1].token);
+            }
+
+            chunk = line_end;
+        }
+
+        pos = line_end;
+    }
+
+    if(cond->falseifs == 0 && chunk < count){
+        return _process_tokens(input_file, &(tokens[chunk]), count - chunk, output, state);
+    }
+
+    return true;
+}
+
+static bool _preprocessor_run(char *input_file, queue_t *output, preprocessor_state_t *state){
+    char *content = NULL;
+    size_t size = 0;
+
+    input_file = string_pool_intern(input_file);
+
+    if(!read_file(input_file, &content, &size)){
+        ERROR_WRITE("Failed to read file %s!", input_file);
+        return false;
+    }
+
+    add_dependency(state, input_file);
+
+    bool retVal = true;
+    conditional_t cond;
+
+    conditional_init(&cond);
+
+    if(state->settings->include_cache != NULL && state->include_depth > 0){
+        assembler_ctx_t *ctx = assembler_ctx();
+        lexed_token_t *tokens = NULL;
+        unsigned count = 0;
+
+        if(include_cache_load(state->settings->include_cache, input_file, content, size, &tokens, &count)){
+            ctx->include_cache_hits++;
+        }
+        else{
+            //whole file is lexed, so entry doesn't depend on defines
+            ctx->include_cache_misses++;
+            retVal = lex(input_file, content, size, 1, &tokens, &count);
+
+            if(retVal == true){
+                include_cache_store(state->settings->include_cache, input_file, content, size, tokens, count);
+            }
+        }
+
+        if(retVal == true){
+            retVal = _preprocess_lexed(input_file, tokens, count, output, state, &cond);
         }
     }
+    else{
+        retVal = _preprocess_raw(input_file, content, size, output, state, &cond);
+    }
+
+    if(retVal == true && cond.guard != NULL && cond.guard_closed && cond.guard_possible){
+        hash_table_insert(state->guards, NULL, input_file, (void *)cond.guard);
+    }
 
-    list_append(to_be_cleaned, (void *)&tokenizer_output);
+    dynmem_free(content);
     return retVal;
 }
 
-bool preprocessor_run(char *input_file, queue_t **output){
+//-----------------------------------------------------------------------------
+// Dependency file
+
+// spaces, # and $ have special meaning for make, ninja understands the same escapes
+static void write_depfile_name(FILE *fp, char *filename){
+    for(char *c = filename; *c != '\0'; c++){
+        if(*c == ' ' || *c == '\t' || *c == '#'){
+            fputc('\\', fp);
+        }
+        else if(*c == '$'){
+            fputc('$', fp);
+        }
+
+        fputc(*c, fp);
+    }
+}
+
+// rule of target depending on all files, every included file gets also its
+// own empty rule, so make doesn't fail when the file is removed
+static bool write_depfile(preprocessor_state_t *state){
+    char *depfile = state->settings->depfile;
+    FILE *fp = fopen(depfile, "w");
+
+    if(fp == NULL){
+        ERROR_WRITE("Failed to open dependency file %s!", depfile);
+        return false;
+    }
+
+    write_depfile_name(fp, state->settings->depfile_target);
+    fputc(':', fp);
+
+    for(unsigned i = 0; i < list_count(state->dependencies); i++){
+        char *filename = NULL;
+        list_at(state->dependencies, i, (void *)&filename);
+
+        fputs(" \\\n ", fp);
+        write_depfile_name(fp, filename);
+    }
+
+    fputc('\n', fp);
+
+    //first one is input file itself
+    for(unsigned i = 1; i < list_count(state->dependencies); i++){
+        char *filename = NULL;
+        list_at(state->dependencies, i, (void *)&filename);
+
+        fputc('\n', fp);
+        write_depfile_name(fp, filename);
+        fputs(":\n", fp);
+    }
+
+    bool retVal = !ferror(fp);
+
+    if(fclose(fp) != 0){
+        retVal = false;
+    }
+
+    if(retVal == false){
+        ERROR_WRITE("Failed to write dependency file %s!", depfile);
+    }
+
+    return retVal;
+}
+
+bool preprocessor_run(char *input_file, preprocessor_settings_t *settings, queue_t **output){
     CHECK_NULL_ARGUMENT(input_file);
+    CHECK_NULL_ARGUMENT(settings);
     CHECK_NULL_ARGUMENT(output);
     CHECK_NOT_NULL_ARGUMENT(*output);
 
-    pst_t *symbol_table = NULL;
-    list_t *to_be_cleaned = NULL; //list holding all pointers to tokenizer output queues
+    if(settings->depfile != NULL){
+        CHECK_NULL_ARGUMENT(settings->depfile_target);
+    }
+
+    preprocessor_state_t state;
+
+    state.symbol_table = NULL;
+    state.guards = NULL;
+    state.settings = settings;
+    state.include_depth = 0;
+    state.dependencies = NULL;
+    state.dependency_set = NULL;
 
     queue_init(output, sizeof(preprocessed_token_t *));
-    list_init(&to_be_cleaned, sizeof(queue_t *));
-    pst_init(&symbol_table);
+    pst_init(&(state.symbol_table));
+    hash_table_init(&(state.guards), assembler_ctx()->arena);
+    list_init(&(state.dependencies), sizeof(char *));
+    hash_table_init(&(state.dependency_set), assembler_ctx()->arena);
 
-    if(file_list == NULL){
-        list_init(&file_list, sizeof(char *));
-        atexit_register(&preprocessor_clear_file_list);
+    bool retVal = _preprocessor_run(input_file, *output, &state);
+
+    if(retVal == true && settings->depfile != NULL){
+        retVal = write_depfile(&state);
     }
 
-    bool retVal = _preprocessor_run(input_file, *output, symbol_table, to_be_cleaned);
+    pst_destroy(state.symbol_table);
+    hash_table_destroy(state.guards, NULL);
+    list_destroy(state.dependencies);
+    hash_table_destroy(state.dependency_set, NULL);
 
-    while(list_count(to_be_cleaned) > 0){
-        queue_t *tmp = NULL;
-        queue_windraw(to_be_cleaned, (void *)&tmp);
-        tokenizer_clean_output_queue(tmp);
+    if(retVal == false){
+        preprocessor_clear_output(*output);
+        *output = NULL;
     }
 
-    queue_destroy(to_be_cleaned);
-    pst_destroy(symbol_table);
-
     return retVal;
 }
 
 void preprocessor_clear_output(queue_t *queue){
     CHECK_NULL_ARGUMENT(queue);
 
-    while(queue_count(queue) > 0){
-        preprocessed_token_t *tmp = NULL;
-        queue_windraw(queue, (void *)&tmp);
-        preprocessed_token_destroy(tmp);
-    }
-
+    // tokens itself are owned by assembler arena
     queue_destroy(queue);
 }
-
-void preprocessor_clear_file_list(void){
-    if(file_list != NULL){
-        while(list_count(file_list) > 0){
-            char *tmp = NULL;
-            list_windraw(file_list, (void *)&tmp);
-            dynmem_free(tmp);
-        }
-        list_destroy(file_list);
-    }
-}
@@ -19,7 +19,25 @@ typedef struct{
     } defined;
 } preprocessed_token_t;
 
-bool preprocessor_run(char *input_file, queue_t **output);
+// token as it comes out of tokenizer or include cache, string is interned
+typedef struct{
+    char *token;
+    long line_number;
+    long column;
+} lexed_token_t;
+
+typedef struct{
+    // directory of include cache, NULL when cache isn't used
+    char *include_cache;
+    // dependency file in make format, NULL when it isn't written
+    char *depfile;
+    // target of the rule in dependency file
+    char *depfile_target;
+    // list also files included from regions skipped by conditionals
+    bool depfile_skipped;
+} preprocessor_settings_t;
+
+bool preprocessor_run(char *input_file, preprocessor_settings_t *settings, queue_t **output);
 void preprocessor_clear_output(queue_t *queue);
 
 #endif
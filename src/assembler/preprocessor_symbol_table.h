@@ -1,18 +1,27 @@
 #ifndef PREPROCESSOR_SYMBOL_TABLE_H_included
 #define PREPROCESSOR_SYMBOL_TABLE_H_included
 
+#include "hash_table.h"
+#include "preprocessor.h"
+
 #include <stdbool.h>
-#include <utillib/utils.h>
 
+// name -> definition, names are hashed, so lookup doesn't depend on number of defines
 typedef struct{
-    list_t *symbols;
+    hash_table_t *symbols;
 } pst_t;
 
 void pst_init(pst_t **table);
 void pst_destroy(pst_t *table);
 
-bool pst_define_constant(pst_t *table, token_t *name, token_t *value);
-bool pst_get_constant_value(pst_t *table, token_t *name, token_t **value);
-bool pst_is_defined(pst_t *table, token_t *name);
+// tokens don't carry filename, so it is passed along with them; tokens and
+// filename have to outlive the table
+bool pst_define_constant(pst_t *table, char *filename, lexed_token_t *name, lexed_token_t *value);
+// filename is where the constant is referenced
+bool pst_get_constant_value(pst_t *table, char *filename, lexed_token_t *name, lexed_token_t **value);
+bool pst_is_defined(pst_t *table, char *name);
+// single lookup for both questions, value is NULL when symbol is defined without value,
+// filename is where symbol was defined
+bool pst_lookup(pst_t *table, lexed_token_t *name, lexed_token_t **value, char **filename);
 
 #endif
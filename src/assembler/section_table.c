@@ -1,8 +1,10 @@
 #include "section_table.h"
 
 #include "common.h"
+#include "context.h"
 #include "symbol_table.h"
 #include "pass_item.h"
+#include "string_pool.h"
 
 #include <platformlib.h>
 #include <utillib/core.h>
@@ -20,8 +22,8 @@ static bool does_section_exist(char *section_name);
 static section_t *section_new(char *section_name);
 static void section_destroy(section_t *section);
 
-static list_t *section_table = NULL;
-static section_t *actual_section = NULL;
+#define section_table (assembler_ctx()->section_table)
+#define actual_section (assembler_ctx()->actual_section)
 
 void section_table_init(void){
     CHECK_IF_NOT_INITIALIZED();
@@ -42,6 +44,8 @@ section_t *section_table_append_or_switch(char *section_name){
     CHECK_NULL_ARGUMENT(section_name);
     CHECK_IF_INITIALIZED();
 
+    section_name = string_pool_intern(section_name);
+
     if(does_section_exist(section_name)){
         actual_section = find_section(section_name);
     }
@@ -83,7 +87,8 @@ static section_t *find_section(char *section_name){
         section_t *section = NULL;
         list_at(section_table, i, (void *)&section);
 
-        if(strcmp(section->section_name, section_name) == 0){
+        // both names are interned
+        if(section->section_name == section_name){
             retVal = section;
             break;
         }
@@ -108,9 +113,9 @@ static section_t *section_new(char *section_name){
 
     section_t *tmp = NULL;
 
-    tmp = (section_t *)dynmem_calloc(1, sizeof(section_t));
+    tmp = (section_t *)arena_alloc(assembler_ctx()->arena, sizeof(section_t));
 
-    tmp->section_name = dynmem_strdup(section_name);
+    tmp->section_name = section_name;
     tmp->last_location_counter = 0;
     tmp->items = NULL;
 
@@ -125,6 +130,4 @@ static void section_destroy(section_t *section){
 
     list_destroy(section->symbols);
     list_destroy(section->items);
-    dynmem_free(section->section_name);
-    dynmem_free(section);
 }
@@ -5,7 +5,7 @@
 #include <utillib/core.h>
 
 typedef struct{
-    char *section_name;
+    char *section_name; // interned, see string_pool.h
     isa_address_t last_location_counter;
     queue_t *items;
     list_t *symbols;
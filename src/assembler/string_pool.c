@@ -0,0 +1,41 @@
+#include "string_pool.h"
+
+#include "hash_table.h"
+#include "common.h"
+#include "context.h"
+
+#include <utillib/core.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+#define CHECK_IF_INITIALIZED() {if(string_pool == NULL){ error("String pool is not initialized!"); }}
+#define CHECK_IF_NOT_INITIALIZED() {if(string_pool != NULL){ error("String pool is already initialized!"); }}
+
+#define string_pool (assembler_ctx()->string_pool)
+
+void string_pool_init(void){
+    CHECK_IF_NOT_INITIALIZED();
+    hash_table_init(&string_pool, assembler_ctx()->arena);
+}
+
+void string_pool_deinit(void){
+    CHECK_IF_INITIALIZED();
+
+    hash_table_destroy(string_pool, NULL);
+    string_pool = NULL;
+}
+
+char *string_pool_intern(char *string){
+    CHECK_NULL_ARGUMENT(string);
+    CHECK_IF_INITIALIZED();
+
+    return hash_table_intern_key(string_pool, NULL, string, strlen(string), NULL);
+}
+
+char *string_pool_intern_length(char *string, unsigned long length){
+    CHECK_NULL_ARGUMENT(string);
+    CHECK_IF_INITIALIZED();
+
+    return hash_table_intern_key(string_pool, NULL, string, (size_t)length, NULL);
+}
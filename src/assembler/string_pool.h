@@ -0,0 +1,15 @@
+#ifndef STRING_POOL_H_included
+#define STRING_POOL_H_included
+
+// Every distinct string is stored only once and lives until the pool is
+// deinitialized, so interned strings can be compared by pointer. Interned
+// strings must not be modified.
+
+void string_pool_init(void);
+void string_pool_deinit(void);
+
+char *string_pool_intern(char *string);
+// same as string_pool_intern, but only first length characters of string are used
+char *string_pool_intern_length(char *string, unsigned long length);
+
+#endif
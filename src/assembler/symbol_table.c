@@ -1,6 +1,8 @@
 #include "symbol_table.h"
 
 #include "common.h"
+#include "context.h"
+#include "hash_table.h"
 
 #include <utillib/core.h>
 #include <utillib/utils.h>
@@ -13,27 +15,24 @@
 #define CHECK_IF_NOT_INITIALIZED() {if(symbol_table != NULL){ error("Symbol table is already initialized!"); }}
 
 static symbol_t *new_symbol(char *name, isa_address_t value, symbol_type_t type, preprocessed_token_t *parent, section_t *section);
-static void symbol_destroy(symbol_t *symbol);
-static bool compare_symbols(symbol_t *A, symbol_t *B);
+static symbol_t *find_homonym(section_t *section, char *name, bool accept_import);
 
-static list_t *symbol_table = NULL;
+#define symbol_table (assembler_ctx()->symbol_table)
+#define symbol_index (assembler_ctx()->symbol_index)
 
 void symbol_table_init(void){
     CHECK_IF_NOT_INITIALIZED();
     list_init(&symbol_table, sizeof(symbol_t *));
+    hash_table_init(&symbol_index, assembler_ctx()->arena);
 }
 
 void symbol_table_deinit(void){
     CHECK_IF_INITIALIZED();
 
-    for(unsigned int i = 0; i < list_count(symbol_table); i++){
-        symbol_t *symbol = NULL;
-        list_at(symbol_table, i, (void *)&symbol);
-
-        symbol_destroy(symbol);
-    }
-
+    // symbols itself are owned by assembler arena
+    hash_table_destroy(symbol_index, NULL);
     list_destroy(symbol_table);
+    symbol_index = NULL;
     symbol_table = NULL;
 }
 
@@ -53,22 +52,31 @@ bool symbol_table_append(char *name,
     CHECK_NULL_ARGUMENT(section);
     CHECK_IF_INITIALIZED();
 
-    symbol_t *new = new_symbol(name, value, type, parent, section);
-
-    for(unsigned int i = 0; i < list_count(symbol_table); i++){
-        symbol_t *head = NULL;
-        list_at(symbol_table, i, (void *)&head);
+    symbol_t *head = (symbol_t *)hash_table_get(symbol_index, section, name);
+    symbol_t *last = NULL;
 
-        if(compare_symbols(new, head) == true){
-            ERROR_WRITE("Multiple symbol definition! Symbol %s at %s+%ld!", new->name, new->parent->origin.filename, new->parent->origin.line_number);
-            error_buffer_append_if_defined(new->parent);
+    while(head != NULL){
+        if(head->type == type){
+            ERROR_WRITE("Multiple symbol definition! Symbol %s at %s+%ld!", name, parent->origin.filename, parent->origin.line_number);
+            error_buffer_append_if_defined(parent);
 
             ERROR_WRITE("Previously seen as %s at %s+%ld!", head->name, head->parent->origin.filename, head->parent->origin.line_number);
             error_buffer_append_if_defined(head->parent);
 
-            symbol_destroy(new);
             return false;
         }
+
+        last = head;
+        head = head->homonym;
+    }
+
+    symbol_t *new = new_symbol(name, value, type, parent, section);
+
+    if(last == NULL){
+        hash_table_insert(symbol_index, section, name, new);
+    }
+    else{
+        last->homonym = new;
     }
 
     list_append(symbol_table, (void *)&new);
@@ -77,6 +85,22 @@ bool symbol_table_append(char *name,
     return true;
 }
 
+symbol_t *symbol_table_find_definition(section_t *section, char *name){
+    CHECK_NULL_ARGUMENT(section);
+    CHECK_NULL_ARGUMENT(name);
+    CHECK_IF_INITIALIZED();
+
+    return find_homonym(section, name, false);
+}
+
+symbol_t *symbol_table_find_label(section_t *section, char *name){
+    CHECK_NULL_ARGUMENT(section);
+    CHECK_NULL_ARGUMENT(name);
+    CHECK_IF_INITIALIZED();
+
+    return find_homonym(section, name, true);
+}
+
 static symbol_t *new_symbol(char *name,
                             isa_address_t value,
                             symbol_type_t type,
@@ -87,32 +111,34 @@ static symbol_t *new_symbol(char *name,
     CHECK_NULL_ARGUMENT(parent);
     CHECK_NULL_ARGUMENT(section);
 
-    symbol_t *tmp = (symbol_t *)dynmem_calloc(1, sizeof(symbol_t));
+    symbol_t *tmp = (symbol_t *)arena_alloc(assembler_ctx()->arena, sizeof(symbol_t));
 
     tmp->name = name;
     tmp->value = value;
     tmp->type = type;
     tmp->parent = parent;
     tmp->section = section;
+    tmp->homonym = NULL;
 
     return tmp;
 }
 
-static void symbol_destroy(symbol_t *symbol){
-    CHECK_NULL_ARGUMENT(symbol);
+static symbol_t *find_homonym(section_t *section, char *name, bool accept_import){
+    symbol_t *head = (symbol_t *)hash_table_get(symbol_index, section, name);
 
-    dynmem_free(symbol);
-}
+    while(head != NULL){
+        if(head->type == SYMBOL_TYPE_EXPORT){
+            head = head->homonym;
+            continue;
+        }
 
-static bool compare_symbols(symbol_t *A, symbol_t *B){
-    if(
-        (strcmp(A->name, B->name) == 0) &&
-        (strcmp(A->section->section_name, B->section->section_name) == 0) &&
-        (A->type == B->type)
-    ){
-        return true;
-    }
-    else{
-        return false;
+        if((head->type == SYMBOL_TYPE_IMPORT) && (accept_import == false)){
+            head = head->homonym;
+            continue;
+        }
+
+        return head;
     }
+
+    return NULL;
 }
@@ -13,12 +13,13 @@ typedef enum{
     SYMBOL_TYPE_EXPORT
 } symbol_type_t;
 
-typedef struct{
-    char *name;
+typedef struct symbol{
+    char *name; // interned, see string_pool.h
     isa_address_t value;
     symbol_type_t type;
     preprocessed_token_t *parent;
     section_t *section;
+    struct symbol *homonym; // next symbol of the same name in the same section
 } symbol_t;
 
 void symbol_table_init(void);
@@ -30,6 +31,11 @@ bool symbol_table_append(char *name,
                          preprocessed_token_t *parent,
                          section_t *section);
 
+// symbol defined in section (neither import nor export), NULL if not found
+symbol_t *symbol_table_find_definition(section_t *section, char *name);
+// symbol which label in section refers to (anything but export), NULL if not found
+symbol_t *symbol_table_find_label(section_t *section, char *name);
+
 list_t *symbol_table_get_all(void);
 
 #endif
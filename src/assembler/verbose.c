@@ -4,6 +4,8 @@
 #include "pass_item.h"
 #include "section_table.h"
 #include "symbol_table.h"
+#include "common.h"
+#include "context.h"
 
 #include <utillib/core.h>
 
@@ -18,6 +20,16 @@ static void spacer_2(char *title, int num){
     fprintf(stdout, "\r\n------------------\r\n%s %d\r\n", title, num);
 }
 
+static void memory_usage(void){
+    assembler_ctx_t *ctx = assembler_ctx();
+    size_t used = arena_get_used(ctx->arena);
+
+    fprintf(stdout, "Memory: %zu bytes used (+%zu), %zu bytes in %u chunks\r\n",
+        used, used - ctx->verbose_last_used, arena_get_allocated(ctx->arena), arena_get_chunk_count(ctx->arena));
+
+    ctx->verbose_last_used = used;
+}
+
 void verbose_print_preprocessor(queue_t *preprocessor_output){
     CHECK_NULL_ARGUMENT(preprocessor_output);
 
@@ -37,6 +49,8 @@ void verbose_print_preprocessor(queue_t *preprocessor_output){
 
         string_destroy(line);
     }
+
+    memory_usage();
 }
 
 void verbose_print_pass(int pass){
@@ -75,10 +89,8 @@ void verbose_print_pass(int pass){
             }
             else{
                 if(pass == 1){
-                    for(unsigned int j = 0; j < list_count(head_item->args); j++){
-                        preprocessed_token_t *tok = NULL;
-                        list_at(head_item->args, j, (void *)&tok);
-                        fprintf(stdout, "%s ", tok->token);
+                    for(unsigned int j = 0; j < head_item->argc; j++){
+                        fprintf(stdout, "%s ", head_item->args[j]->token);
                     }
                 }
                 else if(pass == 2){
@@ -95,8 +107,11 @@ void verbose_print_pass(int pass){
             dynmem_free(address);
         }
     }
+
+    memory_usage();
 }
 
 void verbose_print_generate(void){
     spacer("generate");
+    memory_usage();
 }
@@ -3,6 +3,8 @@
 #include <string.h>
 #include <limits.h>
 
+#define IHEX_BACKEND_BLOCK_SIZE 256
+
 static ihex_backend_settings *settings_ptr = NULL;
 
 void ihex_backend_args_init(options_t *args, ihex_backend_settings *ihex_settings){
@@ -74,14 +76,26 @@ bool ihex_backend_convert(ldm_memory_t *memory, char *output_filename){
         ihex_set_start_linear_address(file, settings_ptr->start_linear_address.address);
     }
 
-    for(unsigned i = 0; i < list_count(memory->items); i++){
-        ldm_item_t *head = NULL;
-        uint8_t tmpVar = 0;
+    //consecutive written elements are passed as single block, offset is relative to memory origin;
+    //elements are converted one by one, image doesn't have to be array of bytes
+    uint8_t block[IHEX_BACKEND_BLOCK_SIZE];
+    unsigned long offset = 0;
+
+    while(memory->image != NULL && offset < (unsigned long)memory->size){
+        if(!ldm_mem_is_covered(memory, (isa_address_t)offset)){
+            offset++;
+            continue;
+        }
 
-        list_at(memory->items, i, (void *)&head);
-        tmpVar = head->word;
+        unsigned long length = 0;
+
+        while((offset + length) < (unsigned long)memory->size && length < IHEX_BACKEND_BLOCK_SIZE && ldm_mem_is_covered(memory, (isa_address_t)(offset + length))){
+            block[length] = (uint8_t)memory->image[offset + length];
+            length++;
+        }
 
-        ihex_set_relative(file, i, 1, &tmpVar);
+        ihex_set_relative(file, offset, length, block);
+        offset += length;
     }
 
     retVal = ihex_write(file, output_filename);
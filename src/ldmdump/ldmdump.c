@@ -88,6 +88,13 @@ static bool run_backend(bool (*convert_f)(ldm_memory_t *, char *)){
     for(unsigned i = 0; i < list_count(ldm_file->memories); i++){
         list_at(ldm_file->memories, i, (void *)&memory);
 
+        //backends read memory content directly from dense image
+        if(!ldm_mem_convert_to_image(memory)){
+            ERROR_WRITE("Memory %s in %s contains data outside of its range or it is too large!", memory->memory_name, settings.input_file);
+            retVal = false;
+            break;
+        }
+
         if(settings.all == true){
             char *tmp_file_name = get_filename_for_mem(memory);
 
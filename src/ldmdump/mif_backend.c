@@ -108,15 +108,18 @@ bool mif_backend_convert(ldm_memory_t *memory, char *output_filename){
     mif_init(&mif, size, sizeof(isa_memory_element_t) * CHAR_BIT);
     mif_config_radixes(mif, settings_ptr->data_radix, settings_ptr->address_radix);
 
-    for(unsigned i = 0; i < list_count(memory->items); i++){
-        ldm_item_t *head = NULL;
+    for(unsigned long i = 0; memory->image != NULL && i < (unsigned long)memory->size; i++){
         uintmax_t tmpVar = 0;
 
-        list_at(memory->items, i, (void *)&head);
-        tmpVar = head->word;
+        if(!ldm_mem_is_covered(memory, (isa_address_t)i)){
+            continue;
+        }
+
+        tmpVar = memory->image[i];
 
-        if(!mif_set(mif, head->address - memory->begin_addr, 1, &tmpVar)){
+        if(!mif_set(mif, i, 1, &tmpVar)){
             ERROR_WRITE("Failed in MIF building.");
+            mif_destroy(mif);
             return false;
         }
     }
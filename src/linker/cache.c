@@ -11,6 +11,8 @@
 #include <string.h>
 #include <stdio.h>
 
+#define CACHE_SYMBOL_INDEX_INITIAL_COUNT 32
+
 static cache_section_item_t *cache_section_item_new(obj_section_t *section);
 static void cache_section_item_destroy(cache_section_item_t *item);
 static cache_symbol_item_t *cache_symbol_item_new(void);
@@ -26,19 +28,24 @@ void cache_new(cache_t **cache){
 
     (*cache)->all.sections = NULL;
     (*cache)->all.symbols = NULL;
+    (*cache)->all.stripped = NULL;
     (*cache)->files.obj_files = NULL;
-    (*cache)->files.sl_files = NULL;
+    (*cache)->files.libraries = NULL;
     (*cache)->symbols.imported = NULL;
     (*cache)->symbols.exported = NULL;
+    (*cache)->symbols.index = NULL;
     (*cache)->offsets = NULL;
 
     list_init(&((*cache)->all.sections), sizeof(cache_section_item_t *));
     list_init(&((*cache)->all.symbols), sizeof(cache_symbol_item_t *));
-    list_init(&((*cache)->files.obj_files), sizeof(obj_file_t *));
-    list_init(&((*cache)->files.sl_files), sizeof(sl_file_t *));
+    list_init(&((*cache)->all.stripped), sizeof(cache_section_item_t *));
+    list_init(&((*cache)->files.obj_files), sizeof(obj_view_t *));
+    list_init(&((*cache)->files.libraries), sizeof(library_t *));
     list_init(&((*cache)->symbols.exported), sizeof(cache_symbol_item_t *));
     list_init(&((*cache)->symbols.imported), sizeof(cache_symbol_item_t *));
     list_init(&((*cache)->offsets), sizeof(cache_ldm_mem_holder_t *));
+
+    name_table_new(&((*cache)->symbols.index), CACHE_SYMBOL_INDEX_INITIAL_COUNT);
 }
 
 void cache_destroy(cache_t *this){
@@ -54,22 +61,31 @@ void cache_destroy(cache_t *this){
         list_destroy(this->all.sections);
     }
 
+    if(this->all.stripped != NULL){
+        while(list_count(this->all.stripped) > 0){
+            cache_section_item_t *tmp = NULL;
+            list_windraw(this->all.stripped, (void *)&tmp);
+            cache_section_item_destroy(tmp);
+        }
+        list_destroy(this->all.stripped);
+    }
+
     if(this->files.obj_files != NULL){
         while(list_count(this->files.obj_files) > 0){
-            obj_file_t *tmp = NULL;
+            obj_view_t *tmp = NULL;
             list_windraw(this->files.obj_files, (void *)&tmp);
-            obj_file_destroy(tmp);
+            obj_view_close(tmp);
         }
         list_destroy(this->files.obj_files);
     }
 
-    if(this->files.sl_files != NULL){
-        while(list_count(this->files.sl_files) > 0){
-            sl_file_t *tmp = NULL;
-            list_windraw(this->files.sl_files, (void *)&tmp);
-            sl_file_destroy(tmp);
+    if(this->files.libraries != NULL){
+        while(list_count(this->files.libraries) > 0){
+            library_t *tmp = NULL;
+            list_windraw(this->files.libraries, (void *)&tmp);
+            library_destroy(tmp);
         }
-        list_destroy(this->files.sl_files);
+        list_destroy(this->files.libraries);
     }
 
     if(this->symbols.exported != NULL){
@@ -80,6 +96,8 @@ void cache_destroy(cache_t *this){
         list_destroy(this->symbols.imported);
     }
 
+    name_table_destroy(this->symbols.index);
+
     if(this->all.symbols != NULL){
         while(list_count(this->all.symbols) > 0){
             cache_symbol_item_t *tmp = NULL;
@@ -111,6 +129,14 @@ static cache_section_item_t *cache_section_item_new(obj_section_t *section){
     tmp->used = false;
     tmp->size = 0;
     tmp->offset = 0;
+    tmp->import_slots = NULL;
+    tmp->import_slot_count = 0;
+    tmp->data.address = NULL;
+    tmp->data.payload = NULL;
+    tmp->data.special_value = NULL;
+    tmp->data.flags = NULL;
+    tmp->data.count = 0;
+    tmp->data.capacity = 0;
 
     return tmp;
 }
@@ -119,6 +145,19 @@ static void cache_section_item_destroy(cache_section_item_t *item){
     if(item == NULL)
         return;
 
+    if(item->import_slots != NULL){
+        dynmem_free(item->import_slots);
+    }
+
+    if(item->data.capacity > 0){
+        dynmem_free(item->data.address);
+        dynmem_free(item->data.payload);
+        dynmem_free(item->data.special_value);
+        dynmem_free(item->data.flags);
+    }
+
+    obj_section_destroy(item->section);
+
     dynmem_free(item);
 }
 
@@ -193,85 +232,100 @@ static isa_address_t get_instru_size(isa_instruction_word_t word){
     return signature->size;
 }
 
-static isa_address_t get_section_size(obj_section_t *section){
-    CHECK_NULL_ARGUMENT(section);
+static void *grow_array(void *array, unsigned int count, unsigned int capacity, size_t size){
+    void *tmp = dynmem_malloc(capacity * size);
 
-    isa_address_t size = 0;
+    if(array != NULL){
+        memcpy(tmp, array, count * size);
+        dynmem_free(array);
+    }
 
-    for(unsigned int i = 0; i < list_count(section->data_symbol_list); i++){
-        obj_data_t *head = NULL;
-        list_at(section->data_symbol_list, i, (void *)&head);
+    return tmp;
+}
 
-        if(head->blob){
-            size += 1;
-        }
-        else{
-            size += get_instru_size(head->payload.data_value);
-        }
+static void reserve_section_data(cache_section_data_t *data, unsigned int count){
+    if(data->capacity >= count){
+        return;
     }
 
-    return size;
+    unsigned int capacity = (data->capacity == 0) ? 64 : data->capacity;
+
+    while(capacity < count){
+        capacity *= 2;
+    }
+
+    data->address = (isa_address_t *)grow_array(data->address, data->count, capacity, sizeof(isa_address_t));
+    data->payload = (isa_instruction_word_t *)grow_array(data->payload, data->count, capacity, sizeof(isa_instruction_word_t));
+    data->special_value = (isa_address_t *)grow_array(data->special_value, data->count, capacity, sizeof(isa_address_t));
+    data->flags = (uint8_t *)grow_array(data->flags, data->count, capacity, sizeof(uint8_t));
+    data->capacity = capacity;
 }
 
-static bool merge_sections(obj_section_t *A, obj_section_t *B){
+// append content of section from object view at the end of cache owned section
+static bool merge_section_view(cache_section_item_t *A, obj_view_t *view, obj_section_view_t *B){
     CHECK_NULL_ARGUMENT(A);
+    CHECK_NULL_ARGUMENT(view);
     CHECK_NULL_ARGUMENT(B);
 
     //get informations about old section
-    isa_address_t address_offset = get_section_size(A);
-    unsigned int import_label_counter = list_count(A->imported_symbol_list);
+    isa_address_t address_offset = A->size;
+    unsigned int import_label_counter = list_count(A->section->imported_symbol_list);
 
     //copy symbols with new values
-    for(unsigned int i = 0; i < list_count(B->exported_symbol_list); i++){
-        obj_symbol_t *head = NULL;
+    for(unsigned int i = 0; i < B->exported_count; i++){
+        obj_symbol_t head;
         obj_symbol_t *new = NULL;
 
-        list_at(B->exported_symbol_list, i, (void *)&head);
-        obj_symbol_new(&new, head->name, head->value + address_offset);
-        obj_exported_symbol_into_section(A, new);
+        obj_view_exported_symbol(view, B, i, &head);
+        obj_symbol_new(&new, head.name, head.value + address_offset);
+        obj_exported_symbol_into_section(A->section, new);
     }
 
-    for(unsigned int i = 0; i < list_count(B->imported_symbol_list); i++){
-        obj_symbol_t *head = NULL;
+    for(unsigned int i = 0; i < B->imported_count; i++){
+        obj_symbol_t head;
         obj_symbol_t *new = NULL;
 
-        list_at(B->imported_symbol_list, i, (void *)&head);
-        obj_symbol_new(&new, head->name, head->value + import_label_counter);
-        obj_imported_symbol_into_section(A, new);
+        obj_view_imported_symbol(view, B, i, &head);
+        obj_symbol_new(&new, head.name, head.value + import_label_counter);
+        obj_imported_symbol_into_section(A->section, new);
     }
 
-    //copy data
-    for(unsigned int i = 0; i < list_count(B->data_symbol_list); i++){
-        obj_data_t *head = NULL;
+    //copy data, decoded once from view into packed arrays
+    cache_section_data_t *data = &(A->data);
+    reserve_section_data(data, data->count + B->data_count);
 
-        list_at(B->data_symbol_list, i, (void *)&head);
+    for(unsigned int i = 0; i < B->data_count; i++){
+        obj_data_t head;
+        unsigned int n = data->count;
 
-        if(head->blob == false){
-            obj_data_t *new = NULL;
+        obj_view_data(B, i, &head);
 
-            obj_data_new(
-                &new,
-                head->address + address_offset,
-                head->payload.data_value,
-                head->relocation,
-                head->special,
-                head->special ? head->special_value + import_label_counter : head->special_value
-            );
-            if(new->relocation == true){
-                if(!platformlib_relocate_instruction(new->payload.data_value, &(new->payload.data_value), address_offset)){
+        data->address[n] = head.address + address_offset;
+
+        if(head.blob == false){
+            data->payload[n] = head.payload.data_value;
+            data->special_value[n] = head.special ? head.special_value + import_label_counter : head.special_value;
+            data->flags[n] = (head.relocation ? CACHE_DATA_RELOCATION : 0) | (head.special ? CACHE_DATA_SPECIAL : 0);
+
+            if(head.relocation == true){
+                if(!platformlib_relocate_instruction(data->payload[n], &(data->payload[n]), address_offset)){
                     ERROR_WRITE("Platform lib error in merging sections.");
                     ERROR_WRITE("%s", platformlib_error());
-                    obj_data_destroy(new);
                     return false;
                 }
             }
-            obj_data_into_section(A, new);
+
+            A->size += get_instru_size(data->payload[n]);
         }
         else{
-            obj_data_t *new = NULL;
-            obj_blob_new(&new, head->address + address_offset, head->payload.blob_value);
-            obj_blob_into_section(A, new);
+            data->payload[n] = head.payload.blob_value;
+            data->special_value[n] = 0;
+            data->flags[n] = CACHE_DATA_BLOB;
+
+            A->size += 1;
         }
+
+        data->count++;
     }
 
     return true;
@@ -286,103 +340,184 @@ static bool is_section_exist(cache_t *this, char *section_name){
     }
 }
 
-static bool process_obj_file_load(cache_t *this, obj_file_t *obj){
+static bool process_obj_view_load(cache_t *this, obj_view_t *view){
     CHECK_NULL_ARGUMENT(this);
-    CHECK_NULL_ARGUMENT(obj);
+    CHECK_NULL_ARGUMENT(view);
 
     bool retVal = true;
 
-    for(unsigned i = 0; i < list_count(obj->section_list); i++){
-        obj_section_t *section = NULL;
+    for(unsigned i = 0; i < view->section_count; i++){
+        obj_section_view_t section;
         cache_section_item_t *section_item = NULL;
-        list_at(obj->section_list, i, (void *)&section);
 
-        if(is_section_exist(this, section->section_name)){
-            cache_section_item_t *old = find_section_by_name(this, section->section_name);
-            if(!merge_sections(old->section, section)){
-                retVal = false;
-                break;
-            }
-            section_item = old;
+        obj_view_section(view, i, &section);
+
+        if(is_section_exist(this, section.section_name)){
+            section_item = find_section_by_name(this, section.section_name);
         }
         else{
-            cache_section_item_t *new_item = cache_section_item_new(section);
-            list_append(this->all.sections, (void *)&new_item);
-            section_item = new_item;
+            obj_section_t *new_section = NULL;
+            obj_section_new(section.section_name, &new_section);
+
+            section_item = cache_section_item_new(new_section);
+            list_append(this->all.sections, (void *)&section_item);
         }
 
-        section_item->size = get_section_size(section_item->section);
+        if(!merge_section_view(section_item, view, &section)){
+            retVal = false;
+            break;
+        }
     }
 
     return retVal;
 }
 
-bool cache_load_object_file(cache_t *this, char *filename){
+bool cache_merge_object_view(cache_t *this, obj_view_t *view){
     CHECK_NULL_ARGUMENT(this);
-    CHECK_NULL_ARGUMENT(filename);
+    CHECK_NULL_ARGUMENT(view);
 
-    obj_file_t *tmp = NULL;
-
-    if(!obj_load(filename, &tmp)){
-        ERROR_WRITE("Failed to load object file %s.", filename);
-        ERROR_WRITE("Filelib error: %s", filelib_error());
+    if(!process_obj_view_load(this, view)){
         return false;
     }
 
-    if(!process_obj_file_load(this, tmp)){
-        obj_file_destroy(tmp);
-        return false;
-    }
-
-    list_append(this->files.obj_files, (void *)&tmp);
+    list_append(this->files.obj_files, (void *)&view);
 
     return true;
 }
 
-bool cache_load_library_file(cache_t *this, char *filename){
+void cache_add_library(cache_t *this, library_t *library){
     CHECK_NULL_ARGUMENT(this);
-    CHECK_NULL_ARGUMENT(filename);
+    CHECK_NULL_ARGUMENT(library);
 
-    sl_file_t *tmp = NULL;
+    list_append(this->files.libraries, (void *)&library);
+}
 
-    if(!sl_load(filename, &tmp)){
-        ERROR_WRITE("Failed to load static library %s.", filename);
-        ERROR_WRITE("Filelib error: %s", filelib_error());
-        return false;
+//-----------------------------------
+// Library members
+
+// remember exports as defined and queue imports that are seen for the first time
+static void collect_view_symbols(obj_view_t *view, name_table_t *defined, name_table_t *seen, list_t *worklist){
+    for(unsigned int i = 0; i < view->section_count; i++){
+        obj_section_view_t section;
+        obj_view_section(view, i, &section);
+
+        for(unsigned int j = 0; j < section.exported_count; j++){
+            obj_symbol_t symbol;
+            obj_view_exported_symbol(view, &section, j, &symbol);
+            name_table_insert(defined, symbol.name, NULL);
+        }
+
+        for(unsigned int j = 0; j < section.imported_count; j++){
+            obj_symbol_t symbol;
+            obj_view_imported_symbol(view, &section, j, &symbol);
+
+            if(name_table_insert(seen, symbol.name, NULL)){
+                list_append(worklist, (void *)&(symbol.name));
+            }
+        }
     }
+}
 
-    for(unsigned i = 0; i < list_count(tmp->objects); i++){
-        obj_file_t *tmp_obj = NULL;
-        list_at(tmp->objects, i, (void *)&tmp_obj);
+bool cache_pull_library_members(cache_t *this, list_t *ld_symbols, char *entry_point_label){
+    CHECK_NULL_ARGUMENT(this);
+    CHECK_NULL_ARGUMENT(ld_symbols);
 
-        if(!process_obj_file_load(this, tmp_obj)){
-            sl_file_destroy(tmp);
-            return false;
+    bool retVal = true;
+    name_table_t *defined = NULL;
+    name_table_t *seen = NULL;
+    list_t *worklist = NULL;
+
+    if(list_count(this->files.libraries) == 0){
+        return true;
+    }
+
+    name_table_new(&defined, 32);
+    name_table_new(&seen, 32);
+    list_init(&worklist, sizeof(char *));
+
+    for(unsigned int i = 0; i < list_count(ld_symbols); i++){
+        sym_t *head = NULL;
+        list_at(ld_symbols, i, (void *)&head);
+        name_table_insert(defined, head->name, NULL);
+    }
+
+    for(unsigned int i = 0; i < list_count(this->files.obj_files); i++){
+        obj_view_t *view = NULL;
+        list_at(this->files.obj_files, i, (void *)&view);
+        collect_view_symbols(view, defined, seen, worklist);
+    }
+
+    if(entry_point_label != NULL && name_table_insert(seen, entry_point_label, NULL)){
+        list_append(worklist, (void *)&entry_point_label);
+    }
+
+    //worklist grows while members are pulled, it is processed in order so result is deterministic
+    for(unsigned int i = 0; i < list_count(worklist); i++){
+        char *name = NULL;
+        list_at(worklist, i, (void *)&name);
+
+        if(name_table_contains(defined, name)){
+            continue;
+        }
+
+        //first library (in command line order) exporting the symbol is used,
+        //unresolved symbols are reported while building symbol table
+        for(unsigned int j = 0; j < list_count(this->files.libraries); j++){
+            library_t *library = NULL;
+            unsigned member = 0;
+
+            list_at(this->files.libraries, j, (void *)&library);
+
+            if(!library_find_symbol(library, name, &member) || library->pulled[member] == true){
+                continue;
+            }
+
+            obj_view_t *view = NULL;
+
+            library->pulled[member] = true;
+
+            if(!library_member(library, member, &view)){
+                ERROR_WRITE("Failed to load object file %s from static library %s.", sl_view_member_name(library->view, member), library->view->filename);
+                ERROR_WRITE("Filelib error: %s", filelib_error());
+                retVal = false;
+                break;
+            }
+
+            if(!process_obj_view_load(this, view)){
+                retVal = false;
+                break;
+            }
+
+            collect_view_symbols(view, defined, seen, worklist);
+            break;
+        }
+
+        if(retVal == false){
+            break;
         }
     }
 
-    list_append(this->files.sl_files, (void *)&tmp);
+    list_destroy(worklist);
+    name_table_destroy(defined);
+    name_table_destroy(seen);
 
-    return true;
+    return retVal;
 }
 
 //-----------------------------------
 // Symbol cache
 
-static bool check_if_symbol_exist_by_name(char *symbol_name, list_t *list, cache_symbol_item_t **found_symbol){
-    for(unsigned int index = 0; index < list_count(list); index++){
-        cache_symbol_item_t *head = NULL;
-        list_at(list, index, (void *)&head);
+static cache_symbol_item_t *find_exported_symbol(cache_t *this, char *symbol_name){
+    CHECK_NULL_ARGUMENT(this);
+    CHECK_NULL_ARGUMENT(symbol_name);
 
-        if(strcmp(head->symbol->name, symbol_name) == 0){
-            if(found_symbol != NULL){
-                *found_symbol = head;
-            }
+    void *symbol = NULL;
 
-            return true;
-        }
+    if(!name_table_find(this->symbols.index, symbol_name, &symbol)){
+        return NULL;
     }
-    return false;
+
+    return (cache_symbol_item_t *)symbol;
 }
 
 static bool process_symbol(cache_t *this, cache_section_item_t *section_parent, obj_symbol_t *symbol, symbol_type_t type, string_t *eval_string){
@@ -394,7 +529,7 @@ static bool process_symbol(cache_t *this, cache_section_item_t *section_parent,
     holder->evaluated = false;
 
     if(type != SYMBOL_IMPORT){
-        if(check_if_symbol_exist_by_name(holder->symbol->name, this->symbols.exported, NULL) == true){
+        if(!name_table_insert(this->symbols.index, holder->symbol->name, (void *)holder)){
             ERROR_WRITE("Linkage error, multiple symbol definition of %s.", holder->symbol->name);
             cache_symbol_item_destroy(holder);
             return false;
@@ -450,6 +585,41 @@ static bool process_linker_eval_symbol(cache_t *this, obj_symbol_t *symbol, stri
     return process_symbol(this, NULL, symbol, SYMBOL_LINKER_SCRIPT_EVAL, eval_string);
 }
 
+static bool create_import_slots(cache_section_item_t *section){
+    CHECK_NULL_ARGUMENT(section);
+
+    //import symbols values are slot numbers referenced by special data words, assembler numbers
+    //imports of section from zero, so slots are bound by import count and not by values from file
+    unsigned int count = list_count(section->section->imported_symbol_list);
+
+    for(unsigned int i = 0; i < count; i++){
+        obj_symbol_t *head = NULL;
+        list_at(section->section->imported_symbol_list, i, (void *)&head);
+
+        if(head->value >= count){
+            char *value_string = platformlib_write_isa_address(head->value);
+
+            ERROR_WRITE("Linkage error, import %s of section %s has slot %s but section has only %u imports!", head->name, section->section->section_name, value_string, count);
+
+            dynmem_free(value_string);
+            return false;
+        }
+    }
+
+    if(section->import_slots != NULL){
+        dynmem_free(section->import_slots);
+        section->import_slots = NULL;
+    }
+
+    section->import_slot_count = count;
+
+    if(count > 0){
+        section->import_slots = (cache_symbol_item_t **)dynmem_calloc(count, sizeof(cache_symbol_item_t *));
+    }
+
+    return true;
+}
+
 bool cache_build_symbol_table(cache_t *this, list_t *ld_symbols, char *entry_point_label){
     CHECK_NULL_ARGUMENT(this);
     CHECK_NULL_ARGUMENT(ld_symbols);
@@ -475,6 +645,10 @@ bool cache_build_symbol_table(cache_t *this, list_t *ld_symbols, char *entry_poi
                 return false;
             }
         }
+
+        if(!create_import_slots(head_section)){
+            return false;
+        }
     }
 
     for(unsigned symbol_index = 0; symbol_index < list_count(ld_symbols); symbol_index++){
@@ -505,11 +679,15 @@ bool cache_build_symbol_table(cache_t *this, list_t *ld_symbols, char *entry_poi
         cache_symbol_item_t *found_symbol = NULL;
         list_at(this->symbols.imported, symbol_index, (void *)&head_symbol);
 
-        if(check_if_symbol_exist_by_name(head_symbol->symbol->name, this->symbols.exported, &found_symbol) == false){
+        found_symbol = find_exported_symbol(this, head_symbol->symbol->name);
+
+        if(found_symbol == NULL){
             ERROR_WRITE("Linkage error, undefined symbol %s!", head_symbol->symbol->name);
             return false;
         }
 
+        head_symbol->assigned_section->import_slots[head_symbol->symbol->value] = found_symbol;
+
         //mark as used (symbols from linker script doesn't have sections assigned)
         if((found_symbol->symbol_type != SYMBOL_LINKER_SCRIPT_ABS) &&
            (found_symbol->symbol_type != SYMBOL_LINKER_SCRIPT_EVAL)){
@@ -518,9 +696,9 @@ bool cache_build_symbol_table(cache_t *this, list_t *ld_symbols, char *entry_poi
     }
 
     //mark section containing entry point as used
-    cache_symbol_item_t *entry_point_synbol_export = NULL;
+    cache_symbol_item_t *entry_point_synbol_export = find_exported_symbol(this, entry_point_label);
 
-    if(check_if_symbol_exist_by_name(entry_point_label, this->symbols.exported, &entry_point_synbol_export) == false){
+    if(entry_point_synbol_export == NULL){
         ERROR_WRITE("Linkage error, missing entry point '%s' symbol!", entry_point_label);
         return false;
     }
@@ -539,6 +717,8 @@ void cache_strip_down_unused_sections(cache_t *this){
         list_at(this->all.sections, section_index, (void *)&head_section);
 
         if(head_section->used == false){
+            //symbols may still refer to the section, so it is destroyed together with cache
+            list_append(this->all.stripped, (void *)&head_section);
             list_remove_at(this->all.sections, section_index);
             section_index = (section_index == 0) ? section_index : section_index - 1;
             continue;
@@ -640,9 +820,9 @@ static bool variable_resolve_callback(char *name, long long *result){
         return true;
     }
 
-    cache_symbol_item_t *found_symbol = NULL;
+    cache_symbol_item_t *found_symbol = find_exported_symbol(context.cache, name);
 
-    if(!check_if_symbol_exist_by_name(name, context.cache->symbols.exported, &found_symbol)){
+    if(found_symbol == NULL){
         return false;
     }
 
@@ -884,25 +1064,22 @@ bool cache_relocate_data(cache_t *this){
         offset += section_holder->offset;
         offset += section_holder->assigned_memory->begin_addr;
 
-        for(unsigned int data_index = 0; data_index < list_count(section_holder->section->data_symbol_list); data_index++){
-            obj_data_t *data_holder = NULL;
-            isa_instruction_word_t output = 0;
+        cache_section_data_t *data = &(section_holder->data);
 
-            list_at(section_holder->section->data_symbol_list, data_index, (void *)&data_holder);
-
-            data_holder->address += offset;
+        for(unsigned int data_index = 0; data_index < data->count; data_index++){
+            data->address[data_index] += offset;
+        }
 
-            if(data_holder->blob == true || data_holder->relocation == false){
+        for(unsigned int data_index = 0; data_index < data->count; data_index++){
+            if((data->flags[data_index] & (CACHE_DATA_BLOB | CACHE_DATA_RELOCATION)) != CACHE_DATA_RELOCATION){
                 continue;
             }
 
-            if(!platformlib_relocate_instruction(data_holder->payload.data_value, &output, offset)){
+            if(!platformlib_relocate_instruction(data->payload[data_index], &(data->payload[data_index]), offset)){
                 ERROR_WRITE("Can't relocate instruction in section %s!", section_holder->section->section_name);
                 ERROR_WRITE("%s", platformlib_error());
                 return false;
             }
-
-            data_holder->payload.data_value = output;
         }
     }
     return true;
@@ -918,46 +1095,31 @@ bool cache_link_specials(cache_t *this){
         cache_section_item_t *section_holder = NULL;
         list_at(this->all.sections, section_index, (void *)&section_holder);
 
-        for(unsigned int data_index = 0; data_index < list_count(section_holder->section->data_symbol_list); data_index++){
-            obj_data_t *data_holder = NULL;
-            obj_symbol_t *import_symbol = NULL;
-            cache_symbol_item_t *exported_counterpart = NULL;
-            isa_instruction_word_t output = 0;
+        cache_section_data_t *data = &(section_holder->data);
 
-            list_at(section_holder->section->data_symbol_list, data_index, (void *)&data_holder);
+        for(unsigned int data_index = 0; data_index < data->count; data_index++){
+            cache_symbol_item_t *exported_counterpart = NULL;
 
-            if(data_holder->blob == true || data_holder->special == false){
+            if((data->flags[data_index] & (CACHE_DATA_BLOB | CACHE_DATA_SPECIAL)) != CACHE_DATA_SPECIAL){
                 continue;
             }
 
-            //find name of that symbol
-            for(unsigned int symbol_index = 0; symbol_index < list_count(section_holder->section->imported_symbol_list); symbol_index++){
-                obj_symbol_t *head_symbol = NULL;
-                list_at(section_holder->section->imported_symbol_list, symbol_index, (void *)&head_symbol);
-
-                if(head_symbol->value == data_holder->special_value){
-                    import_symbol = head_symbol;
-                    break;
-                }
-            }
-
-            //this is true error in linker/assembler and not in user input
-            if(import_symbol == NULL){
+            //this is true error in linker/assembler and not in user input, all imports were resolved in symbol table build
+            if(data->special_value[data_index] >= section_holder->import_slot_count){
                 error("Data symbol have special value that is not found in imported symbols!");
             }
 
-            //again this is true error as we already checked if all symbols exist -> error in linker not in user input
-            if(!check_if_symbol_exist_by_name(import_symbol->name, this->symbols.exported, &exported_counterpart)){
+            exported_counterpart = section_holder->import_slots[data->special_value[data_index]];
+
+            if(exported_counterpart == NULL){
                 error("Counterpart symbol for special symbol doesn't found!");
             }
 
-            if(!platformlib_retarget_instruction(data_holder->payload.data_value, &output, exported_counterpart->symbol->value)){
-                ERROR_WRITE("Linkage error! Failed to retarget instruction referencing symbol %s in section %s!", import_symbol->name, section_holder->section->section_name);
+            if(!platformlib_retarget_instruction(data->payload[data_index], &(data->payload[data_index]), exported_counterpart->symbol->value)){
+                ERROR_WRITE("Linkage error! Failed to retarget instruction referencing symbol %s in section %s!", exported_counterpart->symbol->name, section_holder->section->section_name);
                 ERROR_WRITE("%s", platformlib_error());
                 return false;
             }
-
-            data_holder->payload.data_value = output;
         }
     }
 
@@ -967,38 +1129,45 @@ bool cache_link_specials(cache_t *this){
 //-----------------------------------------
 // Write into LDM
 
-void cache_write_data_into_associated_ldm(cache_t *this){
+static void overlap_error(cache_section_item_t *section_holder, isa_address_t address){
+    char *address_string = platformlib_write_isa_address(address);
+
+    ERROR_WRITE("Linkage error! Data of section %s overlaps data already placed at address %s of memory %s!", section_holder->section->section_name, address_string, section_holder->assigned_memory->memory_name);
+
+    dynmem_free(address_string);
+}
+
+bool cache_write_data_into_associated_ldm(cache_t *this){
     CHECK_NULL_ARGUMENT(this);
 
     for(unsigned section_index = 0; section_index < list_count(this->all.sections); section_index++){
         cache_section_item_t *section_holder = NULL;
         list_at(this->all.sections, section_index, (void *)&section_holder);
 
-        for(unsigned int data_index = 0; data_index < list_count(section_holder->section->data_symbol_list); data_index++){
-            obj_data_t *data_holder = NULL;
+        cache_section_data_t *data = &(section_holder->data);
 
-            list_at(section_holder->section->data_symbol_list, data_index, (void *)&data_holder);
-
-            if(data_holder->blob == true){
-                ldm_item_t *new_item = NULL;
-                ldm_item_new(data_holder->address, data_holder->payload.blob_value, &new_item);
-                ldm_item_into_mem(section_holder->assigned_memory, new_item);
+        for(unsigned int data_index = 0; data_index < data->count; data_index++){
+            if((data->flags[data_index] & CACHE_DATA_BLOB) != 0){
+                if(!ldm_mem_set(section_holder->assigned_memory, data->address[data_index], (isa_memory_element_t)data->payload[data_index])){
+                    overlap_error(section_holder, data->address[data_index]);
+                    return false;
+                }
             }
             else{
-                array_t *memory_elements = NULL;
-                platformlib_convert_isa_word_to_element(data_holder->payload.data_value, &memory_elements);
-
-                for(unsigned int i = 0; i < array_get_size(memory_elements); i++){
-                    isa_memory_element_t *memory_element = array_at(memory_elements, i);
-                    ldm_item_t *new_item = NULL;
-                    ldm_item_new(data_holder->address + i, *memory_element, &new_item);
-                    ldm_item_into_mem(section_holder->assigned_memory, new_item);
+                isa_memory_element_t elements[PLATFORMLIB_MAX_WORD_ELEMENTS];
+                unsigned count = platformlib_split_isa_word(data->payload[data_index], elements, PLATFORMLIB_MAX_WORD_ELEMENTS);
+
+                for(unsigned int i = 0; i < count; i++){
+                    if(!ldm_mem_set(section_holder->assigned_memory, data->address[data_index] + i, elements[i])){
+                        overlap_error(section_holder, data->address[data_index] + i);
+                        return false;
+                    }
                 }
-
-                array_destroy(memory_elements);
             }
         }
     }
+
+    return true;
 }
 
 //-----------------------------------------
@@ -1010,7 +1179,7 @@ void print_cache(cache_t *this){
     printf("Symbol cache (%p):\r\n", this);
 
     printf("|- obj files: %d\r\n", list_count(this->files.obj_files));
-    printf("|- sl files: %d\r\n", list_count(this->files.sl_files));
+    printf("|- sl files: %d\r\n", list_count(this->files.libraries));
 
     printf("|- sections: %d\r\n", list_count(this->all.sections));
 
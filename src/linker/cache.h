@@ -2,19 +2,43 @@
 #define SECTION_CACHE_H_included
 
 #include "ldparser.h"
+#include "library.h"
+#include "name_table.h"
 
 #include <utillib/core.h>
 #include <filelib.h>
 #include <platformlib.h>
 
 #include <stdbool.h>
+#include <stdint.h>
+
+typedef struct cache_symbol_item_s cache_symbol_item_t;
+
+#define CACHE_DATA_BLOB 0x01
+#define CACHE_DATA_RELOCATION 0x02
+#define CACHE_DATA_SPECIAL 0x04
+
+// Data of section are kept in parallel arrays instead of obj_data_t list, so
+// relocation, linking and writing into ldm stream over continuous memory. Blob
+// value is stored in payload too.
+typedef struct{
+    isa_address_t *address;
+    isa_instruction_word_t *payload;
+    isa_address_t *special_value;
+    uint8_t *flags;
+    unsigned int count;
+    unsigned int capacity;
+} cache_section_data_t;
 
 typedef struct{
     obj_section_t *section;
+    cache_section_data_t data;
     ldm_memory_t *assigned_memory;
     bool used;
     isa_address_t size;
     isa_address_t offset;
+    cache_symbol_item_t **import_slots;
+    unsigned int import_slot_count;
 } cache_section_item_t;
 
 typedef enum{
@@ -24,13 +48,13 @@ typedef enum{
     SYMBOL_LINKER_SCRIPT_EVAL
 } symbol_type_t;
 
-typedef struct{
+struct cache_symbol_item_s{
     symbol_type_t symbol_type;
     obj_symbol_t *symbol;
     cache_section_item_t *assigned_section;
     string_t *eval_string;
     bool evaluated;
-} cache_symbol_item_t;
+};
 
 typedef struct{
     ldm_memory_t *ldm_mem;
@@ -41,14 +65,16 @@ typedef struct{
     struct{
         list_t *sections;
         list_t *symbols;
+        list_t *stripped;
     }all;
     struct{
         list_t *obj_files;
-        list_t *sl_files;
+        list_t *libraries;
     }files;
     struct{
         list_t *exported;
         list_t *imported;
+        name_table_t *index;
     }symbols;
     list_t * offsets;
 } cache_t;
@@ -56,8 +82,13 @@ typedef struct{
 void cache_new(cache_t **cache);
 void cache_destroy(cache_t *this);
 
-bool cache_load_object_file(cache_t *this, char *filename);
-bool cache_load_library_file(cache_t *this, char *filename);
+// files are opened by loader, cache takes ownership of them
+bool cache_merge_object_view(cache_t *this, obj_view_t *view);
+void cache_add_library(cache_t *this, library_t *library);
+
+// Merge library members exporting symbols that are still unresolved (imports
+// and entry point), including members needed by already pulled ones.
+bool cache_pull_library_members(cache_t *this, list_t *ld_symbols, char *entry_point_label);
 
 bool cache_build_symbol_table(cache_t *this, list_t *ld_symbols, char *entry_point_label);
 
@@ -73,7 +104,8 @@ bool cache_relocate_data(cache_t *this);
 
 bool cache_link_specials(cache_t *this);
 
-void cache_write_data_into_associated_ldm(cache_t *this);
+// fails when data of two sections are placed at the same address
+bool cache_write_data_into_associated_ldm(cache_t *this);
 
 void print_cache(cache_t *this);
 
@@ -20,6 +20,8 @@
     } \
 }
 
+#define LINKER_MAX_JOBS 256
+
 typedef enum{
     ACTION_NOT_SPECIFIED = 0,
     ACTION_HELP,
@@ -33,6 +35,8 @@ typedef struct{
     bool verbose;
     char *output_filename;
     bool strip_unused;
+    bool binary;
+    unsigned jobs;
     struct {
         list_t *input_obj_files;
         list_t *input_sl_files;
@@ -0,0 +1,142 @@
+#include "library.h"
+
+#include <utillib/core.h>
+#include <filelib.h>
+
+#include <stdbool.h>
+#include <stdint.h>
+
+static unsigned count_exported_symbols(obj_view_t *member){
+    unsigned count = 0;
+
+    for(unsigned i = 0; i < member->section_count; i++){
+        obj_section_view_t section;
+        obj_view_section(member, i, &section);
+        count += section.exported_count;
+    }
+
+    return count;
+}
+
+static void index_symbol(library_t *library, char *name, unsigned member){
+    //first definition wins, later ones are pulled only together with their member
+    name_table_insert(library->symbols, name, (void *)(uintptr_t)member);
+}
+
+static void index_member(library_t *library, unsigned index){
+    obj_view_t *member = library->members[index];
+
+    for(unsigned i = 0; i < member->section_count; i++){
+        obj_section_view_t section;
+        obj_view_section(member, i, &section);
+
+        for(unsigned j = 0; j < section.exported_count; j++){
+            obj_symbol_t symbol;
+            obj_view_exported_symbol(member, &section, j, &symbol);
+            index_symbol(library, symbol.name, index);
+        }
+    }
+}
+
+void library_new(library_t **library, sl_view_t *view, obj_view_t **members){
+    CHECK_NULL_ARGUMENT(library);
+    CHECK_NOT_NULL_ARGUMENT(*library);
+    CHECK_NULL_ARGUMENT(view);
+
+    unsigned symbols = 0;
+
+    if(members == NULL && view->indexed == false){
+        error("Library %s without symbol index have to be opened with all members!", view->filename);
+    }
+
+    *library = (library_t *)dynmem_calloc(1, sizeof(library_t));
+
+    (*library)->view = view;
+    (*library)->members = members;
+
+    if(view->member_count > 0){
+        (*library)->pulled = (bool *)dynmem_calloc(view->member_count, sizeof(bool));
+
+        if(members == NULL){
+            (*library)->members = (obj_view_t **)dynmem_calloc(view->member_count, sizeof(obj_view_t *));
+        }
+    }
+
+    if(view->indexed == true){
+        symbols = view->symbol_count;
+    }
+    else{
+        for(unsigned i = 0; i < view->member_count; i++){
+            symbols += count_exported_symbols(members[i]);
+        }
+    }
+
+    name_table_new(&((*library)->symbols), symbols);
+
+    if(view->indexed == true){
+        //stored index keeps symbols in member order, so first definition wins as well
+        for(unsigned i = 0; i < view->symbol_count; i++){
+            sl_index_symbol_t symbol;
+            sl_view_symbol(view, i, &symbol);
+            index_symbol(*library, symbol.name, symbol.member);
+        }
+    }
+    else{
+        for(unsigned i = 0; i < view->member_count; i++){
+            index_member(*library, i);
+        }
+    }
+}
+
+void library_destroy(library_t *library){
+    if(library == NULL)
+        return;
+
+    if(library->members != NULL){
+        for(unsigned i = 0; i < library->view->member_count; i++){
+            if(library->members[i] != NULL){
+                obj_view_close(library->members[i]);
+            }
+        }
+        dynmem_free(library->members);
+    }
+
+    if(library->pulled != NULL){
+        dynmem_free(library->pulled);
+    }
+
+    name_table_destroy(library->symbols);
+    sl_view_close(library->view);
+    dynmem_free(library);
+}
+
+bool library_find_symbol(library_t *library, char *name, unsigned *member){
+    CHECK_NULL_ARGUMENT(library);
+    CHECK_NULL_ARGUMENT(name);
+    CHECK_NULL_ARGUMENT(member);
+
+    void *value = NULL;
+
+    if(!name_table_find(library->symbols, name, &value)){
+        return false;
+    }
+
+    *member = (unsigned)(uintptr_t)value;
+
+    return true;
+}
+
+bool library_member(library_t *library, unsigned member, obj_view_t **view){
+    CHECK_NULL_ARGUMENT(library);
+    CHECK_NULL_ARGUMENT(view);
+
+    if(library->members[member] == NULL){
+        if(!sl_view_member(library->view, member, &(library->members[member]))){
+            return false;
+        }
+    }
+
+    *view = library->members[member];
+
+    return true;
+}
@@ -0,0 +1,33 @@
+#ifndef LIBRARY_H_included
+#define LIBRARY_H_included
+
+#include "name_table.h"
+
+#include <filelib.h>
+
+#include <stdbool.h>
+
+// Static library with index of exported symbols of its members. Index is taken
+// from the library itself when it was written with one, then members are opened
+// only when they are needed, otherwise all members are opened to build it.
+// Members are merged into cache only when they export some unresolved symbol.
+// Symbols map names (owned by member views or library view) to member numbers.
+typedef struct{
+    sl_view_t *view;
+    obj_view_t **members;
+    bool *pulled;
+    name_table_t *symbols;
+} library_t;
+
+// takes ownership of view and of its opened members, members may be NULL only
+// for library with stored index
+void library_new(library_t **library, sl_view_t *view, obj_view_t **members);
+void library_destroy(library_t *library);
+
+// first member (in library order) exporting given symbol
+bool library_find_symbol(library_t *library, char *name, unsigned *member);
+
+// open member when it isn't open yet, error is left in filelib error buffer
+bool library_member(library_t *library, unsigned member, obj_view_t **view);
+
+#endif
@@ -3,6 +3,7 @@
 #include "common.h"
 #include "ldparser.h"
 #include "cache.h"
+#include "loader.h"
 
 #include <utillib/core.h>
 #include <filelib.h>
@@ -77,7 +78,7 @@ bool linker_link(void){
 
         list_at(lds->memories, i, (void *)&head_mem);
 
-        ldm_mem_new(head_mem->name, &tmp_mem, head_mem->size, head_mem->orig);
+        ldm_mem_new_image(head_mem->name, &tmp_mem, head_mem->size, head_mem->orig);
         ldm_mem_into_file(ldm, tmp_mem);
     }
 
@@ -85,27 +86,19 @@ bool linker_link(void){
 
     cache_new(&cache);
 
-    for(unsigned int i = 0; i < list_count(settings.input.input_obj_files); i++){
-        char *filename = NULL;
-        list_at(settings.input.input_obj_files, i, (void *)&filename);
-
-        if(!cache_load_object_file(cache, filename)){
-            LOG_MSG("Loading input obj files - FAIL");
-            return false;
-        }
+    if(!loader_load_files(cache, settings.input.input_obj_files, settings.input.input_sl_files, settings.jobs)){
+        LOG_MSG("Loading input files - FAIL");
+        return false;
     }
 
-    for(unsigned int i = 0; i < list_count(settings.input.input_sl_files); i++){
-        char *filename = NULL;
-        list_at(settings.input.input_sl_files, i, (void *)&filename);
+    LOG_MSG("Loading input files - OK");
 
-        if(!cache_load_library_file(cache, filename)){
-            LOG_MSG("Loading input sl files - FAIL");
-            return false;
-        }
+    if(!cache_pull_library_members(cache, lds->symbols, lds->entry_point)){
+        LOG_MSG("Pulling library members - FAIL");
+        return false;
     }
 
-    LOG_MSG("Loading input files - OK");
+    LOG_MSG("Pulling library members - OK");
     if(settings.verbose == true) print_cache(cache);
 
     if(!cache_build_symbol_table(cache, lds->symbols, lds->entry_point)){
@@ -159,12 +152,19 @@ bool linker_link(void){
     LOG_MSG("Linking - OK");
     if(settings.verbose == true) print_cache(cache);
 
-    cache_write_data_into_associated_ldm(cache);
+    if(!cache_write_data_into_associated_ldm(cache)){
+        LOG_MSG("Writing data into LDM - FAIL");
+        return false;
+    }
+
+    LOG_MSG("Writing data into LDM - OK");
 
     cache_destroy(cache);
     cache = NULL;
 
-    if(!ldm_write(ldm, settings.output_filename)){
+    bool written = settings.binary ? ldm_write_binary(ldm, settings.output_filename) : ldm_write(ldm, settings.output_filename);
+
+    if(!written){
         LOG_MSG("Writing LDM - FAIL");
         return false;
     }
@@ -88,6 +88,8 @@ bool argparse(int argc, char **argv){
     settings.output_filename = NULL;
     settings.input.linker_script = NULL;
     settings.strip_unused = false;
+    settings.binary = false;
+    settings.jobs = 1;
     settings.input.input_obj_files = NULL;
     settings.input.input_sl_files = NULL;
 
@@ -102,6 +104,8 @@ bool argparse(int argc, char **argv){
     options_append_string_option_3(args, "T", "linker-script", "Path to the linker script.");
     options_append_flag_2(args, "strip-unused", "Put unused sections away. Strip down output size.");
     options_append_string_option_3(args, "l", "library", "Link specified static library.");
+    options_append_flag_2(args, "binary", "Write ldm file in binary format.");
+    options_append_number_option_3(args, "j", "jobs", "Number of threads used for loading input files.");
 
 #ifndef NDEBUG
     options_append_section(args, "Debug", NULL);
@@ -136,6 +140,29 @@ bool argparse(int argc, char **argv){
             settings.strip_unused = true;
         }
 
+        if(options_is_flag_set(args, "binary")){
+            settings.binary = true;
+        }
+
+        if(options_is_option_set(args, "j") || options_is_option_set(args, "jobs")){
+            long long jobs = 0;
+
+            if(options_is_option_set(args, "j")){
+                options_get_option_value_number(args, "j", &jobs);
+            }
+            else{
+                options_get_option_value_number(args, "jobs", &jobs);
+            }
+
+            if(jobs < 1 || jobs > LINKER_MAX_JOBS){
+                ERROR_WRITE("Number of jobs has to be between 1 and %d!", LINKER_MAX_JOBS);
+                retVal = false;
+            }
+            else{
+                settings.jobs = (unsigned)jobs;
+            }
+        }
+
         if(options_is_option_set(args, "T")){
             options_get_option_value_string(args, "T", &(settings.input.linker_script));
         }
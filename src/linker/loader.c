@@ -0,0 +1,310 @@
+#include "loader.h"
+
+#include "common.h"
+#include "cache.h"
+#include "library.h"
+
+#include <utillib/core.h>
+#include <filelib.h>
+
+#include <stdbool.h>
+#include <stdlib.h>
+
+#ifdef LINKER_USE_PTHREADS
+#include <pthread.h>
+#endif
+
+typedef struct{
+    char *filename;
+    bool is_library;
+    bool done;
+    bool loaded;
+    obj_view_t *obj;
+    sl_view_t *sl;
+    obj_view_t **members;
+    unsigned member_count;
+    library_t *library;
+    filelib_ctx_t *files;
+} loader_job_t;
+
+typedef struct{
+    loader_job_t *jobs;
+    unsigned count;
+    unsigned next;
+#ifdef LINKER_USE_PTHREADS
+    pthread_mutex_t lock;
+    pthread_cond_t done;
+#endif
+} loader_queue_t;
+
+static void loader_job_init(loader_job_t *job, char *filename, bool is_library){
+    job->filename = filename;
+    job->is_library = is_library;
+    job->done = false;
+    job->loaded = false;
+    job->obj = NULL;
+    job->sl = NULL;
+    job->members = NULL;
+    job->member_count = 0;
+    job->library = NULL;
+    job->files = NULL;
+
+    filelib_ctx_new(&(job->files));
+}
+
+static void loader_job_release(loader_job_t *job){
+    if(job->obj != NULL){
+        obj_view_close(job->obj);
+    }
+
+    if(job->library != NULL){
+        library_destroy(job->library);
+    }
+
+    if(job->members != NULL){
+        for(unsigned i = 0; i < job->member_count; i++){
+            obj_view_close(job->members[i]);
+        }
+        dynmem_free(job->members);
+    }
+
+    if(job->sl != NULL){
+        sl_view_close(job->sl);
+    }
+
+    filelib_ctx_destroy(job->files);
+}
+
+// may run in worker thread, so files are opened through context of the job
+static void open_job(loader_job_t *job){
+    if(job->is_library == false){
+        job->loaded = obj_view_open_ctx(job->files, job->filename, &(job->obj));
+    }
+    else if(sl_view_open_ctx(job->files, job->filename, &(job->sl))){
+        job->loaded = true;
+
+        //members of library with stored symbol index are opened when they are pulled
+        if(job->sl->indexed == false && job->sl->member_count > 0){
+            job->members = (obj_view_t **)dynmem_calloc(job->sl->member_count, sizeof(obj_view_t *));
+
+            //member_count holds number of opened members, so it points to failed one
+            while(job->member_count < job->sl->member_count){
+                if(!sl_view_member_ctx(job->files, job->sl, job->member_count, &(job->members[job->member_count]))){
+                    job->loaded = false;
+                    break;
+                }
+
+                job->member_count++;
+            }
+        }
+
+        //symbol index is built here too, so it is done in parallel as well
+        if(job->loaded == true){
+            library_new(&(job->library), job->sl, job->members);
+            job->sl = NULL;
+            job->members = NULL;
+        }
+    }
+}
+
+//platformlib errors of job are kept apart by its context, so they are appended here
+static void write_job_errors(loader_job_t *job){
+    ERROR_WRITE("Filelib error: %s", filelib_ctx_error(job->files));
+
+    char *platform_error = filelib_ctx_platform_error(job->files);
+
+    if(platform_error != NULL && platform_error[0] != '\0'){
+        ERROR_WRITE("Platformlib error: %s", platform_error);
+    }
+}
+
+static bool merge_job(cache_t *cache, loader_job_t *job){
+    if(job->is_library == false){
+        if(job->loaded == false){
+            ERROR_WRITE("Failed to load object file %s.", job->filename);
+            write_job_errors(job);
+            return false;
+        }
+
+        if(!cache_merge_object_view(cache, job->obj)){
+            return false;
+        }
+
+        //view is owned by cache now
+        job->obj = NULL;
+
+        return true;
+    }
+
+    if(job->loaded == true){
+        //members are merged later, when they are needed
+        cache_add_library(cache, job->library);
+        job->library = NULL;
+
+        return true;
+    }
+
+    if(job->sl == NULL){
+        ERROR_WRITE("Failed to load static library %s.", job->filename);
+    }
+    else{
+        ERROR_WRITE("Failed to load object file %s from static library %s.", sl_view_member_name(job->sl, job->member_count), job->filename);
+    }
+
+    write_job_errors(job);
+
+    return false;
+}
+
+static bool load_serial(cache_t *cache, loader_queue_t *queue){
+    for(; queue->next < queue->count; queue->next++){
+        loader_job_t *job = &(queue->jobs[queue->next]);
+
+        open_job(job);
+        job->done = true;
+
+        if(!merge_job(cache, job)){
+            return false;
+        }
+    }
+
+    return true;
+}
+
+#ifdef LINKER_USE_PTHREADS
+static void *loader_worker(void *arg){
+    loader_queue_t *queue = (loader_queue_t *)arg;
+
+    for(;;){
+        loader_job_t *job = NULL;
+
+        pthread_mutex_lock(&(queue->lock));
+
+        if(queue->next < queue->count){
+            job = &(queue->jobs[queue->next++]);
+        }
+
+        pthread_mutex_unlock(&(queue->lock));
+
+        if(job == NULL){
+            break;
+        }
+
+        open_job(job);
+
+        pthread_mutex_lock(&(queue->lock));
+        job->done = true;
+        pthread_cond_broadcast(&(queue->done));
+        pthread_mutex_unlock(&(queue->lock));
+    }
+
+    return NULL;
+}
+
+// workers open files, main thread merges them in order as soon as they are ready
+static bool load_parallel(cache_t *cache, loader_queue_t *queue, unsigned jobs){
+    bool retVal = true;
+    unsigned started = 0;
+    pthread_t *threads = (pthread_t *)dynmem_malloc(jobs * sizeof(pthread_t));
+
+    pthread_mutex_init(&(queue->lock), NULL);
+    pthread_cond_init(&(queue->done), NULL);
+
+    for(unsigned i = 0; i < jobs; i++){
+        if(pthread_create(&(threads[started]), NULL, loader_worker, (void *)queue) == 0){
+            started++;
+        }
+    }
+
+    if(started == 0){
+        retVal = load_serial(cache, queue);
+    }
+    else{
+        for(unsigned i = 0; i < queue->count; i++){
+            loader_job_t *job = &(queue->jobs[i]);
+
+            pthread_mutex_lock(&(queue->lock));
+            while(job->done == false){
+                pthread_cond_wait(&(queue->done), &(queue->lock));
+            }
+            pthread_mutex_unlock(&(queue->lock));
+
+            if(!merge_job(cache, job)){
+                //don't let workers start anything else
+                pthread_mutex_lock(&(queue->lock));
+                queue->count = queue->next;
+                pthread_mutex_unlock(&(queue->lock));
+
+                retVal = false;
+                break;
+            }
+        }
+    }
+
+    for(unsigned i = 0; i < started; i++){
+        pthread_join(threads[i], NULL);
+    }
+
+    pthread_cond_destroy(&(queue->done));
+    pthread_mutex_destroy(&(queue->lock));
+    dynmem_free(threads);
+
+    return retVal;
+}
+#endif
+
+bool loader_load_files(cache_t *cache, list_t *obj_files, list_t *sl_files, unsigned jobs){
+    CHECK_NULL_ARGUMENT(cache);
+    CHECK_NULL_ARGUMENT(obj_files);
+    CHECK_NULL_ARGUMENT(sl_files);
+
+    bool retVal = true;
+    loader_queue_t queue;
+
+    queue.count = list_count(obj_files) + list_count(sl_files);
+    queue.next = 0;
+
+    if(queue.count == 0){
+        return true;
+    }
+
+    queue.jobs = (loader_job_t *)dynmem_malloc(queue.count * sizeof(loader_job_t));
+
+    for(unsigned i = 0; i < list_count(obj_files); i++){
+        char *filename = NULL;
+        list_at(obj_files, i, (void *)&filename);
+        loader_job_init(&(queue.jobs[i]), filename, false);
+    }
+
+    for(unsigned i = 0; i < list_count(sl_files); i++){
+        char *filename = NULL;
+        list_at(sl_files, i, (void *)&filename);
+        loader_job_init(&(queue.jobs[list_count(obj_files) + i]), filename, true);
+    }
+
+    unsigned total = queue.count;
+
+    if(jobs > queue.count){
+        jobs = queue.count;
+    }
+
+#ifdef LINKER_USE_PTHREADS
+    if(jobs > 1){
+        retVal = load_parallel(cache, &queue, jobs);
+    }
+    else{
+        retVal = load_serial(cache, &queue);
+    }
+#else
+    retVal = load_serial(cache, &queue);
+#endif
+
+    //jobs behind queue.next were never started, they hold nothing but buffers
+    for(unsigned i = 0; i < total; i++){
+        loader_job_release(&(queue.jobs[i]));
+    }
+
+    dynmem_free(queue.jobs);
+
+    return retVal;
+}
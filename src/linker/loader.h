@@ -0,0 +1,16 @@
+#ifndef LOADER_H_included
+#define LOADER_H_included
+
+#include "cache.h"
+
+#include <utillib/core.h>
+
+#include <stdbool.h>
+
+// Open all input files and merge objects into cache, libraries are only indexed
+// and handed to cache. Files are opened by pool of `jobs` threads, but they are
+// passed to cache in the order they are given (objects first, then libraries),
+// so output doesn't depend on number of jobs.
+bool loader_load_files(cache_t *cache, list_t *obj_files, list_t *sl_files, unsigned jobs);
+
+#endif
@@ -0,0 +1,109 @@
+#include "name_table.h"
+
+#include <utillib/core.h>
+#include <filelib.h>
+
+#include <stdbool.h>
+#include <string.h>
+
+#define NAME_TABLE_MIN_CAPACITY 16
+
+static unsigned int find_slot(name_table_t *table, char *name){
+    unsigned int mask = table->capacity - 1;
+    unsigned int slot = (unsigned int)filelib_hash(FILELIB_HASH_INIT, name, strlen(name)) & mask;
+
+    while(table->slots[slot].name != NULL){
+        if(strcmp(table->slots[slot].name, name) == 0){
+            break;
+        }
+        slot = (slot + 1) & mask;
+    }
+
+    return slot;
+}
+
+static void grow(name_table_t *table){
+    name_table_slot_t *old_slots = table->slots;
+    unsigned int old_capacity = table->capacity;
+
+    table->capacity *= 2;
+    table->slots = (name_table_slot_t *)dynmem_calloc(table->capacity, sizeof(name_table_slot_t));
+
+    for(unsigned int i = 0; i < old_capacity; i++){
+        if(old_slots[i].name != NULL){
+            table->slots[find_slot(table, old_slots[i].name)] = old_slots[i];
+        }
+    }
+
+    dynmem_free(old_slots);
+}
+
+void name_table_new(name_table_t **table, unsigned int count){
+    CHECK_NULL_ARGUMENT(table);
+    CHECK_NOT_NULL_ARGUMENT(*table);
+
+    name_table_t *tmp = (name_table_t *)dynmem_malloc(sizeof(name_table_t));
+
+    tmp->capacity = NAME_TABLE_MIN_CAPACITY;
+    tmp->count = 0;
+
+    while(tmp->capacity < count * 2){
+        tmp->capacity *= 2;
+    }
+
+    tmp->slots = (name_table_slot_t *)dynmem_calloc(tmp->capacity, sizeof(name_table_slot_t));
+
+    *table = tmp;
+}
+
+void name_table_destroy(name_table_t *table){
+    if(table == NULL)
+        return;
+
+    dynmem_free(table->slots);
+    dynmem_free(table);
+}
+
+bool name_table_insert(name_table_t *table, char *name, void *value){
+    CHECK_NULL_ARGUMENT(table);
+    CHECK_NULL_ARGUMENT(name);
+
+    if((table->count + 1) * 2 > table->capacity){
+        grow(table);
+    }
+
+    unsigned int slot = find_slot(table, name);
+
+    if(table->slots[slot].name != NULL){
+        return false;
+    }
+
+    table->slots[slot].name = name;
+    table->slots[slot].value = value;
+    table->count++;
+
+    return true;
+}
+
+bool name_table_find(name_table_t *table, char *name, void **value){
+    CHECK_NULL_ARGUMENT(table);
+    CHECK_NULL_ARGUMENT(name);
+    CHECK_NULL_ARGUMENT(value);
+
+    name_table_slot_t *slot = &(table->slots[find_slot(table, name)]);
+
+    if(slot->name == NULL){
+        return false;
+    }
+
+    *value = slot->value;
+
+    return true;
+}
+
+bool name_table_contains(name_table_t *table, char *name){
+    CHECK_NULL_ARGUMENT(table);
+    CHECK_NULL_ARGUMENT(name);
+
+    return table->slots[find_slot(table, name)].name != NULL;
+}
@@ -0,0 +1,29 @@
+#ifndef NAME_TABLE_H_included
+#define NAME_TABLE_H_included
+
+#include <stdbool.h>
+
+typedef struct{
+    char *name;
+    void *value;
+} name_table_slot_t;
+
+// Values keyed by symbol names, names aren't copied so they have to live as
+// long as the table. Open addressing with linear probing, capacity is power of
+// two and load factor is kept under 0.5, so empty slot is always found.
+typedef struct{
+    name_table_slot_t *slots;
+    unsigned int capacity;
+    unsigned int count;
+} name_table_t;
+
+// table is sized for given number of names, it grows when more are inserted
+void name_table_new(name_table_t **table, unsigned int count);
+void name_table_destroy(name_table_t *table);
+
+// return false when name is already in the table, its value is kept then
+bool name_table_insert(name_table_t *table, char *name, void *value);
+bool name_table_find(name_table_t *table, char *name, void **value);
+bool name_table_contains(name_table_t *table, char *name);
+
+#endif
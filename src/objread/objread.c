@@ -141,51 +141,51 @@ static void clean_mem(void){
 }
 
 static void print_obj(void){
-    obj_file_t *obj = NULL;
+    obj_view_t *obj = NULL;
 
-    if(!obj_load(settings.i_file, &obj)){
+    if(!obj_view_open(settings.i_file, &obj)){
         failure(filelib_error());
     }
 
     printf("Object file %s\r\n", settings.i_file);
     printf(" |- arch: %s\r\n", obj->target_arch_name);
 
-    for(unsigned i = 0; i < list_count(obj->section_list); i++){
-        obj_section_t *section = NULL;
-        list_at(obj->section_list, i, (void *)&section);
+    for(unsigned i = 0; i < obj->section_count; i++){
+        obj_section_view_t section;
+        obj_view_section(obj, i, &section);
 
-        bool last_section = ((i + 1) == list_count(obj->section_list))  ? true : false;
+        bool last_section = ((i + 1) == obj->section_count)  ? true : false;
         char next_section = (last_section == true)  ? ' ' : '|';
 
         if(last_section == true){
-            printf(" '- Section %s\r\n", section->section_name);
+            printf(" '- Section %s\r\n", section.section_name);
         }
         else{
-            printf(" |- Section %s\r\n", section->section_name);
+            printf(" |- Section %s\r\n", section.section_name);
         }
 
         if(settings.print_symbols == true){
             printf(" %c   |- Exported:\r\n", next_section);
 
-            if(list_count(section->exported_symbol_list) == 0){
+            if(section.exported_count == 0){
                 printf(" %c   |   '- <empty>\r\n", next_section);
             }
             else{
-                for(unsigned j = 0; j < list_count(section->exported_symbol_list); j++){
-                    obj_symbol_t *symbol = NULL;
-                    list_at(section->exported_symbol_list, j, (void *)&symbol);
+                for(unsigned j = 0; j < section.exported_count; j++){
+                    obj_symbol_t symbol;
+                    obj_view_exported_symbol(obj, &section, j, &symbol);
 
-                    char *value = platformlib_write_isa_address(symbol->value);
-                    char next_symbol = ((j + 1) != list_count(section->exported_symbol_list))  ? '|' : '\'';
+                    char value[PLATFORMLIB_FORMAT_BUFFER_SIZE];
+                    platformlib_format_isa_address(symbol.value, value, sizeof(value));
+
+                    char next_symbol = ((j + 1) != section.exported_count)  ? '|' : '\'';
 
                     if(settings.print_symbol_vals == true){
-                        printf(" %c   |   %c- %s %s\r\n", next_section, next_symbol, symbol->name, value);
+                        printf(" %c   |   %c- %s %s\r\n", next_section, next_symbol, symbol.name, value);
                     }
                     else{
-                        printf(" %c   |   %c- %s\r\n", next_section, next_symbol, symbol->name);
+                        printf(" %c   |   %c- %s\r\n", next_section, next_symbol, symbol.name);
                     }
-
-                    dynmem_free(value);
                 }
             }
 
@@ -198,26 +198,25 @@ static void print_obj(void){
                 printf(" %c   '- Imported:\r\n", next_section);
             }
 
-            if(list_count(section->imported_symbol_list) == 0){
+            if(section.imported_count == 0){
                 printf(" %c   %c   '- <empty>\r\n", next_section, dataprint_symbol);
             }
             else{
-                for(unsigned j = 0; j < list_count(section->imported_symbol_list); j++){
-                    obj_symbol_t *symbol = NULL;
-                    list_at(section->imported_symbol_list, j, (void *)&symbol);
+                for(unsigned j = 0; j < section.imported_count; j++){
+                    obj_symbol_t symbol;
+                    obj_view_imported_symbol(obj, &section, j, &symbol);
 
-                    char *value = platformlib_write_isa_address(symbol->value);
-                    char next_symbol = ((j + 1) != list_count(section->imported_symbol_list))  ? '|' : '\'';
+                    char value[PLATFORMLIB_FORMAT_BUFFER_SIZE];
+                    platformlib_format_isa_address(symbol.value, value, sizeof(value));
+
+                    char next_symbol = ((j + 1) != section.imported_count)  ? '|' : '\'';
 
                     if(settings.print_symbol_vals == true){
-                        printf(" %c   %c   %c- %s %s\r\n", next_section, dataprint_symbol, next_symbol, symbol->name, value);
+                        printf(" %c   %c   %c- %s %s\r\n", next_section, dataprint_symbol, next_symbol, symbol.name, value);
                     }
                     else{
-                        printf(" %c   %c   %c- %s\r\n", next_section, dataprint_symbol, next_symbol, symbol->name);
+                        printf(" %c   %c   %c- %s\r\n", next_section, dataprint_symbol, next_symbol, symbol.name);
                     }
-
-
-                    dynmem_free(value);
                 }
             }
         }
@@ -225,38 +224,37 @@ static void print_obj(void){
         if(settings.print_data == true){
             printf(" %c   '- Data:\r\n", next_section);
 
-            if(list_count(section->data_symbol_list) == 0){
+            if(section.data_count == 0){
                 printf(" %c       '- <empty>\r\n", next_section);
             }
             else{
-                for(unsigned j = 0; j < list_count(section->data_symbol_list); j++){
-                    obj_data_t *symbol = NULL;
-                    list_at(section->data_symbol_list, j, (void *)&symbol);
+                for(unsigned j = 0; j < section.data_count; j++){
+                    obj_data_t symbol;
+                    obj_view_data(&section, j, &symbol);
+
+                    char address[PLATFORMLIB_FORMAT_BUFFER_SIZE];
+                    char value[PLATFORMLIB_FORMAT_BUFFER_SIZE];
+                    char next_data = ((j + 1) != section.data_count)  ? '|' : '\'';
 
-                    char *address = platformlib_write_isa_address(symbol->address);
-                    char *value = NULL;
-                    char next_data = ((j + 1) != list_count(section->data_symbol_list))  ? '|' : '\'';
+                    platformlib_format_isa_address(symbol.address, address, sizeof(address));
 
-                    if(symbol->blob == true){
-                        value = platformlib_write_isa_memory_element(symbol->payload.blob_value);
+                    if(symbol.blob == true){
+                        platformlib_format_isa_memory_element(symbol.payload.blob_value, value, sizeof(value));
                         printf(" %c       %c- blob %s %s\r\n", next_section, next_data, address, value);
                     }
                     else{
-                        value = platformlib_write_isa_instruction_word(symbol->payload.data_value);
-                        char *relocation = symbol->relocation ? "1" : "0";
-                        char *special = symbol->special ? "1" : "0";
+                        platformlib_format_isa_instruction_word(symbol.payload.data_value, value, sizeof(value));
+                        char *relocation = symbol.relocation ? "1" : "0";
+                        char *special = symbol.special ? "1" : "0";
                         printf(" %c       %c- inst %s %s relocation:%s special:%s\r\n", next_section, next_data, address, value, relocation, special);
                     }
-
-                    dynmem_free(address);
-                    dynmem_free(value);
                 }
             }
         }
 
     }
 
-    obj_file_destroy(obj);
+    obj_view_close(obj);
 }
 
 static void failure(char *errmsg){